@@ -0,0 +1,37 @@
+#include "allocation_counter.h"
+
+#ifdef HEATNINJA_COUNT_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+
+namespace {
+    thread_local size_t heap_allocations = 0;
+}
+
+// replaces the global allocation functions for the whole program, array and nothrow forms forward to these
+void* operator new(std::size_t size) {
+    ++heap_allocations;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace heatninja {
+    size_t thread_heap_allocations() {
+        return heap_allocations;
+    }
+}
+#else
+namespace heatninja {
+    size_t thread_heap_allocations() {
+        return 0;
+    }
+}
+#endif
@@ -0,0 +1,8 @@
+#pragma once
+#include <cstddef>
+
+namespace heatninja {
+    // operator new calls made by the calling thread so far
+    // only counts when built with HEATNINJA_COUNT_ALLOCATIONS, otherwise always 0
+    size_t thread_heap_allocations();
+}
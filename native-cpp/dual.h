@@ -0,0 +1,76 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace heatninja {
+    // forward mode dual number: a value & its derivatives with respect to N inputs, carried through the kernels templated on Scalar
+    // comparisons only look at the value, so branches follow the float run & the derivatives are those of the branch taken
+    template <size_t N>
+    struct Dual {
+        float value = 0;
+        std::array<float, N> derivatives = {};
+
+        Dual() = default;
+        Dual(const float value) : value(value) {}
+
+        // the input_index-th input, with unit derivative
+        static Dual variable(const float value, const size_t input_index) {
+            Dual variable(value);
+            variable.derivatives.at(input_index) = 1;
+            return variable;
+        }
+
+        Dual& operator+=(const Dual& b) {
+            value += b.value;
+            for (size_t i = 0; i < N; ++i) derivatives[i] += b.derivatives[i];
+            return *this;
+        }
+
+        Dual& operator-=(const Dual& b) {
+            value -= b.value;
+            for (size_t i = 0; i < N; ++i) derivatives[i] -= b.derivatives[i];
+            return *this;
+        }
+
+        Dual& operator*=(const Dual& b) {
+            for (size_t i = 0; i < N; ++i) derivatives[i] = derivatives[i] * b.value + value * b.derivatives[i];
+            value *= b.value;
+            return *this;
+        }
+
+        Dual& operator/=(const Dual& b) {
+            value /= b.value;
+            for (size_t i = 0; i < N; ++i) derivatives[i] = (derivatives[i] - value * b.derivatives[i]) / b.value;
+            return *this;
+        }
+
+        friend Dual operator+(Dual a, const Dual& b) { return a += b; }
+        friend Dual operator-(Dual a, const Dual& b) { return a -= b; }
+        friend Dual operator*(Dual a, const Dual& b) { return a *= b; }
+        friend Dual operator/(Dual a, const Dual& b) { return a /= b; }
+        friend Dual operator-(const Dual& a) { return Dual() - a; }
+
+        friend bool operator<(const Dual& a, const Dual& b) { return a.value < b.value; }
+        friend bool operator>(const Dual& a, const Dual& b) { return a.value > b.value; }
+        friend bool operator<=(const Dual& a, const Dual& b) { return a.value <= b.value; }
+        friend bool operator>=(const Dual& a, const Dual& b) { return a.value >= b.value; }
+        friend bool operator==(const Dual& a, const Dual& b) { return a.value == b.value; }
+
+        friend Dual pow(const Dual& a, const float exponent) {
+            Dual power(std::pow(a.value, exponent));
+            const float slope = exponent * std::pow(a.value, exponent - 1);
+            for (size_t i = 0; i < N; ++i) power.derivatives[i] = slope * a.derivatives[i];
+            return power;
+        }
+    };
+
+    inline float value_of(const float value) {
+        return value;
+    }
+
+    template <size_t N>
+    float value_of(const Dual<N>& dual) {
+        return dual.value;
+    }
+}
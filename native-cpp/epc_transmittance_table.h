@@ -0,0 +1,333 @@
+#pragma once
+// GENERATED by tools/generate_epc_table.cpp, do not edit
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace heatninja {
+    constexpr size_t epc_table_regions = 21;
+    constexpr float epc_table_house_size_min = 20, epc_table_house_size_step = 20;
+    constexpr size_t epc_table_house_sizes = 15;
+    constexpr int epc_table_epc_space_heating_min = 0;
+    constexpr float epc_table_epc_space_heating_step = 1000;
+    constexpr size_t epc_table_epc_space_heating_values = 31;
+
+    // epc_thermal_transmittance_steps index + 1 fitted at latitude 53, [region][house size][epc space heating]
+    constexpr std::array<uint8_t, 9765> epc_thermal_transmittance_table = { {
+        0, 70, 140, 212, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 26, 62, 96, 131, 167, 204, 241, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 12, 37, 61, 83, 107, 130, 154, 178, 202, 227, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 4, 24, 42, 59, 77, 94, 111, 129, 147, 165, 183, 201, 220, 238, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 15, 29, 44, 58, 71, 85, 99, 113, 127, 141, 156, 170, 185, 199, 214, 229, 244, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 8, 20, 33, 44, 56, 67, 79, 90, 102, 114, 125, 137, 149, 161, 173, 185, 198, 210, 222, 235, 247, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 3, 14, 24, 35, 44, 54, 64, 74, 84, 94, 104, 114, 124, 134, 144, 154, 165, 175, 185, 196, 206, 217, 228, 238, 249, 251, 251, 251, 251,
+        0, 0, 1, 9, 18, 27, 36, 44, 53, 61, 70, 79, 87, 96, 105, 114, 122, 131, 140, 149, 158, 167, 176, 185, 195, 204, 213, 222, 232, 241, 250,
+        0, 0, 1, 5, 13, 21, 29, 37, 44, 52, 60, 67, 75, 83, 90, 98, 106, 114, 121, 129, 137, 145, 153, 161, 169, 177, 185, 194, 202, 210, 218,
+        0, 0, 1, 1, 9, 16, 23, 31, 38, 44, 51, 58, 65, 72, 79, 86, 93, 100, 107, 114, 121, 128, 135, 142, 149, 156, 164, 171, 178, 185, 193,
+        0, 0, 1, 1, 6, 12, 19, 25, 32, 38, 44, 50, 57, 63, 69, 75, 82, 88, 94, 101, 107, 114, 120, 126, 133, 139, 146, 152, 159, 166, 172,
+        0, 0, 1, 1, 3, 9, 15, 21, 27, 33, 39, 44, 50, 56, 61, 67, 73, 79, 84, 90, 96, 102, 108, 114, 119, 125, 131, 137, 143, 149, 155,
+        0, 0, 0, 1, 1, 6, 12, 17, 23, 29, 34, 39, 44, 49, 55, 60, 65, 71, 76, 81, 87, 92, 97, 103, 108, 114, 119, 124, 130, 135, 141,
+        0, 0, 0, 1, 1, 4, 9, 14, 19, 25, 30, 35, 39, 44, 49, 54, 59, 64, 69, 74, 79, 83, 88, 93, 98, 103, 108, 114, 119, 124, 129,
+        0, 0, 0, 1, 1, 2, 7, 11, 16, 21, 26, 31, 35, 40, 44, 49, 53, 58, 62, 67, 72, 76, 81, 85, 90, 95, 99, 104, 109, 114, 118,
+        0, 70, 139, 211, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 27, 62, 96, 131, 166, 202, 239, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 13, 38, 61, 84, 106, 130, 153, 177, 201, 225, 250, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 5, 24, 43, 60, 77, 94, 111, 129, 146, 164, 182, 200, 218, 237, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 16, 30, 44, 58, 71, 85, 99, 113, 127, 141, 155, 169, 184, 198, 213, 227, 242, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 9, 21, 33, 45, 56, 67, 79, 90, 102, 113, 125, 137, 148, 160, 172, 184, 196, 208, 221, 233, 245, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 3, 15, 25, 35, 45, 55, 64, 74, 84, 94, 103, 113, 123, 133, 143, 154, 164, 174, 184, 195, 205, 215, 226, 236, 247, 251, 251, 251, 251,
+        0, 0, 1, 9, 19, 28, 37, 45, 53, 62, 70, 79, 87, 96, 105, 113, 122, 131, 140, 148, 157, 166, 175, 184, 193, 202, 212, 221, 230, 239, 248,
+        0, 0, 1, 6, 14, 22, 30, 37, 45, 52, 60, 67, 75, 83, 90, 98, 106, 113, 121, 129, 137, 144, 152, 160, 168, 176, 184, 192, 200, 208, 217,
+        0, 0, 1, 2, 10, 17, 24, 31, 38, 45, 52, 58, 65, 72, 79, 86, 92, 99, 106, 113, 120, 127, 134, 141, 148, 156, 163, 170, 177, 184, 191,
+        0, 0, 1, 1, 6, 13, 20, 26, 33, 39, 45, 51, 57, 63, 69, 76, 82, 88, 94, 101, 107, 113, 120, 126, 132, 139, 145, 152, 158, 165, 171,
+        0, 0, 1, 1, 4, 10, 16, 22, 28, 34, 39, 45, 50, 56, 62, 67, 73, 79, 84, 90, 96, 102, 107, 113, 119, 125, 131, 137, 142, 148, 154,
+        0, 0, 1, 1, 1, 7, 13, 18, 24, 29, 34, 40, 45, 50, 55, 60, 66, 71, 76, 81, 87, 92, 97, 103, 108, 113, 119, 124, 129, 135, 140,
+        0, 0, 0, 1, 1, 5, 10, 15, 20, 25, 30, 35, 40, 45, 50, 54, 59, 64, 69, 74, 79, 84, 88, 93, 98, 103, 108, 113, 118, 123, 128,
+        0, 0, 0, 1, 1, 3, 7, 12, 17, 22, 27, 31, 36, 40, 45, 49, 54, 58, 63, 67, 72, 76, 81, 85, 90, 95, 99, 104, 109, 113, 118,
+        0, 74, 144, 217, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 29, 65, 100, 135, 171, 208, 246, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 16, 41, 64, 87, 110, 134, 158, 182, 207, 232, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 7, 27, 46, 63, 80, 98, 115, 133, 151, 169, 187, 206, 224, 243, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 18, 33, 47, 61, 75, 89, 103, 117, 131, 145, 160, 174, 189, 204, 219, 234, 249, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 11, 24, 36, 48, 59, 71, 82, 94, 106, 117, 129, 141, 153, 165, 177, 190, 202, 214, 227, 239, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 6, 17, 27, 38, 48, 58, 67, 77, 87, 97, 107, 117, 128, 138, 148, 158, 169, 179, 190, 200, 211, 222, 232, 243, 251, 251, 251, 251, 251,
+        0, 1, 1, 12, 21, 30, 39, 48, 56, 65, 74, 82, 91, 100, 109, 117, 126, 135, 144, 153, 162, 171, 181, 190, 199, 208, 218, 227, 236, 246, 251,
+        0, 0, 1, 8, 16, 24, 32, 40, 48, 55, 63, 71, 78, 86, 94, 102, 110, 117, 125, 133, 141, 149, 157, 165, 173, 182, 190, 198, 206, 215, 223,
+        0, 0, 1, 4, 12, 19, 27, 34, 41, 48, 54, 61, 68, 75, 82, 89, 96, 103, 110, 117, 124, 132, 139, 146, 153, 160, 168, 175, 182, 190, 197,
+        0, 0, 1, 1, 9, 15, 22, 29, 35, 41, 48, 54, 60, 66, 73, 79, 85, 92, 98, 104, 111, 117, 124, 130, 137, 143, 150, 157, 163, 170, 176,
+        0, 0, 1, 1, 6, 12, 18, 24, 30, 36, 42, 48, 53, 59, 65, 71, 76, 82, 88, 94, 100, 106, 111, 117, 123, 129, 135, 141, 147, 153, 159,
+        0, 0, 1, 1, 4, 9, 15, 21, 26, 32, 37, 42, 48, 53, 58, 63, 69, 74, 79, 85, 90, 96, 101, 106, 112, 117, 123, 128, 134, 139, 145,
+        0, 0, 1, 1, 1, 7, 12, 17, 23, 28, 33, 38, 43, 48, 52, 57, 62, 67, 72, 77, 82, 87, 92, 97, 102, 107, 112, 117, 122, 128, 133,
+        0, 0, 0, 1, 1, 5, 10, 15, 20, 24, 29, 34, 38, 43, 48, 52, 57, 61, 66, 70, 75, 80, 84, 89, 94, 98, 103, 108, 113, 117, 122,
+        0, 77, 149, 224, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 32, 68, 103, 140, 177, 214, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 18, 43, 67, 90, 114, 139, 163, 188, 213, 239, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 10, 30, 48, 66, 83, 101, 119, 137, 156, 174, 193, 212, 231, 250, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 3, 21, 36, 50, 64, 78, 92, 106, 121, 136, 150, 165, 180, 195, 210, 225, 241, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 14, 26, 38, 50, 62, 74, 85, 97, 109, 121, 134, 146, 158, 171, 183, 196, 208, 221, 234, 247, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 8, 19, 30, 40, 50, 60, 70, 80, 91, 101, 111, 122, 132, 142, 153, 164, 174, 185, 196, 206, 217, 228, 239, 250, 251, 251, 251, 251, 251,
+        0, 1, 4, 14, 24, 33, 41, 50, 59, 68, 77, 85, 94, 103, 112, 122, 131, 140, 149, 158, 168, 177, 186, 196, 205, 215, 224, 234, 243, 251, 251,
+        0, 0, 1, 10, 18, 27, 35, 42, 50, 58, 66, 74, 81, 89, 97, 105, 113, 121, 130, 138, 146, 154, 162, 171, 179, 187, 196, 204, 213, 221, 230,
+        0, 0, 1, 7, 14, 22, 29, 36, 43, 50, 57, 64, 71, 78, 85, 93, 100, 107, 114, 121, 129, 136, 143, 151, 158, 166, 173, 181, 188, 196, 203,
+        0, 0, 1, 4, 11, 18, 25, 31, 37, 44, 50, 56, 63, 69, 76, 82, 89, 95, 102, 108, 115, 121, 128, 135, 141, 148, 155, 162, 168, 175, 182,
+        0, 0, 1, 1, 8, 14, 21, 27, 33, 38, 44, 50, 56, 62, 68, 73, 79, 85, 91, 97, 103, 109, 115, 121, 128, 134, 140, 146, 152, 158, 164,
+        0, 0, 1, 1, 6, 11, 17, 23, 29, 34, 39, 45, 50, 55, 61, 66, 72, 77, 83, 88, 94, 99, 105, 110, 116, 121, 127, 133, 138, 144, 150,
+        0, 0, 1, 1, 4, 9, 14, 20, 25, 30, 35, 40, 45, 50, 55, 60, 65, 70, 75, 80, 85, 90, 96, 101, 106, 111, 116, 121, 127, 132, 137,
+        0, 0, 1, 1, 2, 7, 12, 17, 22, 27, 31, 36, 41, 45, 50, 55, 59, 64, 69, 73, 78, 83, 88, 92, 97, 102, 107, 112, 117, 121, 126,
+        0, 67, 135, 204, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 25, 59, 92, 126, 161, 196, 232, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 12, 36, 58, 80, 102, 125, 148, 171, 195, 219, 243, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 4, 23, 40, 57, 73, 90, 107, 124, 141, 159, 176, 194, 211, 229, 248, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 14, 28, 42, 55, 68, 82, 95, 109, 122, 136, 150, 164, 178, 192, 206, 220, 235, 249, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 8, 20, 31, 42, 53, 64, 75, 87, 98, 109, 120, 132, 143, 155, 167, 178, 190, 202, 214, 226, 238, 250, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 2, 13, 23, 33, 42, 52, 61, 71, 80, 90, 100, 109, 119, 129, 139, 148, 158, 168, 178, 189, 199, 209, 219, 229, 240, 250, 251, 251, 251,
+        0, 0, 1, 8, 17, 26, 34, 42, 51, 59, 67, 75, 84, 92, 101, 109, 118, 126, 135, 143, 152, 161, 170, 178, 187, 196, 205, 214, 223, 232, 241,
+        0, 0, 1, 4, 12, 20, 28, 35, 42, 50, 57, 64, 72, 79, 87, 94, 102, 109, 117, 124, 132, 140, 147, 155, 163, 171, 178, 186, 194, 202, 210,
+        0, 0, 1, 1, 8, 15, 22, 29, 36, 42, 49, 55, 62, 69, 75, 82, 89, 96, 102, 109, 116, 123, 130, 137, 143, 150, 157, 164, 171, 178, 185,
+        0, 0, 1, 1, 5, 12, 18, 24, 30, 36, 42, 48, 54, 60, 66, 72, 78, 85, 91, 97, 103, 109, 115, 122, 128, 134, 140, 147, 153, 159, 166,
+        0, 0, 1, 1, 3, 8, 14, 20, 26, 31, 37, 42, 48, 53, 59, 64, 70, 75, 81, 87, 92, 98, 103, 109, 115, 120, 126, 132, 138, 143, 149,
+        0, 0, 0, 1, 1, 6, 11, 17, 22, 27, 32, 37, 42, 47, 52, 57, 63, 68, 73, 78, 83, 88, 93, 99, 104, 109, 114, 120, 125, 130, 135,
+        0, 0, 0, 1, 1, 3, 8, 13, 19, 24, 28, 33, 38, 42, 47, 52, 56, 61, 66, 71, 75, 80, 85, 90, 95, 99, 104, 109, 114, 119, 124,
+        0, 0, 0, 1, 1, 1, 6, 11, 16, 20, 25, 29, 33, 38, 42, 47, 51, 55, 60, 64, 69, 73, 78, 82, 86, 91, 95, 100, 105, 109, 114,
+        0, 60, 125, 191, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 20, 53, 84, 117, 150, 183, 217, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 8, 30, 51, 73, 94, 116, 138, 160, 182, 205, 228, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 18, 35, 50, 66, 82, 98, 115, 131, 148, 164, 181, 198, 215, 232, 250, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 10, 23, 36, 49, 61, 74, 87, 100, 113, 126, 139, 153, 166, 179, 193, 207, 220, 234, 248, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 4, 15, 26, 37, 47, 58, 68, 79, 90, 100, 111, 122, 133, 144, 155, 166, 178, 189, 200, 212, 223, 235, 246, 251, 251, 251, 251, 251, 251,
+        0, 0, 1, 9, 18, 28, 37, 46, 55, 64, 73, 82, 91, 100, 110, 119, 128, 138, 147, 157, 167, 176, 186, 196, 205, 215, 225, 235, 245, 251, 251,
+        0, 0, 1, 4, 12, 21, 29, 37, 44, 52, 60, 68, 76, 84, 92, 100, 109, 117, 125, 133, 141, 150, 158, 167, 175, 183, 192, 200, 209, 218, 226,
+        0, 0, 1, 1, 8, 15, 23, 30, 37, 43, 51, 58, 65, 72, 79, 86, 93, 100, 108, 115, 122, 130, 137, 144, 152, 159, 167, 174, 182, 189, 197,
+        0, 0, 1, 1, 4, 11, 18, 24, 30, 36, 43, 49, 55, 62, 68, 75, 81, 87, 94, 100, 107, 113, 120, 127, 133, 140, 146, 153, 160, 167, 173,
+        0, 0, 1, 1, 1, 7, 13, 19, 25, 31, 36, 42, 48, 54, 59, 65, 71, 77, 83, 89, 94, 100, 106, 112, 118, 124, 130, 136, 142, 148, 154,
+        0, 0, 0, 1, 1, 4, 10, 15, 21, 26, 31, 36, 42, 47, 52, 57, 63, 68, 73, 79, 84, 90, 95, 100, 106, 111, 117, 122, 128, 133, 139,
+        0, 0, 0, 1, 1, 2, 7, 12, 17, 22, 27, 32, 36, 41, 46, 51, 56, 61, 66, 71, 75, 80, 85, 90, 95, 100, 105, 110, 115, 120, 126,
+        0, 0, 0, 1, 1, 1, 4, 9, 14, 19, 23, 27, 32, 36, 41, 45, 50, 54, 59, 63, 68, 73, 77, 82, 86, 91, 96, 100, 105, 110, 114,
+        0, 0, 0, 1, 1, 1, 2, 7, 11, 16, 20, 24, 28, 32, 36, 41, 45, 49, 53, 57, 62, 66, 70, 74, 79, 83, 87, 92, 96, 100, 105,
+        0, 62, 128, 196, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 20, 54, 86, 119, 153, 188, 222, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 8, 31, 53, 74, 96, 118, 141, 163, 186, 210, 233, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 18, 35, 51, 68, 84, 101, 117, 134, 151, 168, 185, 203, 220, 238, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 10, 24, 37, 50, 63, 76, 89, 102, 116, 129, 142, 156, 170, 184, 197, 211, 226, 240, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 4, 15, 27, 37, 48, 59, 70, 81, 92, 103, 114, 125, 136, 147, 159, 170, 182, 193, 205, 217, 228, 240, 251, 251, 251, 251, 251, 251, 251,
+        0, 0, 1, 9, 19, 28, 37, 47, 56, 65, 74, 84, 93, 103, 112, 122, 131, 141, 151, 161, 170, 180, 190, 200, 210, 220, 230, 240, 251, 251, 251,
+        0, 0, 1, 4, 13, 21, 29, 37, 45, 53, 62, 70, 78, 86, 94, 103, 111, 119, 128, 136, 145, 153, 162, 170, 179, 188, 196, 205, 214, 223, 232,
+        0, 0, 1, 1, 8, 16, 23, 30, 37, 44, 52, 59, 66, 73, 81, 88, 95, 103, 110, 118, 125, 132, 140, 148, 155, 163, 170, 178, 186, 193, 201,
+        0, 0, 1, 1, 4, 11, 18, 24, 31, 37, 44, 50, 57, 63, 70, 76, 83, 89, 96, 103, 109, 116, 123, 129, 136, 143, 150, 157, 163, 170, 177,
+        0, 0, 1, 1, 1, 7, 14, 20, 26, 31, 37, 43, 49, 55, 61, 67, 73, 79, 85, 91, 97, 103, 109, 115, 121, 127, 133, 139, 145, 152, 158,
+        0, 0, 0, 1, 1, 4, 10, 16, 21, 27, 32, 37, 43, 48, 53, 59, 64, 70, 75, 81, 86, 92, 97, 103, 108, 114, 119, 125, 131, 136, 142,
+        0, 0, 0, 1, 1, 2, 7, 12, 17, 22, 27, 32, 37, 42, 47, 52, 57, 62, 67, 72, 77, 82, 87, 92, 97, 103, 108, 113, 118, 123, 128,
+        0, 0, 0, 1, 1, 1, 4, 9, 14, 19, 23, 28, 33, 37, 42, 46, 51, 56, 60, 65, 70, 74, 79, 84, 88, 93, 98, 103, 107, 112, 117,
+        0, 0, 0, 1, 1, 1, 2, 7, 11, 16, 20, 24, 29, 33, 37, 41, 46, 50, 54, 59, 63, 67, 72, 76, 80, 85, 89, 94, 98, 103, 107,
+        0, 53, 114, 176, 241, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 15, 46, 76, 106, 137, 169, 201, 233, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 4, 25, 45, 65, 85, 105, 126, 147, 168, 189, 211, 232, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 13, 29, 44, 59, 74, 89, 104, 120, 135, 151, 167, 183, 199, 215, 231, 248, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 6, 18, 30, 42, 54, 66, 78, 90, 103, 115, 127, 140, 153, 165, 178, 191, 204, 217, 230, 243, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 0, 1, 10, 21, 31, 41, 51, 61, 71, 81, 91, 101, 111, 122, 132, 142, 153, 163, 174, 185, 195, 206, 217, 228, 239, 250, 251, 251, 251, 251,
+        0, 0, 1, 5, 14, 22, 31, 39, 48, 56, 65, 74, 82, 91, 100, 108, 117, 126, 135, 144, 153, 162, 171, 180, 189, 199, 208, 217, 226, 236, 245,
+        0, 0, 1, 1, 8, 16, 23, 31, 38, 46, 53, 61, 68, 76, 83, 91, 99, 106, 114, 122, 129, 137, 145, 153, 161, 169, 177, 185, 193, 201, 209,
+        0, 0, 1, 1, 4, 11, 18, 24, 31, 37, 44, 51, 57, 64, 71, 77, 84, 91, 98, 104, 111, 118, 125, 132, 139, 146, 153, 160, 167, 174, 181,
+        0, 0, 0, 1, 1, 7, 13, 19, 25, 31, 37, 43, 48, 54, 60, 67, 73, 79, 85, 91, 97, 103, 109, 115, 122, 128, 134, 140, 147, 153, 159,
+        0, 0, 0, 1, 1, 3, 9, 15, 20, 25, 31, 36, 41, 47, 52, 58, 63, 69, 74, 80, 85, 91, 96, 102, 108, 113, 119, 124, 130, 136, 142,
+        0, 0, 0, 1, 1, 1, 6, 11, 16, 21, 26, 31, 36, 40, 45, 50, 55, 60, 65, 70, 76, 81, 86, 91, 96, 101, 106, 111, 116, 122, 127,
+        0, 0, 0, 1, 1, 1, 3, 8, 12, 17, 21, 26, 31, 35, 40, 44, 49, 53, 58, 63, 67, 72, 77, 81, 86, 91, 95, 100, 105, 110, 114,
+        0, 0, 0, 0, 1, 1, 1, 5, 9, 14, 18, 22, 26, 31, 35, 39, 43, 48, 52, 56, 60, 65, 69, 73, 78, 82, 86, 91, 95, 100, 104,
+        0, 0, 0, 0, 1, 1, 1, 2, 7, 11, 15, 19, 23, 27, 31, 34, 38, 42, 46, 50, 54, 58, 62, 66, 70, 74, 79, 83, 87, 91, 95,
+        0, 53, 114, 176, 241, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 15, 45, 75, 106, 137, 169, 201, 233, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 3, 25, 44, 64, 85, 105, 126, 147, 168, 189, 211, 232, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 13, 28, 43, 58, 73, 89, 104, 119, 135, 151, 167, 183, 199, 215, 231, 248, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 5, 18, 30, 42, 54, 66, 78, 90, 102, 115, 127, 140, 152, 165, 178, 191, 204, 217, 230, 243, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 0, 1, 10, 20, 30, 40, 50, 60, 70, 80, 91, 101, 111, 121, 132, 142, 153, 163, 174, 185, 195, 206, 217, 228, 239, 250, 251, 251, 251, 251,
+        0, 0, 1, 4, 13, 22, 30, 39, 47, 56, 64, 73, 82, 91, 99, 108, 117, 126, 135, 144, 153, 162, 171, 180, 189, 199, 208, 217, 227, 236, 245,
+        0, 0, 1, 1, 7, 15, 23, 30, 38, 45, 53, 60, 68, 75, 83, 91, 98, 106, 114, 121, 129, 137, 145, 153, 161, 169, 177, 185, 193, 201, 209,
+        0, 0, 1, 1, 3, 10, 17, 24, 30, 37, 43, 50, 57, 63, 70, 77, 84, 91, 97, 104, 111, 118, 125, 132, 139, 146, 153, 160, 167, 174, 181,
+        0, 0, 0, 1, 1, 6, 12, 18, 24, 30, 36, 42, 48, 54, 60, 66, 72, 78, 84, 91, 97, 103, 109, 115, 121, 128, 134, 140, 147, 153, 159,
+        0, 0, 0, 1, 1, 2, 8, 14, 19, 25, 30, 35, 41, 46, 52, 57, 63, 68, 74, 79, 85, 90, 96, 102, 107, 113, 119, 124, 130, 136, 141,
+        0, 0, 0, 1, 1, 1, 5, 10, 15, 20, 25, 30, 35, 40, 45, 50, 55, 60, 65, 70, 75, 80, 85, 90, 96, 101, 106, 111, 116, 121, 127,
+        0, 0, 0, 1, 1, 1, 2, 7, 12, 16, 21, 25, 30, 35, 39, 44, 48, 53, 58, 62, 67, 72, 76, 81, 86, 90, 95, 100, 105, 109, 114,
+        0, 0, 0, 0, 1, 1, 1, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 56, 60, 64, 69, 73, 77, 82, 86, 90, 95, 99, 104,
+        0, 0, 0, 0, 1, 1, 1, 2, 6, 10, 14, 18, 22, 26, 30, 34, 38, 42, 46, 50, 54, 58, 62, 66, 70, 74, 78, 82, 86, 90, 95,
+        0, 55, 117, 181, 247, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 17, 48, 79, 110, 141, 174, 206, 239, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 5, 27, 47, 67, 88, 109, 130, 151, 173, 194, 216, 238, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 15, 31, 46, 61, 76, 92, 108, 123, 139, 155, 171, 188, 204, 221, 237, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 7, 20, 32, 44, 56, 69, 81, 93, 106, 119, 131, 144, 157, 170, 183, 196, 209, 222, 236, 249, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 0, 1, 12, 23, 33, 43, 53, 63, 73, 84, 94, 104, 115, 125, 136, 147, 157, 168, 179, 190, 201, 212, 223, 234, 245, 251, 251, 251, 251, 251,
+        0, 0, 1, 6, 15, 24, 33, 41, 50, 59, 67, 76, 85, 94, 103, 112, 121, 130, 139, 148, 157, 167, 176, 185, 195, 204, 213, 223, 233, 242, 251,
+        0, 0, 1, 1, 9, 18, 25, 33, 40, 48, 55, 63, 71, 78, 86, 94, 102, 110, 118, 125, 133, 141, 149, 157, 166, 174, 182, 190, 198, 206, 215,
+        0, 0, 1, 1, 5, 12, 19, 26, 32, 39, 46, 53, 60, 66, 73, 80, 87, 94, 101, 108, 115, 122, 129, 136, 143, 150, 157, 165, 172, 179, 186,
+        0, 0, 1, 1, 1, 8, 14, 20, 26, 32, 38, 45, 51, 57, 63, 69, 75, 81, 88, 94, 100, 106, 113, 119, 125, 132, 138, 145, 151, 157, 164,
+        0, 0, 0, 1, 1, 4, 10, 16, 21, 27, 32, 38, 43, 49, 55, 60, 66, 71, 77, 83, 88, 94, 100, 105, 111, 117, 122, 128, 134, 140, 146,
+        0, 0, 0, 1, 1, 2, 7, 12, 17, 22, 27, 32, 37, 42, 48, 53, 58, 63, 68, 73, 78, 83, 89, 94, 99, 104, 110, 115, 120, 125, 131,
+        0, 0, 0, 1, 1, 1, 4, 9, 14, 18, 23, 28, 32, 37, 42, 46, 51, 56, 60, 65, 70, 75, 79, 84, 89, 94, 99, 103, 108, 113, 118,
+        0, 0, 0, 1, 1, 1, 2, 6, 11, 15, 19, 24, 28, 32, 37, 41, 45, 50, 54, 58, 63, 67, 72, 76, 80, 85, 89, 94, 98, 103, 107,
+        0, 0, 0, 0, 1, 1, 1, 4, 8, 12, 16, 20, 24, 28, 32, 36, 40, 44, 49, 53, 57, 61, 65, 69, 73, 77, 81, 85, 90, 94, 98,
+        0, 60, 124, 191, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 19, 52, 84, 116, 149, 182, 216, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 7, 30, 51, 72, 93, 115, 137, 159, 181, 204, 227, 250, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 17, 34, 50, 65, 81, 98, 114, 130, 147, 163, 180, 197, 214, 231, 249, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 9, 23, 35, 48, 61, 73, 86, 99, 112, 125, 138, 152, 165, 179, 192, 206, 219, 233, 247, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 3, 14, 25, 36, 46, 57, 67, 78, 89, 100, 110, 121, 132, 143, 154, 166, 177, 188, 199, 211, 222, 234, 245, 251, 251, 251, 251, 251, 251,
+        0, 0, 1, 8, 18, 27, 36, 45, 54, 63, 72, 81, 90, 100, 109, 118, 128, 137, 147, 156, 166, 175, 185, 195, 204, 214, 224, 234, 244, 251, 251,
+        0, 0, 1, 3, 12, 20, 28, 36, 44, 52, 59, 67, 75, 83, 92, 100, 108, 116, 124, 132, 141, 149, 157, 166, 174, 183, 191, 200, 208, 217, 225,
+        0, 0, 1, 1, 7, 15, 22, 29, 36, 43, 50, 57, 64, 71, 78, 85, 92, 100, 107, 114, 121, 129, 136, 143, 151, 158, 166, 173, 181, 188, 196,
+        0, 0, 1, 1, 3, 10, 17, 23, 30, 36, 42, 48, 55, 61, 67, 74, 80, 87, 93, 100, 106, 113, 119, 126, 132, 139, 146, 152, 159, 166, 172,
+        0, 0, 0, 1, 1, 7, 13, 19, 24, 30, 36, 41, 47, 53, 59, 64, 70, 76, 82, 88, 94, 100, 105, 111, 117, 123, 129, 135, 141, 147, 153,
+        0, 0, 0, 1, 1, 4, 9, 15, 20, 25, 30, 36, 41, 46, 51, 57, 62, 67, 73, 78, 83, 89, 94, 100, 105, 110, 116, 121, 127, 132, 138,
+        0, 0, 0, 1, 1, 1, 6, 11, 16, 21, 26, 31, 36, 41, 45, 50, 55, 60, 65, 70, 75, 80, 85, 90, 95, 100, 105, 110, 115, 120, 125,
+        0, 0, 0, 1, 1, 1, 4, 8, 13, 18, 22, 27, 31, 36, 40, 45, 49, 54, 58, 63, 67, 72, 76, 81, 86, 90, 95, 100, 104, 109, 113,
+        0, 0, 0, 1, 1, 1, 1, 6, 10, 15, 19, 23, 27, 31, 36, 40, 44, 48, 52, 57, 61, 65, 69, 74, 78, 82, 87, 91, 95, 100, 104,
+        0, 67, 135, 205, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 24, 59, 92, 126, 161, 196, 232, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 11, 35, 58, 80, 102, 125, 148, 171, 195, 219, 243, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 3, 22, 40, 57, 73, 90, 107, 124, 141, 159, 176, 194, 212, 230, 248, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 14, 28, 42, 55, 68, 82, 95, 109, 122, 136, 150, 164, 178, 192, 206, 221, 235, 250, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 7, 19, 31, 42, 53, 64, 75, 86, 98, 109, 120, 132, 143, 155, 167, 178, 190, 202, 214, 226, 238, 250, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 2, 12, 23, 33, 42, 52, 61, 71, 80, 90, 99, 109, 119, 129, 139, 148, 158, 168, 179, 189, 199, 209, 219, 230, 240, 250, 251, 251, 251,
+        0, 0, 1, 8, 16, 25, 34, 42, 50, 59, 67, 75, 84, 92, 101, 109, 118, 126, 135, 144, 152, 161, 170, 179, 187, 196, 205, 214, 223, 232, 241,
+        0, 0, 1, 4, 12, 19, 27, 35, 42, 49, 57, 64, 72, 79, 87, 94, 102, 109, 117, 124, 132, 140, 147, 155, 163, 171, 179, 186, 194, 202, 210,
+        0, 0, 1, 1, 8, 15, 22, 29, 36, 42, 49, 55, 62, 69, 75, 82, 89, 95, 102, 109, 116, 123, 130, 137, 143, 150, 157, 164, 171, 179, 186,
+        0, 0, 1, 1, 5, 11, 17, 24, 30, 36, 42, 48, 54, 60, 66, 72, 78, 84, 91, 97, 103, 109, 115, 122, 128, 134, 140, 147, 153, 159, 166,
+        0, 0, 1, 1, 2, 8, 14, 20, 25, 31, 37, 42, 48, 53, 59, 64, 70, 75, 81, 86, 92, 98, 103, 109, 115, 120, 126, 132, 138, 143, 149,
+        0, 0, 0, 1, 1, 5, 11, 16, 21, 27, 32, 37, 42, 47, 52, 57, 62, 67, 73, 78, 83, 88, 93, 99, 104, 109, 114, 120, 125, 130, 135,
+        0, 0, 0, 1, 1, 3, 8, 13, 18, 23, 28, 33, 37, 42, 47, 51, 56, 61, 66, 70, 75, 80, 85, 90, 94, 99, 104, 109, 114, 119, 124,
+        0, 0, 0, 1, 1, 1, 6, 10, 15, 20, 24, 29, 33, 38, 42, 46, 51, 55, 60, 64, 68, 73, 77, 82, 86, 91, 95, 100, 104, 109, 114,
+        0, 63, 129, 197, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 23, 55, 88, 121, 155, 189, 224, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 10, 33, 54, 76, 98, 120, 142, 165, 188, 211, 234, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 2, 21, 37, 53, 69, 86, 102, 119, 136, 152, 169, 187, 204, 221, 239, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 12, 26, 39, 52, 64, 77, 91, 104, 117, 130, 144, 157, 171, 185, 199, 213, 227, 241, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 6, 17, 29, 39, 50, 61, 71, 82, 93, 104, 115, 126, 138, 149, 160, 172, 183, 195, 206, 218, 230, 241, 251, 251, 251, 251, 251, 251, 251,
+        0, 0, 1, 11, 21, 30, 39, 48, 58, 67, 76, 85, 95, 104, 114, 123, 133, 143, 152, 162, 172, 182, 191, 201, 211, 221, 231, 242, 251, 251, 251,
+        0, 0, 1, 6, 15, 23, 31, 39, 47, 55, 63, 71, 80, 88, 96, 104, 113, 121, 129, 138, 146, 155, 163, 172, 180, 189, 198, 206, 215, 224, 233,
+        0, 0, 1, 2, 10, 18, 25, 32, 39, 46, 53, 61, 68, 75, 82, 90, 97, 104, 112, 119, 126, 134, 141, 149, 157, 164, 172, 179, 187, 195, 202,
+        0, 0, 1, 1, 6, 13, 20, 26, 33, 39, 45, 52, 58, 65, 71, 78, 84, 91, 98, 104, 111, 118, 124, 131, 138, 144, 151, 158, 165, 172, 179,
+        0, 0, 1, 1, 3, 9, 16, 22, 27, 33, 39, 45, 51, 57, 62, 68, 74, 80, 86, 92, 98, 104, 110, 116, 122, 128, 135, 141, 147, 153, 159,
+        0, 0, 0, 1, 1, 6, 12, 18, 23, 28, 34, 39, 44, 50, 55, 60, 66, 71, 77, 82, 88, 93, 99, 104, 110, 115, 121, 126, 132, 138, 143,
+        0, 0, 0, 1, 1, 4, 9, 14, 19, 24, 29, 34, 39, 44, 49, 54, 59, 64, 69, 74, 79, 84, 89, 94, 99, 104, 109, 114, 120, 125, 130,
+        0, 0, 0, 1, 1, 1, 6, 11, 16, 21, 25, 30, 34, 39, 43, 48, 53, 57, 62, 67, 71, 76, 81, 85, 90, 95, 99, 104, 109, 114, 118,
+        0, 0, 0, 1, 1, 1, 4, 9, 13, 18, 22, 26, 30, 35, 39, 43, 47, 52, 56, 60, 65, 69, 73, 78, 82, 87, 91, 95, 100, 104, 109,
+        0, 51, 111, 174, 238, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 13, 44, 73, 104, 135, 166, 198, 230, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 2, 23, 43, 62, 82, 103, 123, 144, 165, 186, 207, 229, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 11, 27, 42, 56, 71, 86, 102, 117, 133, 148, 164, 180, 196, 212, 228, 244, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 4, 16, 28, 40, 52, 64, 76, 88, 100, 112, 125, 137, 150, 162, 175, 188, 200, 213, 226, 239, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 0, 1, 8, 19, 29, 38, 48, 58, 68, 78, 88, 98, 109, 119, 129, 140, 150, 161, 171, 182, 192, 203, 214, 225, 236, 246, 251, 251, 251, 251,
+        0, 0, 1, 3, 12, 20, 29, 37, 45, 54, 63, 71, 80, 88, 97, 106, 115, 123, 132, 141, 150, 159, 168, 177, 186, 196, 205, 214, 223, 233, 242,
+        0, 0, 1, 1, 6, 14, 21, 29, 36, 43, 51, 58, 66, 73, 81, 88, 96, 104, 111, 119, 127, 135, 142, 150, 158, 166, 174, 182, 190, 198, 206,
+        0, 0, 1, 1, 2, 9, 15, 22, 28, 35, 42, 48, 55, 61, 68, 75, 82, 88, 95, 102, 109, 116, 122, 129, 136, 143, 150, 157, 164, 171, 178,
+        0, 0, 0, 1, 1, 5, 11, 17, 23, 28, 34, 40, 46, 52, 58, 64, 70, 76, 82, 88, 94, 101, 107, 113, 119, 125, 131, 138, 144, 150, 156,
+        0, 0, 0, 1, 1, 1, 7, 12, 18, 23, 28, 34, 39, 45, 50, 55, 61, 66, 72, 77, 83, 88, 94, 99, 105, 111, 116, 122, 127, 133, 139,
+        0, 0, 0, 1, 1, 1, 4, 9, 14, 19, 23, 28, 33, 38, 43, 48, 53, 58, 63, 68, 73, 78, 83, 88, 93, 98, 104, 109, 114, 119, 124,
+        0, 0, 0, 0, 1, 1, 1, 6, 10, 15, 19, 24, 28, 33, 37, 42, 47, 51, 56, 60, 65, 70, 74, 79, 84, 88, 93, 98, 102, 107, 112,
+        0, 0, 0, 0, 1, 1, 1, 3, 7, 12, 16, 20, 24, 28, 33, 37, 41, 45, 50, 54, 58, 62, 67, 71, 75, 80, 84, 88, 93, 97, 101,
+        0, 0, 0, 0, 1, 1, 1, 1, 5, 9, 13, 17, 21, 24, 28, 32, 36, 40, 44, 48, 52, 56, 60, 64, 68, 72, 76, 80, 84, 88, 92,
+        0, 49, 108, 168, 231, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 12, 42, 71, 100, 130, 161, 192, 223, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 22, 41, 60, 80, 99, 119, 140, 160, 181, 201, 222, 244, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 10, 25, 40, 54, 69, 84, 98, 113, 128, 144, 159, 174, 190, 206, 221, 237, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 3, 15, 27, 38, 50, 61, 73, 85, 97, 109, 121, 133, 145, 157, 170, 182, 195, 207, 220, 233, 245, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 0, 1, 7, 18, 27, 37, 46, 56, 66, 75, 85, 95, 105, 115, 125, 135, 146, 156, 166, 176, 187, 197, 208, 218, 229, 239, 250, 251, 251, 251,
+        0, 0, 1, 2, 11, 19, 27, 35, 44, 52, 60, 69, 77, 85, 94, 102, 111, 120, 128, 137, 146, 154, 163, 172, 181, 190, 199, 208, 217, 226, 235,
+        0, 0, 1, 1, 5, 13, 20, 27, 34, 41, 49, 56, 63, 71, 78, 85, 93, 100, 108, 115, 123, 130, 138, 146, 153, 161, 169, 176, 184, 192, 200,
+        0, 0, 0, 1, 1, 8, 14, 21, 27, 33, 40, 46, 53, 59, 66, 72, 79, 85, 92, 99, 105, 112, 119, 125, 132, 139, 146, 152, 159, 166, 173,
+        0, 0, 0, 1, 1, 4, 10, 16, 21, 27, 33, 38, 44, 50, 56, 62, 68, 74, 79, 85, 91, 97, 103, 109, 115, 121, 127, 133, 139, 146, 152,
+        0, 0, 0, 1, 1, 1, 6, 11, 17, 22, 27, 32, 37, 43, 48, 53, 59, 64, 69, 75, 80, 85, 91, 96, 102, 107, 112, 118, 123, 129, 134,
+        0, 0, 0, 1, 1, 1, 3, 8, 13, 17, 22, 27, 32, 36, 41, 46, 51, 56, 61, 66, 71, 75, 80, 85, 90, 95, 100, 105, 110, 115, 120,
+        0, 0, 0, 0, 1, 1, 1, 5, 9, 14, 18, 22, 27, 31, 36, 40, 45, 49, 54, 58, 63, 67, 72, 76, 81, 85, 90, 94, 99, 104, 108,
+        0, 0, 0, 0, 1, 1, 1, 2, 6, 11, 15, 19, 23, 27, 31, 35, 39, 43, 47, 52, 56, 60, 64, 68, 73, 77, 81, 85, 90, 94, 98,
+        0, 0, 0, 0, 1, 1, 1, 1, 4, 8, 12, 15, 19, 23, 27, 31, 35, 38, 42, 46, 50, 54, 58, 62, 66, 69, 73, 77, 81, 85, 89,
+        0, 45, 102, 161, 221, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 10, 38, 66, 95, 124, 153, 183, 214, 244, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 19, 37, 56, 75, 94, 113, 133, 152, 172, 192, 213, 233, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 8, 22, 36, 50, 64, 79, 93, 107, 122, 137, 151, 166, 181, 196, 212, 227, 243, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 0, 1, 13, 24, 35, 46, 57, 69, 80, 91, 103, 115, 126, 138, 150, 162, 174, 186, 198, 210, 222, 235, 247, 251, 251, 251, 251, 251, 251, 251,
+        0, 0, 1, 5, 15, 24, 33, 43, 52, 61, 71, 80, 90, 100, 109, 119, 129, 139, 148, 158, 168, 178, 188, 198, 209, 219, 229, 239, 250, 251, 251,
+        0, 0, 1, 1, 8, 16, 24, 32, 40, 48, 56, 64, 72, 80, 89, 97, 105, 113, 122, 130, 139, 147, 156, 164, 173, 181, 190, 199, 207, 216, 225,
+        0, 0, 1, 1, 3, 10, 17, 24, 31, 38, 45, 52, 59, 66, 73, 80, 88, 95, 102, 109, 117, 124, 131, 139, 146, 153, 161, 168, 176, 183, 191,
+        0, 0, 0, 1, 1, 6, 12, 18, 24, 30, 36, 43, 49, 55, 61, 68, 74, 80, 87, 93, 100, 106, 113, 119, 126, 132, 139, 145, 152, 158, 165,
+        0, 0, 0, 1, 1, 2, 7, 13, 18, 24, 29, 35, 41, 46, 52, 58, 63, 69, 75, 80, 86, 92, 98, 103, 109, 115, 121, 127, 133, 139, 144,
+        0, 0, 0, 1, 1, 1, 4, 9, 14, 19, 24, 29, 34, 39, 44, 49, 54, 60, 65, 70, 75, 80, 86, 91, 96, 101, 107, 112, 117, 123, 128,
+        0, 0, 0, 0, 1, 1, 1, 5, 10, 15, 19, 24, 28, 33, 38, 42, 47, 52, 57, 61, 66, 71, 76, 80, 85, 90, 95, 100, 104, 109, 114,
+        0, 0, 0, 0, 1, 1, 1, 3, 7, 11, 15, 20, 24, 28, 32, 37, 41, 45, 50, 54, 58, 63, 67, 72, 76, 80, 85, 89, 94, 98, 103,
+        0, 0, 0, 0, 1, 1, 1, 1, 4, 8, 12, 16, 20, 24, 28, 32, 36, 40, 44, 48, 52, 56, 60, 64, 68, 72, 76, 80, 84, 89, 93,
+        0, 0, 0, 0, 1, 1, 1, 1, 2, 5, 9, 13, 16, 20, 24, 28, 31, 35, 39, 42, 46, 50, 54, 57, 61, 65, 69, 73, 76, 80, 84,
+        0, 42, 97, 154, 212, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 8, 35, 62, 90, 118, 147, 176, 205, 235, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 16, 34, 52, 71, 89, 108, 127, 146, 165, 185, 204, 224, 244, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 6, 20, 33, 47, 60, 74, 88, 102, 116, 131, 145, 159, 174, 189, 203, 218, 233, 248, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 0, 1, 10, 21, 32, 43, 54, 65, 76, 87, 98, 109, 121, 132, 144, 155, 167, 178, 190, 202, 214, 226, 238, 250, 251, 251, 251, 251, 251, 251,
+        0, 0, 1, 3, 12, 21, 30, 39, 48, 58, 67, 76, 85, 95, 104, 113, 123, 132, 142, 152, 161, 171, 181, 191, 200, 210, 220, 230, 240, 250, 251,
+        0, 0, 1, 1, 6, 14, 21, 29, 37, 45, 52, 60, 68, 76, 84, 92, 100, 108, 116, 124, 133, 141, 149, 157, 166, 174, 182, 191, 199, 208, 216,
+        0, 0, 0, 1, 1, 8, 14, 21, 28, 35, 42, 48, 55, 62, 69, 76, 83, 90, 97, 104, 111, 118, 125, 132, 140, 147, 154, 161, 169, 176, 183,
+        0, 0, 0, 1, 1, 3, 9, 15, 21, 27, 33, 39, 45, 51, 58, 64, 70, 76, 82, 88, 95, 101, 107, 113, 120, 126, 132, 139, 145, 152, 158,
+        0, 0, 0, 1, 1, 1, 5, 10, 16, 21, 27, 32, 37, 43, 48, 54, 59, 65, 70, 76, 82, 87, 93, 98, 104, 110, 115, 121, 127, 132, 138,
+        0, 0, 0, 1, 1, 1, 2, 6, 11, 16, 21, 26, 31, 36, 41, 46, 51, 56, 61, 66, 71, 76, 81, 86, 91, 96, 101, 107, 112, 117, 122,
+        0, 0, 0, 0, 1, 1, 1, 3, 8, 12, 17, 21, 26, 30, 35, 39, 44, 48, 53, 57, 62, 67, 71, 76, 81, 85, 90, 95, 99, 104, 109,
+        0, 0, 0, 0, 1, 1, 1, 1, 5, 9, 13, 17, 21, 25, 29, 34, 38, 42, 46, 50, 55, 59, 63, 67, 72, 76, 80, 84, 89, 93, 97,
+        0, 0, 0, 0, 1, 1, 1, 1, 2, 6, 10, 13, 17, 21, 25, 29, 33, 37, 40, 44, 48, 52, 56, 60, 64, 68, 72, 76, 80, 84, 88,
+        0, 0, 0, 0, 0, 1, 1, 1, 1, 3, 7, 10, 14, 17, 21, 25, 28, 32, 35, 39, 43, 46, 50, 54, 57, 61, 65, 68, 72, 76, 80,
+        0, 54, 116, 181, 247, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 15, 46, 77, 108, 140, 173, 206, 239, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 3, 25, 45, 66, 86, 107, 129, 150, 172, 194, 216, 238, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 13, 29, 44, 59, 75, 90, 106, 122, 138, 154, 171, 187, 204, 220, 237, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 5, 18, 30, 42, 55, 67, 79, 92, 105, 117, 130, 143, 156, 169, 182, 195, 209, 222, 235, 249, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 0, 1, 10, 20, 31, 41, 51, 61, 72, 82, 92, 103, 113, 124, 135, 146, 156, 167, 178, 189, 200, 211, 222, 234, 245, 251, 251, 251, 251, 251,
+        0, 0, 1, 4, 13, 22, 31, 39, 48, 57, 66, 75, 83, 92, 101, 111, 120, 129, 138, 147, 156, 166, 175, 185, 194, 203, 213, 223, 232, 242, 251,
+        0, 0, 1, 1, 8, 15, 23, 30, 38, 46, 53, 61, 69, 77, 85, 92, 100, 108, 116, 124, 132, 140, 148, 156, 165, 173, 181, 189, 198, 206, 214,
+        0, 0, 1, 1, 3, 10, 17, 24, 30, 37, 44, 51, 58, 65, 72, 78, 85, 92, 99, 106, 114, 121, 128, 135, 142, 149, 156, 164, 171, 178, 186,
+        0, 0, 0, 1, 1, 6, 12, 18, 24, 30, 37, 43, 49, 55, 61, 67, 74, 80, 86, 92, 99, 105, 111, 118, 124, 131, 137, 143, 150, 156, 163,
+        0, 0, 0, 1, 1, 2, 8, 14, 19, 25, 30, 36, 41, 47, 53, 58, 64, 70, 75, 81, 87, 92, 98, 104, 110, 115, 121, 127, 133, 139, 145,
+        0, 0, 0, 1, 1, 1, 5, 10, 15, 20, 25, 30, 35, 41, 46, 51, 56, 61, 66, 71, 77, 82, 87, 92, 98, 103, 108, 113, 119, 124, 129,
+        0, 0, 0, 1, 1, 1, 2, 7, 12, 16, 21, 26, 30, 35, 40, 44, 49, 54, 59, 63, 68, 73, 78, 83, 87, 92, 97, 102, 107, 112, 117,
+        0, 0, 0, 0, 1, 1, 1, 4, 9, 13, 17, 22, 26, 30, 35, 39, 43, 48, 52, 57, 61, 65, 70, 74, 79, 83, 88, 92, 97, 101, 106,
+        0, 0, 0, 0, 1, 1, 1, 2, 6, 10, 14, 18, 22, 26, 30, 34, 38, 43, 47, 51, 55, 59, 63, 67, 71, 76, 80, 84, 88, 92, 97,
+        0, 47, 106, 167, 230, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 11, 40, 69, 99, 129, 159, 190, 222, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 20, 39, 58, 78, 98, 118, 138, 158, 179, 200, 221, 242, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 9, 24, 38, 53, 67, 82, 97, 112, 127, 142, 157, 173, 188, 204, 220, 236, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 1, 14, 25, 37, 48, 60, 72, 83, 95, 107, 119, 131, 144, 156, 168, 181, 193, 206, 218, 231, 244, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 0, 1, 6, 16, 25, 35, 45, 54, 64, 74, 84, 94, 104, 114, 124, 134, 144, 154, 165, 175, 185, 196, 206, 217, 227, 238, 249, 251, 251, 251,
+        0, 0, 1, 1, 9, 17, 25, 34, 42, 50, 59, 67, 75, 84, 92, 101, 109, 118, 127, 135, 144, 153, 162, 171, 179, 188, 197, 206, 215, 224, 234,
+        0, 0, 1, 1, 4, 11, 18, 25, 33, 40, 47, 54, 62, 69, 76, 84, 91, 99, 106, 114, 121, 129, 136, 144, 152, 159, 167, 175, 183, 191, 198,
+        0, 0, 0, 1, 1, 6, 13, 19, 25, 32, 38, 45, 51, 58, 64, 71, 77, 84, 90, 97, 104, 110, 117, 124, 131, 137, 144, 151, 158, 165, 172,
+        0, 0, 0, 1, 1, 2, 8, 14, 20, 25, 31, 37, 43, 48, 54, 60, 66, 72, 78, 84, 90, 96, 102, 108, 114, 120, 126, 132, 138, 144, 150,
+        0, 0, 0, 1, 1, 1, 4, 10, 15, 20, 25, 30, 36, 41, 46, 52, 57, 62, 68, 73, 78, 84, 89, 95, 100, 105, 111, 116, 122, 127, 133,
+        0, 0, 0, 1, 1, 1, 1, 6, 11, 16, 20, 25, 30, 35, 40, 44, 49, 54, 59, 64, 69, 74, 79, 84, 89, 94, 99, 104, 109, 114, 119,
+        0, 0, 0, 0, 1, 1, 1, 3, 8, 12, 16, 21, 25, 30, 34, 39, 43, 47, 52, 56, 61, 65, 70, 75, 79, 84, 88, 93, 97, 102, 107,
+        0, 0, 0, 0, 1, 1, 1, 1, 5, 9, 13, 17, 21, 25, 29, 33, 38, 42, 46, 50, 54, 58, 63, 67, 71, 75, 79, 84, 88, 92, 96,
+        0, 0, 0, 0, 1, 1, 1, 1, 2, 6, 10, 14, 17, 21, 25, 29, 33, 37, 41, 44, 48, 52, 56, 60, 64, 68, 72, 76, 80, 84, 88,
+        0, 45, 103, 163, 225, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 9, 38, 66, 96, 125, 155, 186, 217, 249, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 18, 37, 56, 75, 95, 114, 134, 154, 175, 195, 216, 237, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 7, 21, 36, 50, 64, 79, 94, 108, 123, 138, 153, 169, 184, 199, 215, 231, 247, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 0, 1, 12, 23, 34, 46, 57, 69, 80, 92, 104, 116, 128, 140, 152, 164, 176, 189, 201, 213, 226, 239, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 0, 1, 4, 14, 23, 33, 42, 52, 61, 71, 81, 90, 100, 110, 120, 130, 140, 150, 160, 171, 181, 191, 201, 212, 222, 233, 243, 251, 251, 251,
+        0, 0, 1, 1, 7, 15, 23, 31, 39, 48, 56, 64, 72, 81, 89, 98, 106, 115, 123, 132, 140, 149, 158, 166, 175, 184, 193, 202, 210, 219, 228,
+        0, 0, 1, 1, 2, 9, 16, 23, 30, 37, 44, 52, 59, 66, 73, 81, 88, 95, 103, 110, 118, 125, 133, 140, 148, 155, 163, 171, 178, 186, 194,
+        0, 0, 0, 1, 1, 4, 10, 17, 23, 29, 36, 42, 48, 55, 61, 68, 74, 81, 87, 94, 100, 107, 114, 120, 127, 134, 140, 147, 154, 160, 167,
+        0, 0, 0, 1, 1, 1, 6, 12, 17, 23, 29, 34, 40, 46, 52, 57, 63, 69, 75, 81, 87, 92, 98, 104, 110, 116, 122, 128, 134, 140, 146,
+        0, 0, 0, 1, 1, 1, 2, 8, 13, 18, 23, 28, 33, 38, 44, 49, 54, 59, 65, 70, 75, 81, 86, 91, 97, 102, 107, 113, 118, 124, 129,
+        0, 0, 0, 0, 1, 1, 1, 4, 9, 14, 18, 23, 28, 32, 37, 42, 47, 52, 56, 61, 66, 71, 76, 81, 86, 90, 95, 100, 105, 110, 115,
+        0, 0, 0, 0, 1, 1, 1, 1, 6, 10, 14, 19, 23, 27, 32, 36, 40, 45, 49, 54, 58, 63, 67, 72, 76, 81, 85, 90, 94, 99, 103,
+        0, 0, 0, 0, 1, 1, 1, 1, 3, 7, 11, 15, 19, 23, 27, 31, 35, 39, 43, 47, 52, 56, 60, 64, 68, 72, 76, 81, 85, 89, 93,
+        0, 0, 0, 0, 0, 1, 1, 1, 1, 4, 8, 12, 15, 19, 23, 27, 30, 34, 38, 42, 46, 50, 53, 57, 61, 65, 69, 73, 77, 81, 85,
+        0, 58, 122, 188, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 19, 51, 82, 114, 147, 180, 214, 249, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 6, 29, 50, 71, 92, 113, 135, 157, 179, 202, 225, 248, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 17, 33, 49, 64, 80, 96, 112, 129, 145, 162, 178, 195, 212, 229, 246, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 8, 22, 34, 47, 59, 72, 85, 98, 111, 124, 137, 150, 163, 177, 190, 204, 217, 231, 245, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        0, 1, 2, 14, 25, 35, 45, 56, 66, 77, 87, 98, 109, 120, 131, 142, 153, 164, 175, 186, 197, 209, 220, 231, 243, 251, 251, 251, 251, 251, 251,
+        0, 0, 1, 7, 17, 26, 35, 44, 53, 62, 71, 80, 89, 98, 107, 117, 126, 135, 145, 154, 164, 173, 183, 193, 202, 212, 222, 232, 241, 251, 251,
+        0, 0, 1, 3, 11, 19, 27, 35, 43, 50, 58, 66, 74, 82, 90, 98, 106, 114, 123, 131, 139, 147, 155, 164, 172, 181, 189, 197, 206, 214, 223,
+        0, 0, 1, 1, 6, 14, 21, 28, 35, 42, 49, 56, 63, 70, 77, 84, 91, 98, 105, 113, 120, 127, 134, 142, 149, 156, 164, 171, 179, 186, 194,
+        0, 0, 1, 1, 3, 9, 16, 22, 29, 35, 41, 47, 54, 60, 66, 73, 79, 85, 92, 98, 105, 111, 118, 124, 131, 137, 144, 150, 157, 164, 170,
+        0, 0, 0, 1, 1, 6, 12, 18, 23, 29, 35, 40, 46, 52, 57, 63, 69, 75, 81, 86, 92, 98, 104, 110, 116, 122, 128, 134, 140, 146, 152,
+        0, 0, 0, 1, 1, 3, 8, 14, 19, 24, 29, 35, 40, 45, 50, 56, 61, 66, 71, 77, 82, 87, 93, 98, 103, 109, 114, 120, 125, 131, 136,
+        0, 0, 0, 1, 1, 1, 5, 11, 16, 20, 25, 30, 35, 39, 44, 49, 54, 59, 64, 69, 73, 78, 83, 88, 93, 98, 103, 108, 113, 118, 123,
+        0, 0, 0, 1, 1, 1, 3, 8, 12, 17, 21, 26, 30, 35, 39, 44, 48, 53, 57, 62, 66, 71, 75, 80, 84, 89, 93, 98, 103, 107, 112,
+        0, 0, 0, 0, 1, 1, 1, 5, 10, 14, 18, 22, 26, 30, 35, 39, 43, 47, 51, 56, 60, 64, 68, 72, 77, 81, 85, 89, 94, 98, 102
+    } };
+}
@@ -0,0 +1,238 @@
+#pragma once
+// GENERATED by tools/generate_grid_cells.cpp from the weather assets, do not edit
+#include <array>
+
+namespace heatninja {
+    struct GridCellAsset {
+        int latitude_step, longitude_step; // half degree steps
+        float coldest_outside_temperature;
+    };
+
+    constexpr std::array<GridCellAsset, 225> grid_cell_assets = { {
+        { 100, -11, 4.4920001f },
+        { 100, -10, 4.0170002f },
+        { 100, -9, 4.40600014f },
+        { 100, -8, 4.5539999f },
+        { 100, -7, 4.61000013f },
+        { 101, -10, 2.70799994f },
+        { 101, -9, 1.26999998f },
+        { 101, -8, 0.853999972f },
+        { 101, -7, 1.74399996f },
+        { 101, -6, 2.69700003f },
+        { 101, -5, 2.77399993f },
+        { 101, -4, 2.58299994f },
+        { 101, -3, 2.81200004f },
+        { 101, -2, 3.18799996f },
+        { 101, -1, 3.01999998f },
+        { 101, 0, 2.88599992f },
+        { 101, 1, 2.76399994f },
+        { 102, -9, 1.63800001f },
+        { 102, -8, -0.231999993f },
+        { 102, -7, -1.71200001f },
+        { 102, -6, -2.63499999f },
+        { 102, -5, -3.76399994f },
+        { 102, -4, -4.27400017f },
+        { 102, -3, -4.421f },
+        { 102, -2, -4.28499985f },
+        { 102, -1, -3.84599996f },
+        { 102, 0, -3.3440001f },
+        { 102, 1, -2.10100007f },
+        { 102, 2, 0.307000011f },
+        { 102, 3, 1.27100003f },
+        { 103, -10, 2.94799995f },
+        { 103, -9, 2.00099993f },
+        { 103, -8, 1.24899995f },
+        { 103, -7, 0.221000001f },
+        { 103, -6, -1.59099996f },
+        { 103, -5, -3.03900003f },
+        { 103, -4, -4.29199982f },
+        { 103, -3, -5.09000015f },
+        { 103, -2, -5.67299986f },
+        { 103, -1, -5.96899986f },
+        { 103, 0, -5.62799978f },
+        { 103, 1, -4.16499996f },
+        { 103, 2, -1.36899996f },
+        { 103, 3, 1.81299996f },
+        { 104, -11, 3.62199998f },
+        { 104, -10, 2.04399991f },
+        { 104, -9, -0.64200002f },
+        { 104, -8, -2.29699993f },
+        { 104, -7, -3.13000011f },
+        { 104, -6, -3.59699988f },
+        { 104, -5, -3.70000005f },
+        { 104, -4, -4.36999989f },
+        { 104, -3, -4.85400009f },
+        { 104, -2, -5.28299999f },
+        { 104, -1, -5.60099983f },
+        { 104, 0, -5.43900013f },
+        { 104, 1, -4.53299999f },
+        { 104, 2, -2.83599997f },
+        { 104, 3, 0.145999998f },
+        { 105, -9, 2.76900005f },
+        { 105, -8, -0.479000002f },
+        { 105, -7, -3.00699997f },
+        { 105, -6, -3.35899997f },
+        { 105, -5, -3.60299993f },
+        { 105, -4, -3.99099994f },
+        { 105, -3, -4.45100021f },
+        { 105, -2, -4.81400013f },
+        { 105, -1, -4.97900009f },
+        { 105, 0, -4.84499979f },
+        { 105, 1, -4.0f },
+        { 105, 2, -3.96000004f },
+        { 105, 3, -1.778f },
+        { 105, 4, 1.57599998f },
+        { 106, -10, 3.8269999f },
+        { 106, -9, 1.98699999f },
+        { 106, -8, -0.30399999f },
+        { 106, -7, -2.41899991f },
+        { 106, -6, -2.96399999f },
+        { 106, -5, -3.40899992f },
+        { 106, -4, -3.80599999f },
+        { 106, -3, -4.23400021f },
+        { 106, -2, -4.51000023f },
+        { 106, -1, -4.43400002f },
+        { 106, 0, -4.07000017f },
+        { 106, 1, -1.75399995f },
+        { 106, 2, 0.27700001f },
+        { 106, 3, 1.70899999f },
+        { 106, 4, 2.39700007f },
+        { 107, -9, 2.57800007f },
+        { 107, -8, 1.52400005f },
+        { 107, -7, 0.44600001f },
+        { 107, -6, -1.34399998f },
+        { 107, -5, -2.72900009f },
+        { 107, -4, -3.4920001f },
+        { 107, -3, -3.83400011f },
+        { 107, -2, -4.14099979f },
+        { 107, -1, -4.15600014f },
+        { 107, 0, -2.1730001f },
+        { 107, 1, 1.35099995f },
+        { 108, -16, -2.84800005f },
+        { 108, -15, -3.29399991f },
+        { 108, -14, -3.16400003f },
+        { 108, -13, -1.49600005f },
+        { 108, -12, 1.15100002f },
+        { 108, -11, 3.29699993f },
+        { 108, -7, 1.22000003f },
+        { 108, -6, -0.560000002f },
+        { 108, -5, -2.76600003f },
+        { 108, -4, -3.83699989f },
+        { 108, -3, -3.83400011f },
+        { 108, -2, -3.42400002f },
+        { 108, -1, -2.62199998f },
+        { 108, 0, 0.231000006f },
+        { 109, -16, -1.80799997f },
+        { 109, -15, -2.66199994f },
+        { 109, -14, -3.04099989f },
+        { 109, -13, -2.33800006f },
+        { 109, -12, -0.574999988f },
+        { 109, -11, 1.33700001f },
+        { 109, -10, 2.99399996f },
+        { 109, -9, 2.24399996f },
+        { 109, -8, 1.04700005f },
+        { 109, -7, -0.423999995f },
+        { 109, -6, -2.18700004f },
+        { 109, -5, -5.16099977f },
+        { 109, -4, -5.579f },
+        { 109, -3, -4.41400003f },
+        { 109, -2, -1.903f },
+        { 109, -1, 0.578999996f },
+        { 110, -15, -0.769999981f },
+        { 110, -14, -0.992999971f },
+        { 110, -13, -0.469000012f },
+        { 110, -12, 0.887000024f },
+        { 110, -11, 2.08100009f },
+        { 110, -10, 0.805999994f },
+        { 110, -9, -0.407000005f },
+        { 110, -8, -1.58000004f },
+        { 110, -7, -2.70300007f },
+        { 110, -6, -4.51399994f },
+        { 110, -5, -6.204f },
+        { 110, -4, -4.15500021f },
+        { 110, -3, -0.995999992f },
+        { 111, -13, 2.50500011f },
+        { 111, -12, 2.05699992f },
+        { 111, -11, 1.33800006f },
+        { 111, -10, -0.578999996f },
+        { 111, -9, -2.35800004f },
+        { 111, -8, -4.13199997f },
+        { 111, -7, -4.89499998f },
+        { 111, -6, -5.56599998f },
+        { 111, -5, -5.70200014f },
+        { 111, -4, -2.47399998f },
+        { 111, -3, 0.873000026f },
+        { 112, -13, 2.977f },
+        { 112, -12, 1.06299996f },
+        { 112, -11, -1.18099999f },
+        { 112, -10, -3.49900007f },
+        { 112, -9, -4.91900015f },
+        { 112, -8, -5.48999977f },
+        { 112, -7, -4.62599993f },
+        { 112, -6, -2.18899989f },
+        { 112, -5, 0.194999993f },
+        { 112, -4, 1.81500006f },
+        { 113, -14, 4.2420001f },
+        { 113, -13, 2.69899988f },
+        { 113, -12, 0.0460000001f },
+        { 113, -11, -3.25300002f },
+        { 113, -10, -5.87900019f },
+        { 113, -9, -7.00500011f },
+        { 113, -8, -6.75699997f },
+        { 113, -7, -5.40999985f },
+        { 113, -6, -3.1099999f },
+        { 113, -5, -0.305000007f },
+        { 114, -15, 4.06599998f },
+        { 114, -14, 3.24900007f },
+        { 114, -13, 2.421f },
+        { 114, -12, -0.368000001f },
+        { 114, -11, -4.21099997f },
+        { 114, -10, -7.61299992f },
+        { 114, -9, -8.95199966f },
+        { 114, -8, -8.53100014f },
+        { 114, -7, -8.25599957f },
+        { 114, -6, -6.77400017f },
+        { 114, -5, -4.34700012f },
+        { 114, -4, 1.06099999f },
+        { 115, -15, 3.28699994f },
+        { 115, -14, 2.64899993f },
+        { 115, -13, 2.10500002f },
+        { 115, -12, 0.00200000009f },
+        { 115, -11, -3.77099991f },
+        { 115, -10, -7.04899979f },
+        { 115, -9, -5.41200018f },
+        { 115, -8, -4.35099983f },
+        { 115, -7, -3.82500005f },
+        { 115, -6, -3.24000001f },
+        { 115, -5, -2.63599992f },
+        { 115, -4, 0.561999977f },
+        { 116, -14, 1.75699997f },
+        { 116, -13, 2.05599999f },
+        { 116, -12, 2.13899994f },
+        { 116, -11, 0.609000027f },
+        { 116, -10, -2.02900004f },
+        { 116, -9, -2.39199996f },
+        { 116, -8, -0.871999979f },
+        { 116, -7, 1.61399996f },
+        { 117, -14, 2.66100001f },
+        { 117, -13, 2.72300005f },
+        { 117, -12, 2.90100002f },
+        { 117, -11, 2.93499994f },
+        { 117, -10, 1.60500002f },
+        { 117, -9, 0.902999997f },
+        { 117, -8, 0.970000029f },
+        { 117, -7, 1.38199997f },
+        { 117, -6, 1.92400002f },
+        { 118, -7, 3.06599998f },
+        { 118, -6, 2.5250001f },
+        { 118, -5, 2.9749999f },
+        { 119, -6, 3.78999996f },
+        { 119, -5, 3.68400002f },
+        { 119, -3, 3.2809999f },
+        { 120, -3, 2.3829999f },
+        { 120, -2, 2.36100006f },
+        { 121, -3, 1.78299999f },
+        { 121, -2, 1.79400003f },
+        { 122, -2, 1.72099996f }
+    } };
+}
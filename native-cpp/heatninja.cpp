@@ -1,12 +1,25 @@
 #include "heatninja.h"
+#include "grid_cells.h"
+#include "optimiser_parameters.h"
+#include "epc_transmittance_table.h"
+#include "allocation_counter.h"
 #include <sstream>
 #include <iostream>
 #include <fstream>
-#include <map>
 #include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <random>
+#include <chrono>
+#include <limits>
+#include <type_traits>
 
 #ifndef EM_COMPATIBLE
     #include <execution>
+    #include <future>
 #endif
 
 namespace heatninja {
@@ -19,7 +32,41 @@ namespace heatninja {
 
     int file_index;
     SimulationOptions simulation_options;
-    std::ofstream all_specs_file;
+    std::array<std::vector<HeatSolarSystemSpecifications>, 21> all_specs_buffers; // one per heat & solar combination, only touched by the task simulating it
+    std::array<std::vector<HeatSolarSystemSpecifications>, 21> pareto_frontiers; // one per heat & solar combination, only touched by the task simulating it
+
+    struct IndexRect {
+        size_t i1, j1, i2, j2;
+    };
+
+    struct CoarsePoint {
+        float npc;
+        int tes_option, solar_size;
+    };
+
+    // optimiser working memory, kept between runs so the surface search stops allocating once warmed up
+    struct OptimiserScratch {
+        std::vector<float> zs;
+        std::vector<size_t> is, js;
+        std::vector<IndexRect> index_rects, next_index_rects;
+        std::vector<CoarsePoint> coarse_points;
+        std::vector<SurrogatePoint> surrogate_points;
+        std::vector<double> surrogate_cholesky, surrogate_weights, surrogate_kernel_column;
+        std::vector<YearlyOperation> year_operations; // one per weather ensemble year after the first
+        float seed_z; // the smallest system's npc from a time bounded run's seed pass, so the search doesn't evaluate it again
+    };
+    std::array<OptimiserScratch, 21> optimiser_scratches; // one per heat & solar combination, only touched by the task simulating it
+    std::array<std::chrono::steady_clock::time_point, 21> search_deadlines; // one per heat & solar combination, max() when unbounded
+    std::array<bool, 21> searches_cut_short; // one per heat & solar combination, only touched by the task simulating it
+    std::array<size_t, 21> combination_evaluations; // one per heat & solar combination, only touched by the task simulating it
+
+    struct EnsembleWeatherYear {
+        std::vector<float> outside_temperatures, solar_irradiances; // one per operational step
+    };
+    std::vector<EnsembleWeatherYear> ensemble_weather_years; // the weather ensemble's years after the first, set by run_simulation, empty without an ensemble
+#ifdef HEATNINJA_COUNT_ALLOCATIONS
+    std::array<size_t, 21> combination_heap_allocations;
+#endif
 
     // DEFINTIONS
 
@@ -53,6 +100,7 @@ namespace heatninja {
     // simulation
 
     std::string run_simulation(const float thermostat_temperature, const float latitude, const float longitude, const int num_occupants, const float house_size, const std::string& postcode, const int epc_space_heating, const float tes_volume_max, const SimulationOptions& simulation_options) {
+        const auto run_deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(simulation_options.time_budget));
 
         heatninja::simulation_options = simulation_options;
         constexpr int float_print_precision = 2;
@@ -76,40 +124,52 @@ namespace heatninja {
         std::cout << "output_demand: " << simulation_options.output_demand << '\n';
         std::cout << "output_optimal_specs: " << simulation_options.output_optimal_specs << '\n';
         std::cout << "output_all_specs: " << simulation_options.output_all_specs << '\n';
+        std::cout << "output_hourly_traces: " << simulation_options.output_hourly_traces << '\n';
+        std::cout << "output_pareto_frontiers: " << simulation_options.output_pareto_frontiers << '\n';
 #endif
 
 #ifndef EM_COMPATIBLE
         if (simulation_options.output_all_specs) {
-            all_specs_file.open("debug_data/all_specs_" + std::to_string(simulation_options.output_file_index) + ".csv");
+            for (auto& all_specs_buffer : all_specs_buffers) {
+                all_specs_buffer.clear();
+            }
+        }
+#endif
+
+        for (auto& pareto_frontier : pareto_frontiers) {
+            pareto_frontier.clear();
+        }
+
+#ifndef EM_COMPATIBLE
+        // asset files load in the background while the EPC fit and monthly precomputation run, joined where first used
+        std::future<std::vector<float>> outside_temperatures_load, solar_irradiances_load, agile_tariff_load;
+        if (simulation_options.weather_store == nullptr) {
+            outside_temperatures_load = std::async(std::launch::async, import_weather_data, "outside_temps", latitude, longitude);
+            solar_irradiances_load = std::async(std::launch::async, import_weather_data, "solar_irradiances", latitude, longitude);
+            agile_tariff_load = std::async(std::launch::async, import_per_hour_of_year_data, "assets/agile_tariff.csv");
         }
 #endif
 
         const std::array<float, 24> erh_hourly_temperatures_over_day = calculate_erh_hourly_temperature_profile(thermostat_temperature);
         const std::array<float, 24> hp_hourly_temperatures_over_day = calculate_hp_hourly_temperature_profile(thermostat_temperature);
 
-        constexpr std::array<float, 12> monthly_solar_declinations = { -20.7f, -12.8f, -1.8f, 9.8f, 18.8f, 23.1f, 21.2f, 13.7f, 2.9f, -8.7f, -18.4f, -23.0f };
         const std::array<float, 12> monthly_solar_height_factors = calculate_monthly_solar_height_factors(latitude, monthly_solar_declinations);
 
-        constexpr std::array<float, 12> dhw_monthly_factors = { 1.10f, 1.06f, 1.02f, 0.98f, 0.94f, 0.90f, 0.90f, 0.94f, 0.98f, 1.02f, 1.06f, 1.10f };
         const std::array<float, 12> monthly_cold_water_temperatures = calculate_monthly_cold_water_temperatures(latitude);
 
         const std::array<float, 12> monthly_solar_gain_ratios_north = calculate_monthly_solar_gain_ratios_north(monthly_solar_height_factors);
         const std::array<float, 12> monthly_solar_gain_ratios_south = calculate_monthly_solar_gain_ratios_south(monthly_solar_height_factors);
 
-        constexpr std::array<float, 24> hot_water_hourly_ratios = { 0.025f, 0.018f, 0.011f, 0.010f, 0.008f, 0.013f, 0.017f, 0.044f, 0.088f, 0.075f, 0.060f, 0.056f, 0.050f, 0.043f, 0.036f, 0.029f, 0.030f, 0.036f, 0.053f, 0.074f, 0.071f, 0.059f, 0.050f, 0.041f };
-
-        const std::vector<float> hourly_outside_temperatures_over_year = import_weather_data("outside_temps", latitude, longitude);
-        const std::vector<float> hourly_solar_irradiances_over_year = import_weather_data("solar_irradiances", latitude, longitude);
-
         const float average_daily_hot_water_volume = calculate_average_daily_hot_water_volume(num_occupants);
 
-        constexpr int hot_water_temperature = 51;
-
         const float solar_gain_house_factor = calculate_solar_gain_house_factor(house_size);
 
         const float epc_body_gain = calculate_epc_body_gain(house_size);
 
         const int region_identifier = calculate_region_identifier(postcode);
+        if (region_identifier == -1) {
+            throw std::invalid_argument("unknown postcode \"" + postcode + "\"");
+        }
         const std::array<float, 12> monthly_epc_outside_temperatures = calculate_monthly_epc_outside_temperatures(region_identifier);
         const std::array<int, 12> monthly_epc_solar_irradiances = calculate_monthly_epc_solar_irradiances(region_identifier);
 
@@ -121,23 +181,87 @@ namespace heatninja {
         const float heat_capacity = calculate_heat_capacity(house_size);
         const float body_heat_gain = calculate_body_heat_gain(num_occupants);
 
+        const StageHooks* stage_hooks = simulation_options.stage_hooks;
+        const auto start_stage = [stage_hooks](std::string_view stage) { if (stage_hooks != nullptr && stage_hooks->on_stage_start) stage_hooks->on_stage_start(stage); };
+        const auto end_stage = [stage_hooks](std::string_view stage) { if (stage_hooks != nullptr && stage_hooks->on_stage_end) stage_hooks->on_stage_end(stage); };
+
         std::cout << "\n--- Energy Performance Certicate Demand ---" << '\n';
-        const auto [dwelling_thermal_transmittance, optimised_epc_demand] = calculate_dwellings_thermal_transmittance(house_size, epc_body_gain, monthly_epc_outside_temperatures, monthly_epc_solar_irradiances, monthly_solar_height_factors, monthly_solar_declinations, monthly_solar_gains_south, monthly_solar_gains_north, heat_capacity, epc_space_heating);
+        start_stage("epc-fit");
+        const auto [dwelling_thermal_transmittance, optimised_epc_demand] = lookup_dwellings_thermal_transmittance(region_identifier, house_size, epc_body_gain, monthly_epc_outside_temperatures, monthly_epc_solar_irradiances, monthly_solar_height_factors, monthly_solar_declinations, monthly_solar_gains_south, monthly_solar_gains_north, heat_capacity, epc_space_heating);
+        end_stage("epc-fit");
+
+        // first use of the hourly weather
+        std::vector<float> hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year;
+        if (simulation_options.weather_store != nullptr) {
+            const GridCell* grid_cell = find_grid_cell(latitude, longitude);
+            if (grid_cell == nullptr) {
+                throw std::out_of_range("no weather data for latitude " + float_to_string(latitude, 4) + ", longitude " + float_to_string(longitude, 4));
+            }
+            const WeatherStore& weather_store = *simulation_options.weather_store;
+            const size_t first_series = grid_cell->cell_index * weather_store.years;
+            decode_weather_series(weather_store.outside_temperatures, weather_store.outside_temperature_scales.at(first_series), first_series, hourly_outside_temperatures_over_year);
+            decode_weather_series(weather_store.solar_irradiances, weather_store.solar_irradiance_scales.at(first_series), first_series, hourly_solar_irradiances_over_year);
+            ensemble_weather_years.resize(weather_store.years - 1);
+            for (size_t year = 1; year < weather_store.years; ++year) {
+                EnsembleWeatherYear& ensemble_weather_year = ensemble_weather_years.at(year - 1);
+                decode_weather_series(weather_store.outside_temperatures, weather_store.outside_temperature_scales.at(first_series + year), first_series + year, ensemble_weather_year.outside_temperatures);
+                decode_weather_series(weather_store.solar_irradiances, weather_store.solar_irradiance_scales.at(first_series + year), first_series + year, ensemble_weather_year.solar_irradiances);
+            }
+        }
+        else {
+            ensemble_weather_years.clear();
+#ifndef EM_COMPATIBLE
+            hourly_outside_temperatures_over_year = outside_temperatures_load.get();
+            hourly_solar_irradiances_over_year = solar_irradiances_load.get();
+#else
+            hourly_outside_temperatures_over_year = import_weather_data("outside_temps", latitude, longitude);
+            hourly_solar_irradiances_over_year = import_weather_data("solar_irradiances", latitude, longitude);
+#endif
+        }
+        // the operation steps steps_per_hour times an hour, the demand & representative days stay hourly
+        const size_t steps_per_hour = simulation_options.steps_per_hour;
+        if (steps_per_hour != 1 && steps_per_hour != 2) {
+            throw std::invalid_argument("steps_per_hour must be 1 or 2");
+        }
+        std::vector<float> outside_temperatures_per_step, solar_irradiances_per_step;
+        if (steps_per_hour != 1) {
+            outside_temperatures_per_step = resample_series(hourly_outside_temperatures_over_year, steps_per_hour);
+            solar_irradiances_per_step = resample_series(hourly_solar_irradiances_over_year, steps_per_hour);
+        }
+        for (EnsembleWeatherYear& ensemble_weather_year : ensemble_weather_years) {
+            ensemble_weather_year.outside_temperatures = resample_series(std::move(ensemble_weather_year.outside_temperatures), steps_per_hour);
+            ensemble_weather_year.solar_irradiances = resample_series(std::move(ensemble_weather_year.solar_irradiances), steps_per_hour);
+        }
+        for (OptimiserScratch& scratch : optimiser_scratches) {
+            scratch.year_operations.resize(ensemble_weather_years.size());
+        }
+        hourly_outside_temperatures_over_year = resample_series(std::move(hourly_outside_temperatures_over_year), 1);
+        hourly_solar_irradiances_over_year = resample_series(std::move(hourly_solar_irradiances_over_year), 1);
+        const std::vector<float>& operation_outside_temperatures = steps_per_hour != 1 ? outside_temperatures_per_step : hourly_outside_temperatures_over_year;
+        const std::vector<float>& operation_solar_irradiances = steps_per_hour != 1 ? solar_irradiances_per_step : hourly_solar_irradiances_over_year;
 
+        start_stage("demand");
+        const auto calculate_demand = [&](const std::array<float, 24>& hourly_temperatures_over_day) {
+            if (simulation_options.demand_engine == DemandEngine::Scan) {
+                return calculate_yearly_space_and_hot_water_demand_scan(hourly_temperatures_over_day, thermostat_temperature, dhw_monthly_factors, monthly_cold_water_temperatures, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, hot_water_hourly_ratios, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, average_daily_hot_water_volume, hot_water_temperature, solar_gain_house_factor, house_size, dwelling_thermal_transmittance, heat_capacity, body_heat_gain, simulation_options.use_multithreading);
+            }
+            return calculate_yearly_space_and_hot_water_demand(hourly_temperatures_over_day, thermostat_temperature, dhw_monthly_factors, monthly_cold_water_temperatures, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, hot_water_hourly_ratios, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, average_daily_hot_water_volume, hot_water_temperature, solar_gain_house_factor, house_size, dwelling_thermal_transmittance, heat_capacity, body_heat_gain);
+        };
         std::cout << "\n--- Electric Resistance Heating Yearly Demand ---" << '\n';
         // structured bindings c++17 https://www.educative.io/edpresso/how-to-return-multiple-values-from-a-function-in-cpp17 https://en.cppreference.com/w/cpp/language/structured_binding
-        const auto [yearly_erh_demand, maximum_hourly_erh_demand, yearly_erh_space_demand, yearly_erh_hot_water_demand] = calculate_yearly_space_and_hot_water_demand(erh_hourly_temperatures_over_day, thermostat_temperature, dhw_monthly_factors, monthly_cold_water_temperatures, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, hot_water_hourly_ratios, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, average_daily_hot_water_volume, hot_water_temperature, solar_gain_house_factor, house_size, dwelling_thermal_transmittance, heat_capacity, body_heat_gain);
+        const auto [yearly_erh_demand, maximum_hourly_erh_demand, yearly_erh_space_demand, yearly_erh_hot_water_demand] = calculate_demand(erh_hourly_temperatures_over_day);
 
         std::cout << "\n--- Heat Pump Yearly Demand ---" << '\n';
-        const auto [yearly_hp_demand, maximum_hourly_hp_demand, yearly_hp_space_demand, yearly_hp_hot_water_demand] = calculate_yearly_space_and_hot_water_demand(hp_hourly_temperatures_over_day, thermostat_temperature, dhw_monthly_factors, monthly_cold_water_temperatures, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, hot_water_hourly_ratios, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, average_daily_hot_water_volume, hot_water_temperature, solar_gain_house_factor, house_size, dwelling_thermal_transmittance, heat_capacity, body_heat_gain);
+        const auto [yearly_hp_demand, maximum_hourly_hp_demand, yearly_hp_space_demand, yearly_hp_hot_water_demand] = calculate_demand(hp_hourly_temperatures_over_day);
+        end_stage("demand");
 
-        // Output results to JSON
-        std::stringstream ss;
-        // {"demand":{"boiler":{"hot-water":2309,"space":872,"total":3109,"peak-hourly":178},"heat-pump":{"hot-water":2309,"space":872,"total":3109,"peak-hourly":178}}
-        ss << "{\"demand\":{";
-        ss << "\"boiler\":" << "{\"hot-water\":" << yearly_erh_hot_water_demand << ",\"space\":" << yearly_erh_space_demand << ",\"total\":" << yearly_erh_demand << ",\"peak-hourly\":" << maximum_hourly_erh_demand << "},";
-        ss << "\"heat-pump\":" << "{\"hot-water\":" << yearly_hp_hot_water_demand << ",\"space\":" << yearly_hp_space_demand << ",\"total\":" << yearly_hp_demand << ",\"peak-hourly\":" << maximum_hourly_hp_demand << "}},";
-        ss << "\"systems\":{";
+        // Output results to JSON, only formatted where it is returned or streamed
+        const ResultStream* result_stream = simulation_options.result_stream;
+        const bool output_json = simulation_options.output_json;
+        const HouseholdDemand household_demand = { { yearly_erh_demand, maximum_hourly_erh_demand, yearly_erh_space_demand, yearly_erh_hot_water_demand }, { yearly_hp_demand, maximum_hourly_hp_demand, yearly_hp_space_demand, yearly_hp_hot_water_demand } };
+        const bool stream_demand = result_stream != nullptr && result_stream->on_demand;
+        const std::string demand_json = output_json || stream_demand ? household_demand_to_json(household_demand) : std::string();
+        if (stream_demand) result_stream->on_demand(demand_json);
 
 #ifndef EM_COMPATIBLE
         if (simulation_options.output_demand) write_demand_data("debug_data/demand_" + std::to_string(simulation_options.output_file_index) + ".csv", dwelling_thermal_transmittance, optimised_epc_demand, yearly_erh_demand, maximum_hourly_erh_demand, yearly_erh_space_demand, yearly_erh_hot_water_demand, yearly_hp_demand, maximum_hourly_hp_demand, yearly_hp_space_demand, yearly_hp_hot_water_demand);
@@ -155,28 +279,152 @@ namespace heatninja {
         const float cumulative_discount_rate = calculate_cumulative_discount_rate(discount_rate, npc_years);
         const std::array<float, 12> monthly_roof_ratios_south = calculate_roof_ratios_south(monthly_solar_declinations, latitude);
         constexpr float u_value = 1.30f / 1000; // 0.00130 kW / m2K linearised from https ://zenodo.org/record/4692649#.YQEbio5KjIV &
-        const std::vector<float> agile_tariff_per_hour_over_year = import_per_hour_of_year_data("assets/agile_tariff.csv");
+#ifndef EM_COMPATIBLE
+        const std::vector<float> agile_tariff_per_hour_over_year = resample_series(simulation_options.weather_store != nullptr ? simulation_options.weather_store->agile_tariff_per_hour_over_year : agile_tariff_load.get(), steps_per_hour);
+#else
+        const std::vector<float> agile_tariff_per_hour_over_year = resample_series(simulation_options.weather_store != nullptr ? simulation_options.weather_store->agile_tariff_per_hour_over_year : import_per_hour_of_year_data("assets/agile_tariff.csv"), steps_per_hour);
+#endif
         constexpr int grid_emissions = 212; // Current UK 212gCO2e/kWh electricity
         // https://www.gov.uk/government/publications/greenhouse-gas-reporting-conversion-factors-2021
 
+        std::vector<RepresentativeDay> representative_days;
+        if (simulation_options.representative_days > 0) representative_days = select_representative_days(hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, simulation_options.representative_days);
+
         std::array<HeatSolarSystemSpecifications, 21> optimal_specifications;
-        
+        std::array<NpcDistribution, 21> npc_distributions;
+        std::array<std::string, 21> systems_json;
+
+        const bool time_bounded = simulation_options.time_budget > 0;
+        const size_t weather_years = ensemble_weather_years.size() + 1;
+
+        PriceScenarios price_scenarios;
+        if (simulation_options.monte_carlo.scenarios > 0) price_scenarios = sample_price_scenarios(simulation_options.monte_carlo, npc_years, weather_years);
+
+        SensitivityHousehold sensitivity_household;
+        if (simulation_options.output_sensitivities) {
+            std::cout << "\n--- Sensitivity Demand ---" << '\n';
+            sensitivity_household = seed_sensitivity_household(thermostat_temperature, house_size, dwelling_thermal_transmittance, dhw_monthly_factors, monthly_cold_water_temperatures, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, hot_water_hourly_ratios, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, average_daily_hot_water_volume, hot_water_temperature, body_heat_gain);
+        }
+
+        // a combination's json is finished by the task optimising it, so it can be streamed straight away
+        const auto finish_heat_solar_combination = [&](const int i) {
+            const auto& s = optimal_specifications.at(i);
+            // the repricing & sensitivities are left out of systems finished after the deadline, so time_budget bounds them too
+            const bool past_deadline = time_bounded && std::chrono::steady_clock::now() >= run_deadline;
+            const bool reprice = simulation_options.monte_carlo.scenarios > 0 && !past_deadline;
+            const bool output_sensitivities = simulation_options.output_sensitivities && !past_deadline;
+            if (reprice) {
+                // dispatch is traced once per optimal spec & weather year under its own tariff, then held fixed while prices vary
+                const auto trace_repricing_totals = [&](const std::vector<float>& outside_temperatures, const std::vector<float>& solar_irradiances) {
+                    const std::vector<HourlyTrace> hourly_traces = trace_heat_solar_specification(s, ground_temp, erh_hourly_temperatures_over_day, hp_hourly_temperatures_over_day, hot_water_temperature, coldest_outside_temperature_of_year, maximum_hourly_erh_demand, maximum_hourly_hp_demand, thermostat_temperature, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_roof_ratios_south, outside_temperatures, solar_irradiances, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product);
+                    return calculate_repricing_totals(s.tariff, hourly_traces, agile_tariff_per_hour_over_year);
+                };
+                std::vector<RepricingTotals> repricing_totals;
+                repricing_totals.reserve(weather_years);
+                repricing_totals.push_back(trace_repricing_totals(operation_outside_temperatures, operation_solar_irradiances));
+                for (const EnsembleWeatherYear& ensemble_weather_year : ensemble_weather_years) {
+                    repricing_totals.push_back(trace_repricing_totals(ensemble_weather_year.outside_temperatures, ensemble_weather_year.solar_irradiances));
+                }
+                std::vector<float> npcs;
+                npc_distributions.at(i) = reprice_specification(s, repricing_totals, price_scenarios, npcs);
+            }
+            const bool stream_system = result_stream != nullptr && result_stream->on_system;
+            if (!output_json && !stream_system) return;
+            const bool search_complete = !searches_cut_short.at(i);
+            SpecificationSensitivities sensitivities;
+            if (output_sensitivities) sensitivities = calculate_specification_sensitivities(s, sensitivity_household, ground_temp, hot_water_temperature, coldest_outside_temperature_of_year, cumulative_discount_rate, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_roof_ratios_south, operation_outside_temperatures, operation_solar_irradiances, u_value, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, grid_emissions, body_heat_gain);
+            systems_json.at(i) = heat_solar_system_to_json(s, simulation_options.output_pareto_frontiers ? &pareto_frontiers.at(i) : nullptr, reprice ? &npc_distributions.at(i) : nullptr, time_bounded ? &search_complete : nullptr, weather_years > 1 ? &weather_years : nullptr, output_sensitivities ? &sensitivities : nullptr);
+            if (stream_system) result_stream->on_system(s, systems_json.at(i));
+        };
+
+        const auto simulate_combination = [&](const int i, const bool seed_only) {
+            const std::string stage = stage_hooks != nullptr ? std::string(heat_options_json.at(i / 7)) + "/" + std::string(solar_options_json.at(i % 7)) : std::string();
+            start_stage(stage);
+            simulate_heat_solar_combination(static_cast<HeatOption>(i / 7), static_cast<SolarOption>(i % 7), solar_maximum, tes_range, ground_temp, optimal_specifications.at(i), erh_hourly_temperatures_over_day, hp_hourly_temperatures_over_day, hot_water_temperature, coldest_outside_temperature_of_year, maximum_hourly_erh_demand, maximum_hourly_hp_demand, thermostat_temperature, cumulative_discount_rate, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_solar_declinations, monthly_roof_ratios_south, operation_outside_temperatures, operation_solar_irradiances, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product, representative_days, seed_only);
+            end_stage(stage);
+        };
+
+        // time bounded runs give every combination an incumbent first, then refine them until the deadline
+        search_deadlines.fill(std::chrono::steady_clock::time_point::max());
+        combination_evaluations.fill(0);
+        searches_cut_short.fill(false);
+        #ifndef EM_COMPATIBLE
+        constexpr std::array<int, 21> heat_solar_indices = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20 };
+        #endif
+        if (time_bounded) {
+            if (simulation_options.use_multithreading) {
+                #ifndef EM_COMPATIBLE
+                std::for_each(std::execution::par, heat_solar_indices.begin(), heat_solar_indices.end(), [&](int i) { simulate_combination(i, true); });
+                #endif
+            }
+            else {
+                for (int i = 0; i < 21; ++i) simulate_combination(i, true);
+            }
+            search_deadlines.fill(run_deadline);
+        }
+
         if (simulation_options.use_multithreading) {
             #ifndef EM_COMPATIBLE
-            constexpr std::array<int, 21> heat_solar_indices = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20 };
-            std::for_each(std::execution::par_unseq, heat_solar_indices.begin(), heat_solar_indices.end(), [&](int i) {
-                simulate_heat_solar_combination(static_cast<HeatOption>(i / 7), static_cast<SolarOption>(i % 7), solar_maximum, tes_range, ground_temp, optimal_specifications.at(i), erh_hourly_temperatures_over_day, hp_hourly_temperatures_over_day, hot_water_temperature, coldest_outside_temperature_of_year, maximum_hourly_erh_demand, maximum_hourly_hp_demand, thermostat_temperature, cumulative_discount_rate, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_solar_declinations, monthly_roof_ratios_south, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product);
+            // par, not par_unseq: the body calls the result stream & stage hooks, which may lock or allocate, and nests parallel loops
+            std::for_each(std::execution::par, heat_solar_indices.begin(), heat_solar_indices.end(), [&](int i) {
+                simulate_combination(i, false);
+                finish_heat_solar_combination(i);
                 });
             #endif
         }
         else {
             for (int i = 0; i < 21; ++i) {
-                simulate_heat_solar_combination(static_cast<HeatOption>(i / 7), static_cast<SolarOption>(i % 7), solar_maximum, tes_range, ground_temp, optimal_specifications.at(i), erh_hourly_temperatures_over_day, hp_hourly_temperatures_over_day, hot_water_temperature, coldest_outside_temperature_of_year, maximum_hourly_erh_demand, maximum_hourly_hp_demand, thermostat_temperature, cumulative_discount_rate, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_solar_declinations, monthly_roof_ratios_south, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product);
+                if (time_bounded) {
+                    // an equal share of the time left
+                    const auto now = std::chrono::steady_clock::now();
+                    search_deadlines.at(i) = now + (run_deadline - now) / (21 - i);
+                }
+                simulate_combination(i, false);
+                finish_heat_solar_combination(i);
             }
         }
-        const std::array<std::string, 3> heat_options_json = { "electric-boiler", "air-source-heat-pump", "ground-source-heat-pump" };
-        const std::array<std::string, 7> solar_options_json = { "none", "photovoltaic", "flat-plate", "evacuated-tube", "flat-plate-and-photovoltaic", "evacuated-tube-and-photovoltaic", "photovoltaic-thermal-hybrid" };
-        
+
+        print_optimal_specifications(optimal_specifications, float_print_precision);
+
+        #ifndef EM_COMPATIBLE
+        if (simulation_options.output_optimal_specs) write_optimal_specifications(optimal_specifications, "debug_data/optimal_specs_" + std::to_string(simulation_options.output_file_index) + ".csv");
+        if (simulation_options.output_all_specs) write_all_specs_binary(all_specs_buffers, "debug_data/all_specs_" + std::to_string(simulation_options.output_file_index) + ".bin");
+        if (simulation_options.output_hourly_traces) {
+            std::ofstream hourly_traces_file("debug_data/hourly_traces_" + std::to_string(simulation_options.output_file_index) + ".csv");
+            for (const auto& s : optimal_specifications) {
+                const std::vector<HourlyTrace> hourly_traces = trace_heat_solar_specification(s, ground_temp, erh_hourly_temperatures_over_day, hp_hourly_temperatures_over_day, hot_water_temperature, coldest_outside_temperature_of_year, maximum_hourly_erh_demand, maximum_hourly_hp_demand, thermostat_temperature, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_roof_ratios_south, operation_outside_temperatures, operation_solar_irradiances, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product);
+                write_hourly_traces(s, hourly_traces, hourly_traces_file);
+            }
+        }
+        #endif
+
+        const std::array<FixedCostSystem, 8> fixed_cost_systems = calculate_hydrogen_gas_biomass_systems(yearly_erh_demand, yearly_hp_demand, epc_space_heating, cumulative_discount_rate, npc_years, grid_emissions);
+        if (simulation_options.result != nullptr) *simulation_options.result = { household_demand, optimal_specifications, fixed_cost_systems };
+
+        const bool stream_fixed_cost_systems = result_stream != nullptr && result_stream->on_fixed_cost_systems;
+        if (!output_json && !stream_fixed_cost_systems) return std::string();
+        const std::string json_systems = fixed_cost_systems_to_json(fixed_cost_systems);
+        if (stream_fixed_cost_systems) result_stream->on_fixed_cost_systems("{" + json_systems + "}");
+        if (!output_json) return std::string();
+
+        const size_t search_complete_systems = static_cast<size_t>(std::count(searches_cut_short.begin(), searches_cut_short.end(), false));
+        //std::cout << ss.str() << "\n";
+        // output_to_javascript(optimal_specifications);
+        return assemble_result_json(demand_json, systems_json, time_bounded ? &search_complete_systems : nullptr, json_systems);
+    }
+
+    std::string household_demand_to_json(const HouseholdDemand& demand) {
+        std::stringstream ss;
+        // {"boiler":{"hot-water":2309,"space":872,"total":3109,"peak-hourly":178},"heat-pump":{"hot-water":2309,"space":872,"total":3109,"peak-hourly":178}}
+        ss << "{\"boiler\":" << "{\"hot-water\":" << demand.erh.hot_water << ",\"space\":" << demand.erh.space << ",\"total\":" << demand.erh.total << ",\"peak-hourly\":" << demand.erh.max_hourly << "},";
+        ss << "\"heat-pump\":" << "{\"hot-water\":" << demand.hp.hot_water << ",\"space\":" << demand.hp.space << ",\"total\":" << demand.hp.total << ",\"peak-hourly\":" << demand.hp.max_hourly << "}}";
+        return ss.str();
+    }
+
+    std::string assemble_result_json(const std::string& demand_json, const std::array<std::string, 21>& systems_json, const size_t* search_complete_systems, const std::string& fixed_cost_systems_json) {
+        std::stringstream ss;
+        ss << "{\"demand\":" << demand_json << ",";
+        ss << "\"systems\":{";
         for (int i = 0; i < 21; ++i) {
             if (i % 7 == 0) {
                 if (i / 7 > 0) {
@@ -184,29 +432,63 @@ namespace heatninja {
                 }
                 ss << "\"" << heat_options_json.at(i / 7) << "\":{";
             }
-            const auto& s = optimal_specifications.at(i);
-            ss << "\"" << solar_options_json.at(i % 7) << "\":{\"pv-size\":" << s.pv_size << ",\"solar-thermal-size\":" << s.solar_thermal_size << ",\"thermal-energy-storage-volume\":" << s.tes_volume << ",\"operational-expenditure\":" << s.operational_expenditure << ",\"capital-expenditure\":" << s.capital_expenditure << ",\"net-present-cost\":" << s.net_present_cost << ",\"operational-emissions\":" << s.operation_emissions << "}";
+            ss << "\"" << solar_options_json.at(i % 7) << "\":" << systems_json.at(i);
             if (i % 7 < 6) {
                 ss << ",";
             }
         }
-        ss << "},";
-
-        print_optimal_specifications(optimal_specifications, float_print_precision);
+        ss << "}," << fixed_cost_systems_json << "}";
+        if (search_complete_systems != nullptr) {
+            ss << ",\"search-complete-systems\":" << *search_complete_systems;
+        }
+        ss << "}";
+        return ss.str();
+    }
 
-        #ifndef EM_COMPATIBLE
-        if (simulation_options.output_optimal_specs) write_optimal_specifications(optimal_specifications, "debug_data/optimal_specs_" + std::to_string(simulation_options.output_file_index) + ".csv");
-        #endif
+    std::string simulation_result_to_json(const SimulationResult& result) {
+        std::array<std::string, 21> systems_json;
+        for (size_t i = 0; i < 21; ++i) {
+            systems_json.at(i) = heat_solar_system_to_json(result.systems.at(i), nullptr, nullptr, nullptr, nullptr, nullptr);
+        }
+        return assemble_result_json(household_demand_to_json(result.demand), systems_json, nullptr, fixed_cost_systems_to_json(result.fixed_cost_systems));
+    }
 
-        std::string json_systems = calculate_hydrogen_gas_biomass_systems(yearly_erh_demand, yearly_hp_demand, epc_space_heating, cumulative_discount_rate, npc_years, grid_emissions);
+    std::string heat_solar_system_to_json(const HeatSolarSystemSpecifications& spec, const std::vector<HeatSolarSystemSpecifications>* pareto_frontier, const NpcDistribution* npc_distribution, const bool* search_complete, const size_t* weather_years, const SpecificationSensitivities* sensitivities) {
+        std::stringstream ss;
+        ss << "{\"pv-size\":" << spec.pv_size << ",\"solar-thermal-size\":" << spec.solar_thermal_size << ",\"thermal-energy-storage-volume\":" << spec.tes_volume << ",\"operational-expenditure\":" << spec.operational_expenditure << ",\"capital-expenditure\":" << spec.capital_expenditure << ",\"net-present-cost\":" << spec.net_present_cost << ",\"operational-emissions\":" << spec.operation_emissions;
+        if (pareto_frontier != nullptr) {
+            ss << ",\"pareto-frontier\":" << pareto_frontier_to_json(*pareto_frontier);
+        }
+        if (npc_distribution != nullptr) {
+            ss << ",\"net-present-cost-distribution\":{\"p5\":" << npc_distribution->p5 << ",\"p50\":" << npc_distribution->p50 << ",\"p95\":" << npc_distribution->p95 << ",\"mean\":" << npc_distribution->mean << "}";
+        }
+        if (search_complete != nullptr) {
+            ss << ",\"search-complete\":" << (*search_complete ? "true" : "false");
+        }
+        if (weather_years != nullptr) {
+            // net-present-cost is the mean over the years
+            ss << ",\"weather-ensemble\":{\"years\":" << *weather_years << ",\"worst-net-present-cost\":" << spec.worst_net_present_cost << "}";
+        }
+        if (sensitivities != nullptr) {
+            ss << ",\"sensitivities\":" << specification_sensitivities_to_json(*sensitivities);
+        }
+        ss << "}";
+        return ss.str();
+    }
 
-        ss << json_systems << "}}";
-        //std::cout << ss.str() << "\n";
-        // output_to_javascript(optimal_specifications);
+    std::string specification_sensitivities_to_json(const SpecificationSensitivities& sensitivities) {
+        // per input, the derivative of each output
+        std::stringstream ss;
+        ss << '{';
+        for (size_t input = 0; input < sensitivity_input_count; ++input) {
+            if (input != 0) ss << ',';
+            ss << '"' << sensitivity_inputs_json.at(input) << "\":{\"net-present-cost\":" << sensitivities.net_present_cost.derivatives.at(input) << ",\"operational-expenditure\":" << sensitivities.operational_expenditure.derivatives.at(input) << ",\"capital-expenditure\":" << sensitivities.capital_expenditure.derivatives.at(input) << ",\"operational-emissions\":" << sensitivities.operation_emissions.derivatives.at(input) << '}';
+        }
+        ss << '}';
         return ss.str();
     }
 
-    std::string calculate_hydrogen_gas_biomass_systems(const float yearly_erh_demand, const float yearly_hp_demand, const int epc_space_heating, const float cumulative_discount_rate, const int npc_years, const int grid_emissions) {
+    std::array<FixedCostSystem, 8> calculate_hydrogen_gas_biomass_systems(const float yearly_erh_demand, const float yearly_hp_demand, const int epc_space_heating, const float cumulative_discount_rate, const int npc_years, const int grid_emissions) {
         const float yearly_boiler_demand = yearly_erh_demand / 0.9f;
         const float yearly_fuel_cell_demand = yearly_hp_demand / 0.94f;
         
@@ -240,7 +522,7 @@ namespace heatninja {
         const float green_hydrogen_fuel_cell_opex = yearly_fuel_cell_demand * green_hydrogen_cost; // Equivalent 94 % total efficiency
         // https://www.sciencedirect.com/science/article/pii/S0360319914031383#bib14
         // With all electrical energy used via direct electrical heater, comparable to electricity bill reductions method
-        const float hydrogen_fuel_cell_capex = (12000 + 2068.3f * std::powf(0.1f, 0.553f)) * npc_years / 10; // 12000 fuel cell + min TES size, CAPEX of 10 yr life adjusted for npc_years
+        const float hydrogen_fuel_cell_capex = (12000 + 2068.3f * std::pow(0.1f, 0.553f)) * npc_years / 10; // 12000 fuel cell + min TES size, CAPEX of 10 yr life adjusted for npc_years
         // https://www.sciencedirect.com/science/article/pii/S0360319914031383#bib14 lowest cost
         const float grey_hydrogen_fuel_cell_npc = hydrogen_fuel_cell_capex + cumulative_discount_rate * grey_hydrogen_fuel_cell_opex;
         const float blue_hydrogen_fuel_cell_npc = hydrogen_fuel_cell_capex + cumulative_discount_rate * blue_hydrogen_fuel_cell_opex;
@@ -276,23 +558,40 @@ namespace heatninja {
 
         const float biomass_boiler_emissions = yearly_boiler_demand * biomass_boiler_emissions_per_khw; // 90gCO2 / kWh middle value from parliament post
 
+        return { {
+            { grey_hydrogen_boiler_opex, hydrogen_boiler_capex, grey_hydrogen_boiler_npc, grey_hydrogen_boiler_emissions },
+            { blue_hydrogen_boiler_opex, hydrogen_boiler_capex, blue_hydrogen_boiler_npc, blue_hydrogen_boiler_emissions },
+            { green_hydrogen_boiler_opex, hydrogen_boiler_capex, green_hydrogen_boiler_npc, green_hydrogen_boiler_emissions },
+            { grey_hydrogen_fuel_cell_opex, hydrogen_fuel_cell_capex, grey_hydrogen_fuel_cell_npc, grey_hydrogen_fuel_cell_emissions },
+            { blue_hydrogen_fuel_cell_opex, hydrogen_fuel_cell_capex, blue_hydrogen_fuel_cell_npc, blue_hydrogen_fuel_cell_emissions },
+            { green_hydrogen_fuel_cell_opex, hydrogen_fuel_cell_capex, green_hydrogen_fuel_cell_npc, green_hydrogen_fuel_cell_emissions },
+            { gas_boiler_opex, gas_boiler_capex, gas_boiler_npc, gas_boiler_emissions },
+            { biomass_boiler_opex, biomass_boiler_capex, biomass_boiler_npc, biomass_boiler_emissions }
+        } };
+    }
+
+    std::string fixed_cost_systems_to_json(const std::array<FixedCostSystem, 8>& fixed_cost_systems) {
         // format OPEX, CAPEX & NPC for hydrogen, gas & biomass boilers, and hydrogen fuel cells
+        // {"operational-expenditure":232,"capital-expenditure":679,"net-present-cost":4093,"operational-emissions":214}
+        const auto system_json = [&fixed_cost_systems](const size_t i) {
+            const FixedCostSystem& f = fixed_cost_systems.at(i);
+            std::stringstream ss;
+            ss << "{\"operational-expenditure\":" << f.operational_expenditure << ",\"capital-expenditure\":" << f.capital_expenditure << ",\"net-present-cost\":" << f.net_present_cost << ",\"operational-emissions\":" << f.operation_emissions << "}";
+            return ss.str();
+        };
         std::stringstream ss;
         ss << "\"hydrogen-boiler\":{";
-        ss << "\"grey\":" << "{\"operational-expenditure\":" << grey_hydrogen_boiler_opex << ",\"capital-expenditure\":" << hydrogen_boiler_capex << ",\"net-present-cost\":" << grey_hydrogen_boiler_npc << ",\"operational-emissions\":" << grey_hydrogen_boiler_emissions << "},";
-        ss << "\"blue\":" << "{\"operational-expenditure\":" << blue_hydrogen_boiler_opex << ",\"capital-expenditure\":" << hydrogen_boiler_capex << ",\"net-present-cost\":" << blue_hydrogen_boiler_npc << ",\"operational-emissions\":" << blue_hydrogen_boiler_emissions << "},";
-        ss << "\"green\":" << "{\"operational-expenditure\":" << green_hydrogen_boiler_opex << ",\"capital-expenditure\":" << hydrogen_boiler_capex << ",\"net-present-cost\":" << green_hydrogen_boiler_npc << ",\"operational-emissions\":" << green_hydrogen_boiler_emissions << "}},";
+        ss << "\"grey\":" << system_json(0) << ",";
+        ss << "\"blue\":" << system_json(1) << ",";
+        ss << "\"green\":" << system_json(2) << "},";
 
         ss << "\"hydrogen-fuel-cell\":{";
-        ss << "\"grey\":" << "{\"operational-expenditure\":" << grey_hydrogen_fuel_cell_opex << ",\"capital-expenditure\":" << hydrogen_fuel_cell_capex << ",\"net-present-cost\":" << grey_hydrogen_fuel_cell_npc << ",\"operational-emissions\":" << grey_hydrogen_fuel_cell_emissions << "},";
-        ss << "\"blue\":" << "{\"operational-expenditure\":" << blue_hydrogen_fuel_cell_opex << ",\"capital-expenditure\":" << hydrogen_fuel_cell_capex << ",\"net-present-cost\":" << blue_hydrogen_fuel_cell_npc << ",\"operational-emissions\":" << blue_hydrogen_fuel_cell_emissions << "},";
-        ss << "\"green\":" << "{\"operational-expenditure\":" << green_hydrogen_fuel_cell_opex << ",\"capital-expenditure\":" << hydrogen_fuel_cell_capex << ",\"net-present-cost\":" << green_hydrogen_fuel_cell_npc << ",\"operational-emissions\":" << green_hydrogen_fuel_cell_emissions << "}},";
+        ss << "\"grey\":" << system_json(3) << ",";
+        ss << "\"blue\":" << system_json(4) << ",";
+        ss << "\"green\":" << system_json(5) << "},";
 
-        ss << "\"gas-boiler\":" << "{\"operational-expenditure\":" << gas_boiler_opex << ",\"capital-expenditure\":" << gas_boiler_capex << ",\"net-present-cost\":" << gas_boiler_npc << ",\"operational-emissions\":" << gas_boiler_emissions << "},";
-        ss << "\"biomass-boiler\":" << "{\"operational-expenditure\":" << biomass_boiler_opex << ",\"capital-expenditure\":" << biomass_boiler_capex << ",\"net-present-cost\":" << biomass_boiler_npc << ",\"operational-emissions\":" << biomass_boiler_emissions << "}";
-
-        // {"operational-expenditure":232,"capital-expenditure":679,"net-present-cost":4093,"operational-emissions":214}
-        //std::cout << ss.str() << "\n";
+        ss << "\"gas-boiler\":" << system_json(6) << ",";
+        ss << "\"biomass-boiler\":" << system_json(7);
         return ss.str();
     }
 
@@ -315,53 +614,164 @@ namespace heatninja {
     std::vector<float> import_per_hour_of_year_data(const std::string& filename) {
         std::ifstream infile(filename);
         std::vector<float> data;
-        data.reserve(8760);
-        int i = 0;
-        while (i < 8760)
+        data.reserve(hours_per_year);
+        std::string line;
+        while (std::getline(infile, line))
         {
-            std::string line;
-            std::getline(infile, line);
             std::stringstream ss(line);
             float x;
             while (ss >> x) {
                 data.push_back(x);
             }
-            ++i;
         }
         //fmt::print("\n");
         infile.close();
+        if (!data.empty() && data.size() != hours_per_year && data.size() != 2 * hours_per_year) {
+            throw std::runtime_error("expected 8760 hourly or 17520 half hourly values in " + filename + ", found " + std::to_string(data.size()));
+        }
         return data;
     }
 
-    std::array<float, 24> calculate_erh_hourly_temperature_profile(const float t) {
-        const float t2 = t - 2;
+    std::vector<float> resample_series(std::vector<float> series, const size_t steps_per_hour) {
+        if (steps_per_hour != 1 && steps_per_hour != 2) {
+            throw std::invalid_argument("steps_per_hour must be 1 or 2");
+        }
+        if (series.empty() || series.size() == hours_per_year * steps_per_hour) return series;
+        if (series.size() != hours_per_year && series.size() != 2 * hours_per_year) {
+            throw std::invalid_argument("expected an hourly or half hourly series, found " + std::to_string(series.size()) + " values");
+        }
+        std::vector<float> resampled(hours_per_year * steps_per_hour);
+        if (steps_per_hour == 2) {
+            for (size_t hour = 0; hour < hours_per_year; ++hour) resampled[hour * 2] = resampled[hour * 2 + 1] = series[hour];
+        }
+        else {
+            for (size_t hour = 0; hour < hours_per_year; ++hour) resampled[hour] = (series[hour * 2] + series[hour * 2 + 1]) / 2;
+        }
+        return resampled;
+    }
+
+    void quantise_series(const std::vector<float>& series, std::vector<int16_t>& quantised, QuantisedSeries& quantised_series) {
+        const auto [min_value, max_value] = std::minmax_element(series.begin(), series.end());
+        quantised_series.offset = *min_value;
+        quantised_series.scale = *max_value > *min_value ? (*max_value - *min_value) / 65535.0f : 1.0f;
+        for (const float value : series) {
+            const long q = std::lround((value - quantised_series.offset) / quantised_series.scale);
+            quantised.push_back(static_cast<int16_t>(std::clamp(q, 0L, 65535L) - 32768));
+        }
+    }
+
+    WeatherStore load_weather_store(const std::string& assets_directory, const std::vector<std::string>& year_directories) {
+        WeatherStore weather_store;
+        const std::vector<std::string> year_paths = year_directories.empty() ? std::vector<std::string>{ assets_directory } : [&] {
+            std::vector<std::string> paths;
+            for (const std::string& year_directory : year_directories) paths.push_back(assets_directory + "/" + year_directory);
+            return paths;
+        }();
+        weather_store.years = year_paths.size();
+        weather_store.outside_temperatures.reserve(grid_cell_assets.size() * weather_store.years * 8760);
+        weather_store.solar_irradiances.reserve(grid_cell_assets.size() * weather_store.years * 8760);
+        for (const GridCellAsset& asset : grid_cell_assets) {
+            const std::string cell_name = "/lat_" + float_to_string(static_cast<float>(asset.latitude_step) / 2, 1) + "_lon_" + float_to_string(static_cast<float>(asset.longitude_step) / 2, 1) + ".csv";
+            for (const std::string& year_path : year_paths) {
+                const std::vector<float> outside_temperatures = resample_series(import_per_hour_of_year_data(year_path + "/outside_temps" + cell_name), 1);
+                const std::vector<float> solar_irradiances = resample_series(import_per_hour_of_year_data(year_path + "/solar_irradiances" + cell_name), 1);
+                if (outside_temperatures.size() != 8760 || solar_irradiances.size() != 8760) {
+                    throw std::runtime_error("expected 8760 hours of weather data for " + year_path + cell_name);
+                }
+                quantise_series(outside_temperatures, weather_store.outside_temperatures, weather_store.outside_temperature_scales.emplace_back());
+                quantise_series(solar_irradiances, weather_store.solar_irradiances, weather_store.solar_irradiance_scales.emplace_back());
+            }
+        }
+        weather_store.agile_tariff_per_hour_over_year = import_per_hour_of_year_data(assets_directory + "/agile_tariff.csv");
+        return weather_store;
+    }
+
+    void add_synthetic_weather_years(WeatherStore& weather_store, const size_t synthetic_years, const unsigned int seed) {
+        // a seasonal day bootstrap, each synthetic day is a whole stored day so its temperatures & irradiances stay consistent
+        constexpr int days = 365;
+        constexpr int window_days = 7;
+        const size_t stored_years = weather_store.years;
+        std::mt19937 generator(seed);
+        std::uniform_int_distribution<int> day_offset(-window_days, window_days);
+        std::uniform_int_distribution<size_t> stored_year(0, stored_years - 1);
+        std::vector<std::array<size_t, days>> source_days(synthetic_years); // stored year * days + day, shared by every cell
+        for (auto& synthetic_source_days : source_days) {
+            for (int day = 0; day < days; ++day) {
+                const int source_day = std::clamp(day + day_offset(generator), 0, days - 1);
+                synthetic_source_days.at(day) = stored_year(generator) * days + static_cast<size_t>(source_day);
+            }
+        }
+
+        WeatherStore extended;
+        extended.years = stored_years + synthetic_years;
+        extended.agile_tariff_per_hour_over_year = std::move(weather_store.agile_tariff_per_hour_over_year);
+        const size_t cells = weather_store.outside_temperature_scales.size() / stored_years;
+        extended.outside_temperatures.reserve(cells * extended.years * 8760);
+        extended.solar_irradiances.reserve(cells * extended.years * 8760);
+        std::vector<float> stored_outside_temperatures, stored_solar_irradiances, decoded, synthetic_outside_temperatures(8760), synthetic_solar_irradiances(8760);
+        for (size_t cell = 0; cell < cells; ++cell) {
+            stored_outside_temperatures.clear();
+            stored_solar_irradiances.clear();
+            for (size_t year = 0; year < stored_years; ++year) {
+                const size_t series = cell * stored_years + year;
+                decode_weather_series(weather_store.outside_temperatures, weather_store.outside_temperature_scales.at(series), series, decoded);
+                stored_outside_temperatures.insert(stored_outside_temperatures.end(), decoded.begin(), decoded.end());
+                extended.outside_temperatures.insert(extended.outside_temperatures.end(), weather_store.outside_temperatures.begin() + series * 8760, weather_store.outside_temperatures.begin() + (series + 1) * 8760);
+                extended.outside_temperature_scales.push_back(weather_store.outside_temperature_scales.at(series));
+                decode_weather_series(weather_store.solar_irradiances, weather_store.solar_irradiance_scales.at(series), series, decoded);
+                stored_solar_irradiances.insert(stored_solar_irradiances.end(), decoded.begin(), decoded.end());
+                extended.solar_irradiances.insert(extended.solar_irradiances.end(), weather_store.solar_irradiances.begin() + series * 8760, weather_store.solar_irradiances.begin() + (series + 1) * 8760);
+                extended.solar_irradiance_scales.push_back(weather_store.solar_irradiance_scales.at(series));
+            }
+            for (const auto& synthetic_source_days : source_days) {
+                for (size_t day = 0; day < days; ++day) {
+                    const size_t source_hour = synthetic_source_days.at(day) * 24;
+                    std::copy_n(stored_outside_temperatures.begin() + source_hour, 24, synthetic_outside_temperatures.begin() + day * 24);
+                    std::copy_n(stored_solar_irradiances.begin() + source_hour, 24, synthetic_solar_irradiances.begin() + day * 24);
+                }
+                quantise_series(synthetic_outside_temperatures, extended.outside_temperatures, extended.outside_temperature_scales.emplace_back());
+                quantise_series(synthetic_solar_irradiances, extended.solar_irradiances, extended.solar_irradiance_scales.emplace_back());
+            }
+        }
+        weather_store = std::move(extended);
+    }
+
+    void decode_weather_series(const std::vector<int16_t>& quantised, const QuantisedSeries& quantised_series, const size_t series_index, std::vector<float>& hourly_data) {
+        hourly_data.resize(8760);
+        const int16_t* q = quantised.data() + series_index * 8760;
+        const float offset = quantised_series.offset;
+        const float scale = quantised_series.scale;
+        for (size_t hour = 0; hour < 8760; ++hour) {
+            hourly_data[hour] = offset + scale * static_cast<float>(q[hour] + 32768);
+        }
+    }
+
+    template <typename Scalar>
+    std::array<Scalar, 24> calculate_erh_hourly_temperature_profile(const Scalar t) {
+        const Scalar t2 = t - 2;
         return { t2, t2, t2, t2, t2, t2, t2, t, t, t, t, t, t, t, t, t, t, t, t, t, t, t, t2, t2 };
     }
 
-    std::array<float, 24> calculate_hp_hourly_temperature_profile(const float t) {
+    template <typename Scalar>
+    std::array<Scalar, 24> calculate_hp_hourly_temperature_profile(const Scalar t) {
         return { t, t, t, t, t, t, t, t, t, t, t, t, t, t, t, t, t, t, t, t, t, t, t, t };
     }
 
     std::array<float, 12> calculate_monthly_cold_water_temperatures(const float latitude) {
-        if (latitude < 52.2f) { // South of England
-            return { 12.1f, 11.4f, 12.3f, 15.2f, 16.1f, 19.3f, 21.2f, 20.1f, 19.5f, 16.8f, 13.7f, 12.4f };
-        }
-        else if (latitude < 53.3f) { // Middle of England and Wales
-            return { 12.9f, 13.3f, 14.4f, 16.3f, 17.7f, 19.7f, 21.8f, 20.1f, 20.3f, 17.8f, 15.3f, 14.0f };
-        }
-        else if (latitude < 54.95f) { // North of England and Northern Ireland
-            return { 9.6f, 9.3f, 10.7f, 13.7f, 15.3f, 17.3f, 19.3f, 18.6f, 17.9f, 15.5f, 12.3f, 10.5f };
-        }
-        else { // Scotland
-            return { 9.6f, 9.2f, 9.8f, 13.2f, 14.5f, 16.8f, 19.4f, 18.5f, 17.5f, 15.1f, 13.7f, 12.4f };
-        }
+        constexpr std::array<std::array<float, 12>, 4> monthly_cold_water_temperatures_per_band = { {
+            { 12.1f, 11.4f, 12.3f, 15.2f, 16.1f, 19.3f, 21.2f, 20.1f, 19.5f, 16.8f, 13.7f, 12.4f }, // South of England
+            { 12.9f, 13.3f, 14.4f, 16.3f, 17.7f, 19.7f, 21.8f, 20.1f, 20.3f, 17.8f, 15.3f, 14.0f }, // Middle of England and Wales
+            { 9.6f, 9.3f, 10.7f, 13.7f, 15.3f, 17.3f, 19.3f, 18.6f, 17.9f, 15.5f, 12.3f, 10.5f }, // North of England and Northern Ireland
+            { 9.6f, 9.2f, 9.8f, 13.2f, 14.5f, 16.8f, 19.4f, 18.5f, 17.5f, 15.1f, 13.7f, 12.4f } // Scotland
+        } };
+        return monthly_cold_water_temperatures_per_band.at(calculate_cold_water_band(latitude));
     }
 
     std::array<float, 12> calculate_monthly_solar_height_factors(const float latitude, const std::array<float, 12>& monthly_solar_declination) {
         std::array<float, 12> solar_height_factors = {};
         size_t i = 0;
         for (float solar_declination : monthly_solar_declination) {
-            solar_height_factors.at(i) = std::cosf((PI / 180.0f) * (latitude - solar_declination));
+            solar_height_factors.at(i) = std::cos((PI / 180.0f) * (latitude - solar_declination));
             ++i;
         }
         return solar_height_factors;
@@ -440,17 +850,19 @@ namespace heatninja {
         return showers_vol + bath_vol + other_vol;
     }
 
-    float calculate_solar_gain_house_factor(const float house_size) {
+    template <typename Scalar>
+    Scalar calculate_solar_gain_house_factor(const Scalar house_size) {
         return (house_size * 0.15f / 2) * 0.77f * 0.7f * 0.76f * 0.9f / 1000;
     }
 
     float calculate_epc_body_gain(const float house_size) {
         const float epc_num_occupants = 1 + 1.76f * (1 - std::exp(-0.000349f *
-            std::powf((house_size - 13.9f), 2))) + 0.0013f * (house_size - 13.9f);
+            std::pow((house_size - 13.9f), 2))) + 0.0013f * (house_size - 13.9f);
         return (epc_num_occupants * 60) / 1000;
     }
 
-    float calculate_heat_capacity(const float house_size) {
+    template <typename Scalar>
+    Scalar calculate_heat_capacity(const Scalar house_size) {
         return (250 * house_size) / 3600;
     }
 
@@ -459,44 +871,90 @@ namespace heatninja {
     }
 
     struct PostcodeRegion {
-        std::string postcode;
+        std::string_view postcode;
         int mininum;
         int maximum;
         int region;
     };
 
-    int calculate_region_identifier(const std::string& postcode) {
-        // regioncodes from https://www.bre.co.uk/filelibrary/SAP/2012/SAP-2012_9-92.pdf p177
-        const std::array<PostcodeRegion, 169> regioncodes = { { { "ZE", 0, 0, 20 }, { "YO25", 0, 0, 11 }, { "YO", 15, 16, 11 }, { "YO", 0, 0, 10 }, { "WV", 0, 0, 6 }, { "WS", 0, 0, 6 }, { "WR", 0, 0, 6 }, { "WN", 0, 0, 7 }, { "WF", 0, 0, 11 }, { "WD", 0, 0, 1 }, { "WC", 0, 0, 1 }, { "WA", 0, 0, 7 }, { "W", 0, 0, 1 }, { "UB", 0, 0, 1 }, { "TW", 0, 0, 1 }, { "TS", 0, 0, 10 }, { "TR", 0, 0, 4 }, { "TQ", 0, 0, 4 }, { "TN", 0, 0, 2 }, { "TF", 0, 0, 6 }, { "TD15", 0, 0, 9 }, { "TD12", 0, 0, 9 }, { "TD", 0, 0, 9 }, { "TA", 0, 0, 5 }, { "SY", 15, 25, 13 }, { "SY14", 0, 0, 7 }, { "SY", 0, 0, 6 }, { "SW", 0, 0, 1 }, { "ST", 0, 0, 6 }, { "SS", 0, 0, 12 }, { "SR", 7, 8, 10 }, { "SR", 0, 0, 9 }, { "SP", 6, 11, 3 }, { "SP", 0, 0, 5 }, { "SO", 0, 0, 3 }, { "SN7", 0, 0, 1 }, { "SN", 0, 0, 5 }, { "SM", 0, 0, 1 }, { "SL", 0, 0, 1 }, { "SK", 22, 23, 6 }, { "SK17", 0, 0, 6 }, { "SK13", 0, 0, 6 }, { "SK", 0, 0, 7 }, { "SG", 0, 0, 1 }, { "SE", 0, 0, 1 }, { "SA", 61, 73, 13 }, { "SA", 31, 48, 13 }, { "SA", 14, 20, 13 }, { "SA", 0, 0, 5 }, { "S", 40, 45, 6 }, { "S", 32, 33, 6 }, { "S18", 0, 0, 6 }, { "S", 0, 0, 11 }, { "RM", 0, 0, 12 }, { "RH", 10, 20, 2 }, { "RH", 0, 0, 1 }, { "RG", 21, 29, 3 }, { "RG", 0, 0, 1 }, { "PR", 0, 0, 7 }, { "PO", 18, 22, 2 }, { "PO", 0, 0, 3 }, { "PL", 0, 0, 4 }, { "PH50", 0, 0, 14 }, { "PH49", 0, 0, 14 }, { "PH", 30, 44, 17 }, { "PH26", 0, 0, 16 }, { "PH", 19, 25, 17 }, { "PH", 0, 0, 15 }, { "PE", 20, 25, 11 }, { "PE", 9, 12, 11 }, { "PE", 0, 0, 12 }, { "PA", 0, 0, 14 }, { "OX", 0, 0, 1 }, { "OL", 0, 0, 7 }, { "NW", 0, 0, 1 }, { "NR", 0, 0, 12 }, { "NP8", 0, 0, 13 }, { "NP", 0, 0, 5 }, { "NN", 0, 0, 6 }, { "NG", 0, 0, 11 }, { "NE", 0, 0, 9 }, { "N", 0, 0, 1 }, { "ML", 0, 0, 14 }, { "MK", 0, 0, 1 }, { "ME", 0, 0, 2 }, { "M", 0, 0, 7 }, { "LU", 0, 0, 1 }, { "LS24", 0, 0, 10 }, { "LS", 0, 0, 11 }, { "LN", 0, 0, 11 }, { "LL", 30, 78, 13 }, { "LL", 23, 27, 13 }, { "LL", 0, 0, 7 }, { "LE", 0, 0, 6 }, { "LD", 0, 0, 13 }, { "LA", 7, 23, 8 }, { "LA", 0, 0, 7 }, { "L", 0, 0, 7 }, { "KY", 0, 0, 15 }, { "KW", 15, 17, 19 }, { "KW", 0, 0, 17 }, { "KT", 0, 0, 1 }, { "KA", 0, 0, 14 }, { "IV36", 0, 0, 16 }, { "IV", 30, 32, 16 }, { "IV", 0, 0, 17 }, { "IP", 0, 0, 12 }, { "IG", 0, 0, 12 }, { "HX", 0, 0, 11 }, { "HU", 0, 0, 11 }, { "HS", 0, 0, 18 }, { "HR", 0, 0, 6 }, { "HP", 0, 0, 1 }, { "HG", 0, 0, 10 }, { "HD", 0, 0, 11 }, { "HA", 0, 0, 1 }, { "GU", 51, 52, 3 }, { "GU46", 0, 0, 3 }, { "GU", 30, 35, 3 }, { "GU", 28, 29, 2 }, { "GU14", 0, 0, 3 }, { "GU", 11, 12, 3 }, { "GU", 0, 0, 1 }, { "GL", 0, 0, 5 }, { "G", 0, 0, 14 }, { "FY", 0, 0, 7 }, { "FK", 0, 0, 14 }, { "EX", 0, 0, 4 }, { "EN9", 0, 0, 12 }, { "EN", 0, 0, 1 }, { "EH", 43, 46, 9 }, { "EH", 0, 0, 15 }, { "EC", 0, 0, 1 }, { "E", 0, 0, 1 }, { "DY", 0, 0, 6 }, { "DT", 0, 0, 3 }, { "DN", 0, 0, 11 }, { "DL", 0, 0, 10 }, { "DH", 4, 5, 9 }, { "DH", 0, 0, 10 }, { "DG", 0, 0, 8 }, { "DE", 0, 0, 6 }, { "DD", 0, 0, 15 }, { "DA", 0, 0, 2 }, { "CW", 0, 0, 7 }, { "CV", 0, 0, 6 }, { "CT", 0, 0, 2 }, { "CR", 0, 0, 1 }, { "CO", 0, 0, 12 }, { "CM", 21, 23, 1 }, { "CM", 0, 0, 12 }, { "CH", 5, 8, 7 }, { "CH", 0, 0, 7 }, { "CF", 0, 0, 5 }, { "CB", 0, 0, 12 }, { "CA", 0, 0, 8 }, { "BT", 0, 0, 21 }, { "BS", 0, 0, 5 }, { "BR", 0, 0, 2 }, { "BN", 0, 0, 2 }, { "BL", 0, 0, 7 }, { "BH", 0, 0, 3 }, { "BD", 23, 24, 10 }, { "BD", 0, 0, 11 }, { "BB", 0, 0, 7 }, { "BA", 0, 0, 5 }, { "B", 0, 0, 6 }, { "AL", 0, 0, 1 }, { "AB", 0, 0, 16 } } };
+    // regioncodes from https://www.bre.co.uk/filelibrary/SAP/2012/SAP-2012_9-92.pdf p177
+    // ordered so the first match wins, longer and ranged outcodes come before the whole area
+    constexpr std::array<PostcodeRegion, 169> regioncodes = { { { "ZE", 0, 0, 20 }, { "YO25", 0, 0, 11 }, { "YO", 15, 16, 11 }, { "YO", 0, 0, 10 }, { "WV", 0, 0, 6 }, { "WS", 0, 0, 6 }, { "WR", 0, 0, 6 }, { "WN", 0, 0, 7 }, { "WF", 0, 0, 11 }, { "WD", 0, 0, 1 }, { "WC", 0, 0, 1 }, { "WA", 0, 0, 7 }, { "W", 0, 0, 1 }, { "UB", 0, 0, 1 }, { "TW", 0, 0, 1 }, { "TS", 0, 0, 10 }, { "TR", 0, 0, 4 }, { "TQ", 0, 0, 4 }, { "TN", 0, 0, 2 }, { "TF", 0, 0, 6 }, { "TD15", 0, 0, 9 }, { "TD12", 0, 0, 9 }, { "TD", 0, 0, 9 }, { "TA", 0, 0, 5 }, { "SY", 15, 25, 13 }, { "SY14", 0, 0, 7 }, { "SY", 0, 0, 6 }, { "SW", 0, 0, 1 }, { "ST", 0, 0, 6 }, { "SS", 0, 0, 12 }, { "SR", 7, 8, 10 }, { "SR", 0, 0, 9 }, { "SP", 6, 11, 3 }, { "SP", 0, 0, 5 }, { "SO", 0, 0, 3 }, { "SN7", 0, 0, 1 }, { "SN", 0, 0, 5 }, { "SM", 0, 0, 1 }, { "SL", 0, 0, 1 }, { "SK", 22, 23, 6 }, { "SK17", 0, 0, 6 }, { "SK13", 0, 0, 6 }, { "SK", 0, 0, 7 }, { "SG", 0, 0, 1 }, { "SE", 0, 0, 1 }, { "SA", 61, 73, 13 }, { "SA", 31, 48, 13 }, { "SA", 14, 20, 13 }, { "SA", 0, 0, 5 }, { "S", 40, 45, 6 }, { "S", 32, 33, 6 }, { "S18", 0, 0, 6 }, { "S", 0, 0, 11 }, { "RM", 0, 0, 12 }, { "RH", 10, 20, 2 }, { "RH", 0, 0, 1 }, { "RG", 21, 29, 3 }, { "RG", 0, 0, 1 }, { "PR", 0, 0, 7 }, { "PO", 18, 22, 2 }, { "PO", 0, 0, 3 }, { "PL", 0, 0, 4 }, { "PH50", 0, 0, 14 }, { "PH49", 0, 0, 14 }, { "PH", 30, 44, 17 }, { "PH26", 0, 0, 16 }, { "PH", 19, 25, 17 }, { "PH", 0, 0, 15 }, { "PE", 20, 25, 11 }, { "PE", 9, 12, 11 }, { "PE", 0, 0, 12 }, { "PA", 0, 0, 14 }, { "OX", 0, 0, 1 }, { "OL", 0, 0, 7 }, { "NW", 0, 0, 1 }, { "NR", 0, 0, 12 }, { "NP8", 0, 0, 13 }, { "NP", 0, 0, 5 }, { "NN", 0, 0, 6 }, { "NG", 0, 0, 11 }, { "NE", 0, 0, 9 }, { "N", 0, 0, 1 }, { "ML", 0, 0, 14 }, { "MK", 0, 0, 1 }, { "ME", 0, 0, 2 }, { "M", 0, 0, 7 }, { "LU", 0, 0, 1 }, { "LS24", 0, 0, 10 }, { "LS", 0, 0, 11 }, { "LN", 0, 0, 11 }, { "LL", 30, 78, 13 }, { "LL", 23, 27, 13 }, { "LL", 0, 0, 7 }, { "LE", 0, 0, 6 }, { "LD", 0, 0, 13 }, { "LA", 7, 23, 8 }, { "LA", 0, 0, 7 }, { "L", 0, 0, 7 }, { "KY", 0, 0, 15 }, { "KW", 15, 17, 19 }, { "KW", 0, 0, 17 }, { "KT", 0, 0, 1 }, { "KA", 0, 0, 14 }, { "IV36", 0, 0, 16 }, { "IV", 30, 32, 16 }, { "IV", 0, 0, 17 }, { "IP", 0, 0, 12 }, { "IG", 0, 0, 12 }, { "HX", 0, 0, 11 }, { "HU", 0, 0, 11 }, { "HS", 0, 0, 18 }, { "HR", 0, 0, 6 }, { "HP", 0, 0, 1 }, { "HG", 0, 0, 10 }, { "HD", 0, 0, 11 }, { "HA", 0, 0, 1 }, { "GU", 51, 52, 3 }, { "GU46", 0, 0, 3 }, { "GU", 30, 35, 3 }, { "GU", 28, 29, 2 }, { "GU14", 0, 0, 3 }, { "GU", 11, 12, 3 }, { "GU", 0, 0, 1 }, { "GL", 0, 0, 5 }, { "G", 0, 0, 14 }, { "FY", 0, 0, 7 }, { "FK", 0, 0, 14 }, { "EX", 0, 0, 4 }, { "EN9", 0, 0, 12 }, { "EN", 0, 0, 1 }, { "EH", 43, 46, 9 }, { "EH", 0, 0, 15 }, { "EC", 0, 0, 1 }, { "E", 0, 0, 1 }, { "DY", 0, 0, 6 }, { "DT", 0, 0, 3 }, { "DN", 0, 0, 11 }, { "DL", 0, 0, 10 }, { "DH", 4, 5, 9 }, { "DH", 0, 0, 10 }, { "DG", 0, 0, 8 }, { "DE", 0, 0, 6 }, { "DD", 0, 0, 15 }, { "DA", 0, 0, 2 }, { "CW", 0, 0, 7 }, { "CV", 0, 0, 6 }, { "CT", 0, 0, 2 }, { "CR", 0, 0, 1 }, { "CO", 0, 0, 12 }, { "CM", 21, 23, 1 }, { "CM", 0, 0, 12 }, { "CH", 5, 8, 7 }, { "CH", 0, 0, 7 }, { "CF", 0, 0, 5 }, { "CB", 0, 0, 12 }, { "CA", 0, 0, 8 }, { "BT", 0, 0, 21 }, { "BS", 0, 0, 5 }, { "BR", 0, 0, 2 }, { "BN", 0, 0, 2 }, { "BL", 0, 0, 7 }, { "BH", 0, 0, 3 }, { "BD", 23, 24, 10 }, { "BD", 0, 0, 11 }, { "BB", 0, 0, 7 }, { "BA", 0, 0, 5 }, { "B", 0, 0, 6 }, { "AL", 0, 0, 1 }, { "AB", 0, 0, 16 } } };
+
+    struct PostcodeLetterRange {
+        size_t first, last;
+    };
 
-        // extract the digit from the outcode
-        std::string digits_str = "";
-        for (size_t i = 0; i < postcode.size(); ++i) {
-            if (isdigit(postcode.at(i))) {
-                digits_str += postcode.substr(i, 1);
-                if (digits_str.length() > 1) break;
+    constexpr std::array<PostcodeLetterRange, 26> build_postcode_letter_index() {
+        // regioncodes sharing a first letter are contiguous, so each letter maps to one slice of the table
+        std::array<PostcodeLetterRange, 26> index = {};
+        for (size_t i = 0; i < regioncodes.size(); ++i) {
+            PostcodeLetterRange& range = index.at(static_cast<size_t>(regioncodes.at(i).postcode.front() - 'A'));
+            if (range.first == range.last) {
+                range.first = i;
+            }
+            else if (range.last != i) {
+                throw "regioncodes sharing a first letter must be contiguous";
             }
-            else if (digits_str.length() > 0) {
+            range.last = i + 1;
+        }
+        return index;
+    }
+
+    constexpr std::array<PostcodeLetterRange, 26> postcode_letter_index = build_postcode_letter_index();
+
+    constexpr char to_upper_ascii(const char c) {
+        return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+
+    int calculate_region_identifier(const std::string_view postcode) {
+        // returns -1 for a postcode that is empty, not a UK outcode or has no district digits where the area needs them
+        if (postcode.empty()) return -1;
+        const char first_letter = to_upper_ascii(postcode.front());
+        if (first_letter < 'A' || first_letter > 'Z') return -1;
+
+        // extract the digit from the outcode, -1 if there are none so only whole area regioncodes can match
+        int digits = -1;
+        size_t digit_count = 0;
+        for (const char c : postcode) {
+            if (c >= '0' && c <= '9') {
+                digits = (digit_count == 0 ? 0 : digits * 10) + (c - '0');
+                if (++digit_count > 1) break;
+            }
+            else if (digit_count > 0) {
                 break;
             }
         }
-        int digits = std::stoi(digits_str);
-        //std::cout << digits << '\n';
 
-        const std::array<std::string, 4> sub_postcodes = { postcode.substr(0, 1), postcode.substr(0, 2), postcode.substr(0, 3), postcode.substr(0, 4) };
-        for (auto& regioncode : regioncodes) {
+        const PostcodeLetterRange range = postcode_letter_index.at(static_cast<size_t>(first_letter - 'A'));
+        for (size_t i = range.first; i < range.last; ++i) {
+            const PostcodeRegion& regioncode = regioncodes[i];
             // search for the outcode in the list of regioncodes
-            if (regioncode.postcode == sub_postcodes.at(regioncode.postcode.length() - 1)) {
-                // if the region code has a minimum & maximum, check the postcode lies within that range (inclusively).
-                if (regioncode.maximum == 0 || (digits >= regioncode.mininum && digits <= regioncode.maximum)) {
-                    //std::cout << regioncode.postcode << ' ' << regioncode.mininum << ' ' << regioncode.maximum << ' ' << regioncode.region << ' ' << '\n';
-                    return regioncode.region - 1;
+            if (regioncode.postcode.size() > postcode.size()) continue;
+            bool prefix_matches = true;
+            for (size_t c = 1; c < regioncode.postcode.size(); ++c) {
+                if (to_upper_ascii(postcode[c]) != regioncode.postcode[c]) {
+                    prefix_matches = false;
+                    break;
                 }
             }
+            // if the region code has a minimum & maximum, check the postcode lies within that range (inclusively).
+            if (prefix_matches && (regioncode.maximum == 0 || (digits >= regioncode.mininum && digits <= regioncode.maximum))) {
+                return regioncode.region - 1;
+            }
         }
         return -1;
     }
 
+    std::vector<int> calculate_region_identifiers(const std::vector<std::string>& postcodes) {
+        std::vector<int> region_identifiers;
+        region_identifiers.reserve(postcodes.size());
+        for (const std::string& postcode : postcodes) {
+            region_identifiers.push_back(calculate_region_identifier(postcode));
+        }
+        return region_identifiers;
+    }
+
     std::array<float, 12> calculate_monthly_epc_outside_temperatures(int region_identifier) {
         constexpr std::array<std::array<float, 12>, 21> monthly_epc_outside_temperatures_per_region = { {
                 { 5.1f, 5.6f, 7.4f, 9.9f, 13.0f, 16.0f, 17.9f, 17.8f, 15.2f, 11.6f, 8.0f, 5.1f },
@@ -563,47 +1021,61 @@ namespace heatninja {
         }
     }
 
-    ThermalTransmittanceAndOptimisedEpcDemand calculate_dwellings_thermal_transmittance(const float house_size, const float epc_body_gain, const std::array<float, 12>& monthly_epc_outside_temperatures, const std::array<int, 12>& monthly_epc_solar_irradiances, const std::array<float, 12>& monthly_solar_height_factors, const std::array<float, 12>& monthly_solar_declinations, const std::array<float, 12>& monthly_solar_gains_south, const std::array<float, 12>& monthly_solar_gains_north, const float heat_capacity, const int epc_space_heating) {
-        float thermal_transmittance = 0.5;
-        float optimised_epc_demand = 0;
+    const std::vector<float>& epc_thermal_transmittance_steps() {
+        // accumulated as the fit always has, so the table & the scan land on the same floats
+        static const std::vector<float> steps = [] {
+            std::vector<float> steps;
+            for (float thermal_transmittance_current = 0.5f; thermal_transmittance_current < 3.0f; thermal_transmittance_current += 0.01f) {
+                steps.push_back(thermal_transmittance_current);
+            }
+            return steps;
+        }();
+        return steps;
+    }
 
+    float calculate_epc_demand(const float thermal_transmittance, const float house_size, const float epc_body_gain, const std::array<float, 12>& monthly_epc_outside_temperatures, const std::array<float, 12>& monthly_solar_gains_south, const std::array<float, 12>& monthly_solar_gains_north, const float heat_capacity) {
         constexpr std::array<size_t, 12> days_in_months = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
         static constexpr std::array<float, 24> summer_temperature_profile = { 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7 };
         static constexpr std::array<float, 24> weekend_temperature_profile = { 7, 7, 7, 7, 7, 7, 7, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20 };
         static constexpr std::array<float, 24> default_temperature_profile = { 7, 7, 7, 7, 7, 7, 7, 20, 20, 20, 7, 7, 7, 7, 7, 7, 20, 20, 20, 20, 20, 20, 20, 20 };
 
-        // thermal_transmittance_current == ttc
-        for (float thermal_transmittance_current = 0.5f; thermal_transmittance_current < 3.0f; thermal_transmittance_current += 0.01f) {
-            int month = 0;
-            float inside_temperature_current = 20;  // Initial temperature
-            float epc_demand = 0;
-
-            for (size_t days_in_month : days_in_months) {
-                const float outside_temperature_current = monthly_epc_outside_temperatures.at(month);
-                //const int solar_irradiance_current = monthly_epc_solar_irradiances.at(month);
-                //const float solar_height_factor = monthly_solar_height_factors.at(month);
-                //const float solar_declination_current = monthly_solar_declinations.at(month);
-                const float solar_gain_south = monthly_solar_gains_south.at(month);
-                const float solar_gain_north = monthly_solar_gains_north.at(month);
-
-                for (size_t day = 0; day < days_in_month; ++day) {
-                    const std::array<float, 24>& hourly_temperature_profile = select_hourly_epc_temperature_profile(month, day, summer_temperature_profile, weekend_temperature_profile, default_temperature_profile);
-
-                    for (size_t hour = 0; hour < 24; ++hour) {
-                        const float desired_temperature_current = hourly_temperature_profile.at(hour);
-                        const float heat_flow_out = (house_size * thermal_transmittance_current * (inside_temperature_current - outside_temperature_current)) / 1000;
-
-                        // heat_flow_out in kWh, +ve means heat flows out of building, -ve heat flows into building
-                        inside_temperature_current += (-heat_flow_out + solar_gain_south + solar_gain_north + epc_body_gain) / heat_capacity;
-                        if (inside_temperature_current < desired_temperature_current) {  //  Requires heating
-                            const float space_hr_demand = (desired_temperature_current - inside_temperature_current) * heat_capacity;
-                            inside_temperature_current = desired_temperature_current;
-                            epc_demand += space_hr_demand / 0.9f;
-                        }
+        int month = 0;
+        float inside_temperature_current = 20;  // Initial temperature
+        float epc_demand = 0;
+
+        for (size_t days_in_month : days_in_months) {
+            const float outside_temperature_current = monthly_epc_outside_temperatures.at(month);
+            const float solar_gain_south = monthly_solar_gains_south.at(month);
+            const float solar_gain_north = monthly_solar_gains_north.at(month);
+
+            for (size_t day = 0; day < days_in_month; ++day) {
+                const std::array<float, 24>& hourly_temperature_profile = select_hourly_epc_temperature_profile(month, day, summer_temperature_profile, weekend_temperature_profile, default_temperature_profile);
+
+                for (size_t hour = 0; hour < 24; ++hour) {
+                    const float desired_temperature_current = hourly_temperature_profile.at(hour);
+                    const float heat_flow_out = (house_size * thermal_transmittance * (inside_temperature_current - outside_temperature_current)) / 1000;
+
+                    // heat_flow_out in kWh, +ve means heat flows out of building, -ve heat flows into building
+                    inside_temperature_current += (-heat_flow_out + solar_gain_south + solar_gain_north + epc_body_gain) / heat_capacity;
+                    if (inside_temperature_current < desired_temperature_current) {  //  Requires heating
+                        const float space_hr_demand = (desired_temperature_current - inside_temperature_current) * heat_capacity;
+                        inside_temperature_current = desired_temperature_current;
+                        epc_demand += space_hr_demand / 0.9f;
                     }
                 }
-                ++month;
             }
+            ++month;
+        }
+        return epc_demand;
+    }
+
+    ThermalTransmittanceAndOptimisedEpcDemand calculate_dwellings_thermal_transmittance(const float house_size, const float epc_body_gain, const std::array<float, 12>& monthly_epc_outside_temperatures, const std::array<int, 12>& monthly_epc_solar_irradiances, const std::array<float, 12>& monthly_solar_height_factors, const std::array<float, 12>& monthly_solar_declinations, const std::array<float, 12>& monthly_solar_gains_south, const std::array<float, 12>& monthly_solar_gains_north, const float heat_capacity, const int epc_space_heating) {
+        float thermal_transmittance = 0.5;
+        float optimised_epc_demand = 0;
+
+        // thermal_transmittance_current == ttc
+        for (const float thermal_transmittance_current : epc_thermal_transmittance_steps()) {
+            const float epc_demand = calculate_epc_demand(thermal_transmittance_current, house_size, epc_body_gain, monthly_epc_outside_temperatures, monthly_solar_gains_south, monthly_solar_gains_north, heat_capacity);
 
             const float epc_optimal_heating_demand_diff = std::abs(epc_space_heating - optimised_epc_demand);
             const float epc_heating_demand_diff = std::abs(epc_space_heating - epc_demand);
@@ -624,14 +1096,79 @@ namespace heatninja {
         return { thermal_transmittance, optimised_epc_demand };
     }
 
-    Demand calculate_yearly_space_and_hot_water_demand(const std::array<float, 24>& hourly_temperatures_over_day, const float thermostat_temperature, const std::array<float, 12>& hot_water_monthly_factors, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 24>& dhw_hourly_ratios, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float average_daily_hot_water_volume, const int hot_water_temperature, const float solar_gain_house_factor, const float house_size, const float dwelling_thermal_transmittance, const float heat_capacity, const float body_heat_gain) {
+    ThermalTransmittanceAndOptimisedEpcDemand lookup_dwellings_thermal_transmittance(const int region_identifier, const float house_size, const float epc_body_gain, const std::array<float, 12>& monthly_epc_outside_temperatures, const std::array<int, 12>& monthly_epc_solar_irradiances, const std::array<float, 12>& monthly_solar_height_factors, const std::array<float, 12>& monthly_solar_declinations, const std::array<float, 12>& monthly_solar_gains_south, const std::array<float, 12>& monthly_solar_gains_north, const float heat_capacity, const int epc_space_heating) {
+        const float house_size_position = (house_size - epc_table_house_size_min) / epc_table_house_size_step;
+        const float epc_space_heating_position = static_cast<float>(epc_space_heating - epc_table_epc_space_heating_min) / epc_table_epc_space_heating_step;
+        if (region_identifier < 0 || region_identifier >= static_cast<int>(epc_table_regions) || !(house_size_position >= 0 && house_size_position <= epc_table_house_sizes - 1) || !(epc_space_heating_position >= 0 && epc_space_heating_position <= epc_table_epc_space_heating_values - 1)) {
+            return calculate_dwellings_thermal_transmittance(house_size, epc_body_gain, monthly_epc_outside_temperatures, monthly_epc_solar_irradiances, monthly_solar_height_factors, monthly_solar_declinations, monthly_solar_gains_south, monthly_solar_gains_north, heat_capacity, epc_space_heating);
+        }
+
+        // bilinear guess of the step, the table is fitted at one latitude per region so the guess can be a few steps out
+        const size_t h = std::min(static_cast<size_t>(house_size_position), epc_table_house_sizes - 2);
+        const size_t e = std::min(static_cast<size_t>(epc_space_heating_position), epc_table_epc_space_heating_values - 2);
+        const float th = house_size_position - h, te = epc_space_heating_position - e;
+        const auto table_step = [&](const size_t hi, const size_t ei) {
+            return static_cast<float>(epc_thermal_transmittance_table.at((static_cast<size_t>(region_identifier) * epc_table_house_sizes + hi) * epc_table_epc_space_heating_values + ei));
+        };
+        const float guess = (1 - th) * ((1 - te) * table_step(h, e) + te * table_step(h, e + 1)) + th * ((1 - te) * table_step(h + 1, e) + te * table_step(h + 1, e + 1));
+
+        // walk from the guess to the step the scan of calculate_dwellings_thermal_transmittance stops at, the difference
+        // to the epc demand falls until the fitted demand crosses it, step -1 is the scan's starting point of 0 demand
+        const std::vector<float>& steps = epc_thermal_transmittance_steps();
+        const int step_count = static_cast<int>(steps.size());
+        std::array<float, 256> epc_demands;
+        epc_demands.fill(-1);
+        const auto epc_demand_at = [&](const int k) {
+            if (k < 0) return 0.0f;
+            if (epc_demands.at(k) < 0) epc_demands.at(k) = calculate_epc_demand(steps.at(k), house_size, epc_body_gain, monthly_epc_outside_temperatures, monthly_solar_gains_south, monthly_solar_gains_north, heat_capacity);
+            return epc_demands.at(k);
+        };
+        const auto epc_heating_demand_diff = [&](const int k) { return std::abs(epc_space_heating - epc_demand_at(k)); };
+
+        // the fitted demand rises with the transmittance, so gallop out from the guess until the crossing is bracketed then bisect it
+        int below = std::clamp(static_cast<int>(std::lround(guess)) - 1, 0, step_count - 1);
+        int above = below;
+        if (epc_demand_at(below) < epc_space_heating) {
+            for (int stride = 1; above < step_count && epc_demand_at(above) < epc_space_heating; stride *= 2) {
+                below = above;
+                above = std::min(above + stride, step_count);
+            }
+        }
+        else {
+            for (int stride = 1; below >= 0 && epc_demand_at(below) >= epc_space_heating; stride *= 2) {
+                above = below;
+                below = std::max(below - stride, -1);
+            }
+        }
+        while (above - below > 1) {
+            const int middle = (below + above) / 2;
+            (epc_demand_at(middle) < epc_space_heating ? below : above) = middle;
+        }
+
+        int k = std::max(below, 0);
+        if (k + 1 < step_count && epc_heating_demand_diff(k + 1) < epc_heating_demand_diff(k)) {
+            while (k + 1 < step_count && epc_heating_demand_diff(k + 1) < epc_heating_demand_diff(k)) ++k;
+        }
+        else {
+            while (k >= 0 && epc_heating_demand_diff(k) >= epc_heating_demand_diff(k - 1)) --k;
+        }
+
+        const float thermal_transmittance = k < 0 ? 0.5f : steps.at(k);
+        const float optimised_epc_demand = epc_demand_at(k);
+        std::cout << "Dwelling Thermal Transmittance: " << thermal_transmittance << '\n';
+        std::cout << "Optimised EPC Demand: " << optimised_epc_demand << '\n';
+        return { thermal_transmittance, optimised_epc_demand };
+    }
+
+    template <typename Scalar>
+    BasicDemand<Scalar> calculate_yearly_space_and_hot_water_demand(const std::array<Scalar, 24>& hourly_temperatures_over_day, const Scalar thermostat_temperature, const std::array<float, 12>& hot_water_monthly_factors, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 24>& dhw_hourly_ratios, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float average_daily_hot_water_volume, const int hot_water_temperature, const Scalar solar_gain_house_factor, const Scalar house_size, const float dwelling_thermal_transmittance, const Scalar heat_capacity, const float body_heat_gain) {
         size_t hour_year_counter = 0;
 
-        float max_hourly_demand = 0;
-        float demand_total = 0;
+        Scalar max_hourly_demand = 0;
+        Scalar demand_total = 0;
 
-        float inside_temperature_current = thermostat_temperature;
-        float hot_water_total = 0;
+        Scalar inside_temperature_current = thermostat_temperature;
+        Scalar hot_water_total = 0;
 
         constexpr std::array<size_t, 12> days_in_months = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
 
@@ -643,26 +1180,104 @@ namespace heatninja {
             const float ratio_solar_gain_north = monthly_solar_gain_ratios_north.at(month);
             for (size_t day = 0; day < days_in_month; ++day) {
                 for (size_t hour = 0; hour < 24; ++hour) {
-                    calculate_hourly_space_and_hot_water_demand(hourly_temperatures_over_day, inside_temperature_current, ratio_solar_gain_south, ratio_solar_gain_north, cold_water_temperature, hot_water_monthly_factor, demand_total, hot_water_total, max_hourly_demand, hour_year_counter, hour, dhw_hourly_ratios, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, average_daily_hot_water_volume, hot_water_temperature, solar_gain_house_factor, house_size, dwelling_thermal_transmittance, heat_capacity, body_heat_gain);
+                    calculate_hourly_space_and_hot_water_demand<Scalar>(hourly_temperatures_over_day, inside_temperature_current, ratio_solar_gain_south, ratio_solar_gain_north, cold_water_temperature, hot_water_monthly_factor, demand_total, hot_water_total, max_hourly_demand, hour_year_counter, hour, dhw_hourly_ratios, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, average_daily_hot_water_volume, hot_water_temperature, solar_gain_house_factor, house_size, dwelling_thermal_transmittance, heat_capacity, body_heat_gain);
                     ++hour_year_counter;
                 }
             }
             ++month;
         }
 
+        const Scalar space_demand = demand_total - hot_water_total;
+        std::cout << "Yearly Hot Water Demand: " + float_to_string(value_of(hot_water_total), 4) << +" kWh\n";
+        std::cout << "Yearly Space demand: " + float_to_string(value_of(space_demand), 4) << +" kWh\n";
+        std::cout << "Yearly Total demand: " + float_to_string(value_of(demand_total), 4) << +" kWh\n";
+        std::cout << "Max hourly demand: " + float_to_string(value_of(max_hourly_demand), 4) << +" kWh\n";
+        //fmt::print("Space demand: {:.2f} kWh\n", space_demand);
+        //fmt::print("Yearly total thermal demand: {:.2f} kWh\n", demand_total);
+        //fmt::print("Max hourly demand: {:.2f} kWh\n", max_hourly_demand);
+        return { demand_total , max_hourly_demand, space_demand, hot_water_total};
+    }
+
+    InsideTemperatureMap compose_inside_temperature_maps(const InsideTemperatureMap& first, const InsideTemperatureMap& then) {
+        return { then.scale * first.scale, then.scale * first.offset + then.offset, std::max(then.scale * first.floor + then.offset, then.floor) };
+    }
+
+    Demand calculate_yearly_space_and_hot_water_demand_scan(const std::array<float, 24>& hourly_temperatures_over_day, const float thermostat_temperature, const std::array<float, 12>& hot_water_monthly_factors, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 24>& dhw_hourly_ratios, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float average_daily_hot_water_volume, const int hot_water_temperature, const float solar_gain_house_factor, const float house_size, const float dwelling_thermal_transmittance, const float heat_capacity, const float body_heat_gain, const bool use_multithreading) {
+        constexpr size_t days_in_year = 365;
+        constexpr std::array<size_t, 12> days_in_months = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        std::array<size_t, days_in_year> months_of_days;
+        for (size_t month = 0, day = 0; month < 12; ++month) {
+            for (size_t day_of_month = 0; day_of_month < days_in_months.at(month); ++day_of_month) months_of_days.at(day++) = month;
+        }
+        std::array<size_t, days_in_year> days;
+        for (size_t day = 0; day < days_in_year; ++day) days.at(day) = day;
+        const auto for_each_day = [&](const auto& function) {
+#ifndef EM_COMPATIBLE
+            if (use_multithreading) {
+                std::for_each(std::execution::par, days.begin(), days.end(), function);
+                return;
+            }
+#endif
+            std::for_each(days.begin(), days.end(), function);
+        };
+
+        // inside_temp += (-house_size * U * (inside_temp - outside_temp) / 1000 + gains) / heat_capacity, then clamped up to the profile
+        const float house_size_thermal_transmittance_product = house_size * dwelling_thermal_transmittance / 1000;
+        const float scale = 1 - house_size_thermal_transmittance_product / heat_capacity;
+        std::array<InsideTemperatureMap, days_in_year> day_maps;
+        for_each_day([&](const size_t day) {
+            const size_t month = months_of_days.at(day);
+            const float ratio_solar_gain = monthly_solar_gain_ratios_south.at(month) + monthly_solar_gain_ratios_north.at(month);
+            InsideTemperatureMap day_map;
+            for (size_t hour = 0; hour < 24; ++hour) {
+                const size_t hour_year_counter = day * 24 + hour;
+                const float gains = hourly_solar_irradiances_over_year.at(hour_year_counter) * ratio_solar_gain * solar_gain_house_factor + body_heat_gain;
+                const float offset = (house_size_thermal_transmittance_product * hourly_outside_temperatures_over_year.at(hour_year_counter) + gains) / heat_capacity;
+                day_map = compose_inside_temperature_maps(day_map, { scale, offset, hourly_temperatures_over_day.at(hour) });
+            }
+            day_maps.at(day) = day_map;
+        });
+
+        // the serial part is one step a day, a day that ends clamped starts the next from its floor whatever came before
+        std::array<float, days_in_year> day_start_temperatures;
+        float inside_temperature = thermostat_temperature;
+        for (size_t day = 0; day < days_in_year; ++day) {
+            day_start_temperatures.at(day) = inside_temperature;
+            inside_temperature = day_maps.at(day)(inside_temperature);
+        }
+
+        std::array<Demand, days_in_year> day_demands;
+        for_each_day([&](const size_t day) {
+            const size_t month = months_of_days.at(day);
+            float inside_temperature_current = day_start_temperatures.at(day);
+            float demand_total = 0, hot_water_total = 0, max_hourly_demand = 0;
+            for (size_t hour = 0; hour < 24; ++hour) {
+                calculate_hourly_space_and_hot_water_demand(hourly_temperatures_over_day, inside_temperature_current, monthly_solar_gain_ratios_south.at(month), monthly_solar_gain_ratios_north.at(month), monthly_cold_water_temperatures.at(month), hot_water_monthly_factors.at(month), demand_total, hot_water_total, max_hourly_demand, day * 24 + hour, hour, dhw_hourly_ratios, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, average_daily_hot_water_volume, hot_water_temperature, solar_gain_house_factor, house_size, dwelling_thermal_transmittance, heat_capacity, body_heat_gain);
+            }
+            day_demands.at(day) = { demand_total, max_hourly_demand, 0, hot_water_total };
+        });
+
+        // summed in day order so the result doesn't depend on the threads
+        float max_hourly_demand = 0;
+        float demand_total = 0;
+        float hot_water_total = 0;
+        for (const Demand& day_demand : day_demands) {
+            demand_total += day_demand.total;
+            hot_water_total += day_demand.hot_water;
+            max_hourly_demand = std::max(max_hourly_demand, day_demand.max_hourly);
+        }
+
         const float space_demand = demand_total - hot_water_total;
         std::cout << "Yearly Hot Water Demand: " + float_to_string(hot_water_total, 4) << +" kWh\n";
         std::cout << "Yearly Space demand: " + float_to_string(space_demand, 4) << +" kWh\n";
         std::cout << "Yearly Total demand: " + float_to_string(demand_total, 4) << +" kWh\n";
         std::cout << "Max hourly demand: " + float_to_string(max_hourly_demand, 4) << +" kWh\n";
-        //fmt::print("Space demand: {:.2f} kWh\n", space_demand);
-        //fmt::print("Yearly total thermal demand: {:.2f} kWh\n", demand_total);
-        //fmt::print("Max hourly demand: {:.2f} kWh\n", max_hourly_demand);
-        return { demand_total , max_hourly_demand, space_demand, hot_water_total};
+        return { demand_total, max_hourly_demand, space_demand, hot_water_total };
     }
 
-    void calculate_hourly_space_and_hot_water_demand(const std::array<float, 24>& hourly_temperatures_over_day, float& inside_temp_current, const float ratio_solar_gain_south, const float ratio_solar_gain_north, const float cwt_current, const float dhw_mf_current, float& demand_total, float& dhw_total, float& max_hourly_demand, const size_t hour_year_counter, const size_t hour, const std::array<float, 24>& dhw_hourly_ratios, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float average_daily_hot_water_volume, const int hot_water_temperature, const float solar_gain_house_factor, const float house_size, const float dwelling_thermal_transmittance, const float heat_capacity, const float body_heat_gain) {
-        const float desired_temp_current = hourly_temperatures_over_day.at(hour);
+    template <typename Scalar>
+    void calculate_hourly_space_and_hot_water_demand(const std::array<Scalar, 24>& hourly_temperatures_over_day, Scalar& inside_temp_current, const float ratio_solar_gain_south, const float ratio_solar_gain_north, const float cwt_current, const float dhw_mf_current, Scalar& demand_total, Scalar& dhw_total, Scalar& max_hourly_demand, const size_t hour_year_counter, const size_t hour, const std::array<float, 24>& dhw_hourly_ratios, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float average_daily_hot_water_volume, const int hot_water_temperature, const Scalar solar_gain_house_factor, const Scalar house_size, const float dwelling_thermal_transmittance, const Scalar heat_capacity, const float body_heat_gain) {
+        const Scalar desired_temp_current = hourly_temperatures_over_day.at(hour);
         const float dhw_hr_current = dhw_hourly_ratios.at(hour);
         const float outside_temp_current = hourly_outside_temperatures_over_year.at(hour_year_counter);
         const float solar_irradiance_current = hourly_solar_irradiances_over_year.at(hour_year_counter);
@@ -671,16 +1286,16 @@ namespace heatninja {
 
         const float incident_irradiance_solar_gain_south = solar_irradiance_current * ratio_solar_gain_south;
         const float incident_irradiance_solar_gain_north = solar_irradiance_current * ratio_solar_gain_north;
-        const float solar_gain_south = incident_irradiance_solar_gain_south * solar_gain_house_factor;
-        const float solar_gain_north = incident_irradiance_solar_gain_north * solar_gain_house_factor;
+        const Scalar solar_gain_south = incident_irradiance_solar_gain_south * solar_gain_house_factor;
+        const Scalar solar_gain_north = incident_irradiance_solar_gain_north * solar_gain_house_factor;
 
         //float solar_irradiance_current = Solar_Irradiance[Weather_Count]
-        const float heat_loss = (house_size * dwelling_thermal_transmittance * (inside_temp_current - outside_temp_current)) / 1000;
+        const Scalar heat_loss = (house_size * dwelling_thermal_transmittance * (inside_temp_current - outside_temp_current)) / 1000;
 
         // heat_flow_out in kWh, +ve means heat flows out of building, -ve heat flows into building
         inside_temp_current += (-heat_loss + solar_gain_south + solar_gain_north + body_heat_gain) / heat_capacity;
 
-        float space_hr_demand = 0;
+        Scalar space_hr_demand = 0;
         if (inside_temp_current < desired_temp_current) {  //  Requires heating
             space_hr_demand = (desired_temp_current - inside_temp_current) * heat_capacity;
             inside_temp_current = desired_temp_current;
@@ -688,12 +1303,115 @@ namespace heatninja {
         }
 
         //std::cout << hour << ' ' << space_hr_demand << ' ' << demand_total - dhw_hr_demand << '\n';
-        const float hourly_demand = dhw_hr_demand + space_hr_demand;
+        const Scalar hourly_demand = dhw_hr_demand + space_hr_demand;
         max_hourly_demand = std::max(max_hourly_demand, hourly_demand);
         demand_total += hourly_demand;
         dhw_total += dhw_hr_demand;
     }
 
+    std::vector<HouseholdDemand> screen_household_demands(const std::vector<HouseholdDemandInputs>& households, const float latitude, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year) {
+        // demand only mode for many households sharing a weather grid cell, same recurrence as calculate_hourly_space_and_hot_water_demand
+        const std::array<float, 12> monthly_solar_height_factors = calculate_monthly_solar_height_factors(latitude, monthly_solar_declinations);
+        const std::array<float, 12> monthly_cold_water_temperatures = calculate_monthly_cold_water_temperatures(latitude);
+        const std::array<float, 12> monthly_solar_gain_ratios_north = calculate_monthly_solar_gain_ratios_north(monthly_solar_height_factors);
+        const std::array<float, 12> monthly_solar_gain_ratios_south = calculate_monthly_solar_gain_ratios_south(monthly_solar_height_factors);
+
+        std::vector<HouseholdDemand> demands(households.size());
+        for (size_t first = 0; first < households.size(); first += demand_screening_lanes) {
+            const size_t count = std::min(demand_screening_lanes, households.size() - first);
+            screen_household_demand_block(&households.at(first), count, &demands.at(first), monthly_cold_water_temperatures, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year);
+        }
+        return demands;
+    }
+
+    void screen_household_demand_block(const HouseholdDemandInputs* households, const size_t count, HouseholdDemand* demands, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year) {
+        // one household per lane, unused lanes repeat the last household so every lane stays finite
+        // the lane loops are branchless so they compile to SIMD (8 lanes AVX2, 16 lanes AVX-512, 4 lanes WASM SIMD)
+        constexpr size_t lanes = demand_screening_lanes;
+
+        alignas(64) std::array<float, lanes> thermostat_temperatures, house_size_thermal_transmittance_products, solar_gain_house_factors, heat_capacities, body_heat_gains, average_daily_hot_water_volumes;
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            const HouseholdDemandInputs& h = households[std::min(lane, count - 1)];
+            thermostat_temperatures[lane] = h.thermostat_temperature;
+            house_size_thermal_transmittance_products[lane] = h.house_size * h.dwelling_thermal_transmittance;
+            solar_gain_house_factors[lane] = calculate_solar_gain_house_factor(h.house_size);
+            heat_capacities[lane] = calculate_heat_capacity(h.house_size);
+            body_heat_gains[lane] = calculate_body_heat_gain(h.num_occupants);
+            average_daily_hot_water_volumes[lane] = calculate_average_daily_hot_water_volume(h.num_occupants);
+        }
+
+        // each lane's desired temperatures by hour of the day, from the same profiles as run_simulation
+        alignas(64) std::array<std::array<float, lanes>, 24> erh_desired_temperatures, hp_desired_temperatures;
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            const std::array<float, 24> erh_hourly_temperatures_over_day = calculate_erh_hourly_temperature_profile(thermostat_temperatures[lane]);
+            const std::array<float, 24> hp_hourly_temperatures_over_day = calculate_hp_hourly_temperature_profile(thermostat_temperatures[lane]);
+            for (size_t hour = 0; hour < 24; ++hour) {
+                erh_desired_temperatures[hour][lane] = erh_hourly_temperatures_over_day[hour];
+                hp_desired_temperatures[hour][lane] = hp_hourly_temperatures_over_day[hour];
+            }
+        }
+
+        alignas(64) std::array<float, lanes> erh_inside_temperatures = thermostat_temperatures, hp_inside_temperatures = thermostat_temperatures;
+        alignas(64) std::array<float, lanes> erh_demand_totals = {}, hp_demand_totals = {}, erh_max_hourly_demands = {}, hp_max_hourly_demands = {}, hot_water_totals = {};
+        alignas(64) std::array<float, lanes> daily_hot_water_demands;
+
+        constexpr std::array<size_t, 12> days_in_months = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        size_t hour_year_counter = 0;
+        size_t month = 0;
+        for (size_t days_in_month : days_in_months) {
+            const float cold_water_temperature = monthly_cold_water_temperatures.at(month);
+            const float hot_water_monthly_factor = dhw_monthly_factors.at(month);
+            const float ratio_solar_gain_south = monthly_solar_gain_ratios_south.at(month);
+            const float ratio_solar_gain_north = monthly_solar_gain_ratios_north.at(month);
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                daily_hot_water_demands[lane] = (average_daily_hot_water_volumes[lane] * 4.18f * (hot_water_temperature - cold_water_temperature) / 3600) * hot_water_monthly_factor;
+            }
+            for (size_t day = 0; day < days_in_month; ++day) {
+                for (size_t hour = 0; hour < 24; ++hour) {
+                    const float outside_temp_current = hourly_outside_temperatures_over_year.at(hour_year_counter);
+                    const float solar_irradiance_current = hourly_solar_irradiances_over_year.at(hour_year_counter);
+                    const float incident_irradiance_solar_gain_south = solar_irradiance_current * ratio_solar_gain_south;
+                    const float incident_irradiance_solar_gain_north = solar_irradiance_current * ratio_solar_gain_north;
+                    const float dhw_hr_current = hot_water_hourly_ratios[hour];
+                    const std::array<float, lanes>& erh_desired_temps = erh_desired_temperatures[hour];
+                    const std::array<float, lanes>& hp_desired_temps = hp_desired_temperatures[hour];
+
+                    for (size_t lane = 0; lane < lanes; ++lane) {
+                        const float dhw_hr_demand = daily_hot_water_demands[lane] * dhw_hr_current;
+                        const float solar_gain_south = incident_irradiance_solar_gain_south * solar_gain_house_factors[lane];
+                        const float solar_gain_north = incident_irradiance_solar_gain_north * solar_gain_house_factors[lane];
+                        hot_water_totals[lane] += dhw_hr_demand;
+
+                        const float erh_desired_temp = erh_desired_temps[lane];
+                        float erh_inside_temp = erh_inside_temperatures[lane];
+                        const float erh_heat_loss = (house_size_thermal_transmittance_products[lane] * (erh_inside_temp - outside_temp_current)) / 1000;
+                        erh_inside_temp += (-erh_heat_loss + solar_gain_south + solar_gain_north + body_heat_gains[lane]) / heat_capacities[lane];
+                        const float erh_space_hr_demand = erh_inside_temp < erh_desired_temp ? (erh_desired_temp - erh_inside_temp) * heat_capacities[lane] : 0.0f;
+                        erh_inside_temperatures[lane] = erh_inside_temp < erh_desired_temp ? erh_desired_temp : erh_inside_temp;
+                        erh_max_hourly_demands[lane] = std::max(erh_max_hourly_demands[lane], dhw_hr_demand + erh_space_hr_demand);
+                        erh_demand_totals[lane] += dhw_hr_demand + erh_space_hr_demand;
+
+                        const float hp_desired_temp = hp_desired_temps[lane];
+                        float hp_inside_temp = hp_inside_temperatures[lane];
+                        const float hp_heat_loss = (house_size_thermal_transmittance_products[lane] * (hp_inside_temp - outside_temp_current)) / 1000;
+                        hp_inside_temp += (-hp_heat_loss + solar_gain_south + solar_gain_north + body_heat_gains[lane]) / heat_capacities[lane];
+                        const float hp_space_hr_demand = hp_inside_temp < hp_desired_temp ? (hp_desired_temp - hp_inside_temp) * heat_capacities[lane] : 0.0f;
+                        hp_inside_temperatures[lane] = hp_inside_temp < hp_desired_temp ? hp_desired_temp : hp_inside_temp;
+                        hp_max_hourly_demands[lane] = std::max(hp_max_hourly_demands[lane], dhw_hr_demand + hp_space_hr_demand);
+                        hp_demand_totals[lane] += dhw_hr_demand + hp_space_hr_demand;
+                    }
+                    ++hour_year_counter;
+                }
+            }
+            ++month;
+        }
+
+        for (size_t lane = 0; lane < count; ++lane) {
+            demands[lane].erh = { erh_demand_totals[lane], erh_max_hourly_demands[lane], erh_demand_totals[lane] - hot_water_totals[lane], hot_water_totals[lane] };
+            demands[lane].hp = { hp_demand_totals[lane], hp_max_hourly_demands[lane], hp_demand_totals[lane] - hot_water_totals[lane], hot_water_totals[lane] };
+        }
+    }
+
     void write_demand_data(const std::string filename, const float dwelling_thermal_transmittance, const float optimised_epc_demand, const float yearly_erh_demand, const float maximum_hourly_erh_demand, const float yearly_erh_space_demand, const float yearly_erh_hot_water_demand, const float yearly_hp_demand, const float maximum_hourly_hp_demand, const float yearly_hp_space_demand, const float yearly_hp_hot_water_demand) {
         std::ofstream file(filename);
         file << dwelling_thermal_transmittance << "," << optimised_epc_demand << "\n";
@@ -704,15 +1422,45 @@ namespace heatninja {
 
     // OPTIMAL SPECIFICATIONS
 
-    float calculate_coldest_outside_temperature_of_year(const float latitude, const float longitude) {
-        const std::map<std::string, float> coldest_outside_temperatures_of_year_per_region = { { "50.0_-3.5", 4.61f }, { "50.0_-4.0", 4.554f }, { "50.0_-4.5", 4.406f }, { "50.0_-5.0", 4.017f }, { "50.0_-5.5", 4.492f }, { "50.5_-0.5", 3.02f }, { "50.5_-1.0", 3.188f }, { "50.5_-1.5", 2.812f }, { "50.5_-2.0", 2.583f }, { "50.5_-2.5", 2.774f }, { "50.5_-3.0", 2.697f }, { "50.5_-3.5", 1.744f }, { "50.5_-4.0", 0.854f }, { "50.5_-4.5", 1.27f }, { "50.5_-5.0", 2.708f }, { "50.5_0.0", 2.886f }, { "50.5_0.5", 2.764f }, { "51.0_-0.5", -3.846f }, { "51.0_-1.0", -4.285f }, { "51.0_-1.5", -4.421f }, { "51.0_-2.0", -4.274f }, { "51.0_-2.5", -3.764f }, { "51.0_-3.0", -2.635f }, { "51.0_-3.5", -1.712f }, { "51.0_-4.0", -0.232f }, { "51.0_-4.5", 1.638f }, { "51.0_0.0", -3.344f }, { "51.0_0.5", -2.101f }, { "51.0_1.0", 0.307f }, { "51.0_1.5", 1.271f }, { "51.5_-0.5", -5.969f }, { "51.5_-1.0", -5.673f }, { "51.5_-1.5", -5.09f }, { "51.5_-2.0", -4.292f }, { "51.5_-2.5", -3.039f }, { "51.5_-3.0", -1.591f }, { "51.5_-3.5", 0.221f }, { "51.5_-4.0", 1.249f }, { "51.5_-4.5", 2.001f }, { "51.5_-5.0", 2.948f }, { "51.5_0.0", -5.628f }, { "51.5_0.5", -4.165f }, { "51.5_1.0", -1.369f }, { "51.5_1.5", 1.813f }, { "52.0_-0.5", -5.601f }, { "52.0_-1.0", -5.283f }, { "52.0_-1.5", -4.854f }, { "52.0_-2.0", -4.37f }, { "52.0_-2.5", -3.7f }, { "52.0_-3.0", -3.597f }, { "52.0_-3.5", -3.13f }, { "52.0_-4.0", -2.297f }, { "52.0_-4.5", -0.642f }, { "52.0_-5.0", 2.044f }, { "52.0_-5.5", 3.622f }, { "52.0_0.0", -5.439f }, { "52.0_0.5", -4.533f }, { "52.0_1.0", -2.836f }, { "52.0_1.5", 0.146f }, { "52.5_-0.5", -4.979f }, { "52.5_-1.0", -4.814f }, { "52.5_-1.5", -4.451f }, { "52.5_-2.0", -3.991f }, { "52.5_-2.5", -3.603f }, { "52.5_-3.0", -3.359f }, { "52.5_-3.5", -3.007f }, { "52.5_-4.0", -0.479f }, { "52.5_-4.5", 2.769f }, { "52.5_0.0", -4.845f }, { "52.5_0.5", -4.0f }, { "52.5_1.0", -3.96f }, { "52.5_1.5", -1.778f }, { "52.5_2.0", 1.576f }, { "53.0_-0.5", -4.434f }, { "53.0_-1.0", -4.51f }, { "53.0_-1.5", -4.234f }, { "53.0_-2.0", -3.806f }, { "53.0_-2.5", -3.409f }, { "53.0_-3.0", -2.964f }, { "53.0_-3.5", -2.419f }, { "53.0_-4.0", -0.304f }, { "53.0_-4.5", 1.987f }, { "53.0_-5.0", 3.827f }, { "53.0_0.0", -4.07f }, { "53.0_0.5", -1.754f }, { "53.0_1.0", 0.277f }, { "53.0_1.5", 1.709f }, { "53.0_2.0", 2.397f }, { "53.5_-0.5", -4.156f }, { "53.5_-1.0", -4.141f }, { "53.5_-1.5", -3.834f }, { "53.5_-2.0", -3.492f }, { "53.5_-2.5", -2.729f }, { "53.5_-3.0", -1.344f }, { "53.5_-3.5", 0.446f }, { "53.5_-4.0", 1.524f }, { "53.5_-4.5", 2.578f }, { "53.5_0.0", -2.173f }, { "53.5_0.5", 1.351f }, { "54.0_-0.5", -2.622f }, { "54.0_-1.0", -3.424f }, { "54.0_-1.5", -3.834f }, { "54.0_-2.0", -3.837f }, { "54.0_-2.5", -2.766f }, { "54.0_-3.0", -0.56f }, { "54.0_-3.5", 1.22f }, { "54.0_-5.5", 3.297f }, { "54.0_-6.0", 1.151f }, { "54.0_-6.5", -1.496f }, { "54.0_-7.0", -3.164f }, { "54.0_-7.5", -3.294f }, { "54.0_-8.0", -2.848f }, { "54.0_0.0", 0.231f }, { "54.5_-0.5", 0.579f }, { "54.5_-1.0", -1.903f }, { "54.5_-1.5", -4.414f }, { "54.5_-2.0", -5.579f }, { "54.5_-2.5", -5.161f }, { "54.5_-3.0", -2.187f }, { "54.5_-3.5", -0.424f }, { "54.5_-4.0", 1.047f }, { "54.5_-4.5", 2.244f }, { "54.5_-5.0", 2.994f }, { "54.5_-5.5", 1.337f }, { "54.5_-6.0", -0.575f }, { "54.5_-6.5", -2.338f }, { "54.5_-7.0", -3.041f }, { "54.5_-7.5", -2.662f }, { "54.5_-8.0", -1.808f }, { "55.0_-1.5", -0.996f }, { "55.0_-2.0", -4.155f }, { "55.0_-2.5", -6.204f }, { "55.0_-3.0", -4.514f }, { "55.0_-3.5", -2.703f }, { "55.0_-4.0", -1.58f }, { "55.0_-4.5", -0.407f }, { "55.0_-5.0", 0.806f }, { "55.0_-5.5", 2.081f }, { "55.0_-6.0", 0.887f }, { "55.0_-6.5", -0.469f }, { "55.0_-7.0", -0.993f }, { "55.0_-7.5", -0.77f }, { "55.5_-1.5", 0.873f }, { "55.5_-2.0", -2.474f }, { "55.5_-2.5", -5.702f }, { "55.5_-3.0", -5.566f }, { "55.5_-3.5", -4.895f }, { "55.5_-4.0", -4.132f }, { "55.5_-4.5", -2.358f }, { "55.5_-5.0", -0.579f }, { "55.5_-5.5", 1.338f }, { "55.5_-6.0", 2.057f }, { "55.5_-6.5", 2.505f }, { "56.0_-2.0", 1.815f }, { "56.0_-2.5", 0.195f }, { "56.0_-3.0", -2.189f }, { "56.0_-3.5", -4.626f }, { "56.0_-4.0", -5.49f }, { "56.0_-4.5", -4.919f }, { "56.0_-5.0", -3.499f }, { "56.0_-5.5", -1.181f }, { "56.0_-6.0", 1.063f }, { "56.0_-6.5", 2.977f }, { "56.5_-2.5", -0.305f }, { "56.5_-3.0", -3.11f }, { "56.5_-3.5", -5.41f }, { "56.5_-4.0", -6.757f }, { "56.5_-4.5", -7.005f }, { "56.5_-5.0", -5.879f }, { "56.5_-5.5", -3.253f }, { "56.5_-6.0", 0.046f }, { "56.5_-6.5", 2.699f }, { "56.5_-7.0", 4.242f }, { "57.0_-2.0", 1.061f }, { "57.0_-2.5", -4.347f }, { "57.0_-3.0", -6.774f }, { "57.0_-3.5", -8.256f }, { "57.0_-4.0", -8.531f }, { "57.0_-4.5", -8.952f }, { "57.0_-5.0", -7.613f }, { "57.0_-5.5", -4.211f }, { "57.0_-6.0", -0.368f }, { "57.0_-6.5", 2.421f }, { "57.0_-7.0", 3.249f }, { "57.0_-7.5", 4.066f }, { "57.5_-2.0", 0.562f }, { "57.5_-2.5", -2.636f }, { "57.5_-3.0", -3.24f }, { "57.5_-3.5", -3.825f }, { "57.5_-4.0", -4.351f }, { "57.5_-4.5", -5.412f }, { "57.5_-5.0", -7.049f }, { "57.5_-5.5", -3.771f }, { "57.5_-6.0", 0.002f }, { "57.5_-6.5", 2.105f }, { "57.5_-7.0", 2.649f }, { "57.5_-7.5", 3.287f }, { "58.0_-3.5", 1.614f }, { "58.0_-4.0", -0.872f }, { "58.0_-4.5", -2.392f }, { "58.0_-5.0", -2.029f }, { "58.0_-5.5", 0.609f }, { "58.0_-6.0", 2.139f }, { "58.0_-6.5", 2.056f }, { "58.0_-7.0", 1.757f }, { "58.5_-3.0", 1.924f }, { "58.5_-3.5", 1.382f }, { "58.5_-4.0", 0.97f }, { "58.5_-4.5", 0.903f }, { "58.5_-5.0", 1.605f }, { "58.5_-5.5", 2.935f }, { "58.5_-6.0", 2.901f }, { "58.5_-6.5", 2.723f }, { "58.5_-7.0", 2.661f }, { "59.0_-2.5", 2.975f }, { "59.0_-3.0", 2.525f }, { "59.0_-3.5", 3.066f }, { "59.5_-1.5", 3.281f }, { "59.5_-2.5", 3.684f }, { "59.5_-3.0", 3.79f }, { "60.0_-1.0", 2.361f }, { "60.0_-1.5", 2.383f }, { "60.5_-1.0", 1.794f }, { "60.5_-1.5", 1.783f }, { "61.0_-1.0", 1.721f }
-        };
+    // dense grid of weather cells indexed by half degree latitude & longitude steps, built at compile time from grid_cells.h
+    constexpr int grid_latitude_step_min = std::min_element(grid_cell_assets.begin(), grid_cell_assets.end(), [](const GridCellAsset& a, const GridCellAsset& b) { return a.latitude_step < b.latitude_step; })->latitude_step;
+    constexpr int grid_latitude_step_max = std::max_element(grid_cell_assets.begin(), grid_cell_assets.end(), [](const GridCellAsset& a, const GridCellAsset& b) { return a.latitude_step < b.latitude_step; })->latitude_step;
+    constexpr int grid_longitude_step_min = std::min_element(grid_cell_assets.begin(), grid_cell_assets.end(), [](const GridCellAsset& a, const GridCellAsset& b) { return a.longitude_step < b.longitude_step; })->longitude_step;
+    constexpr int grid_longitude_step_max = std::max_element(grid_cell_assets.begin(), grid_cell_assets.end(), [](const GridCellAsset& a, const GridCellAsset& b) { return a.longitude_step < b.longitude_step; })->longitude_step;
+    constexpr size_t grid_rows = grid_latitude_step_max - grid_latitude_step_min + 1;
+    constexpr size_t grid_columns = grid_longitude_step_max - grid_longitude_step_min + 1;
 
-        const float rounded_latitude = round_coordinate(latitude);
-        const float rounded_longtitude = round_coordinate(longitude);
+    constexpr std::array<GridCell, grid_rows * grid_columns> build_grid_cells() {
+        std::array<GridCell, grid_rows * grid_columns> grid_cells = {};
+        size_t cell_index = 0;
+        for (const GridCellAsset& asset : grid_cell_assets) {
+            const size_t row = static_cast<size_t>(asset.latitude_step - grid_latitude_step_min);
+            const size_t column = static_cast<size_t>(asset.longitude_step - grid_longitude_step_min);
+            grid_cells.at(row * grid_columns + column) = { true, cell_index, asset.coldest_outside_temperature, calculate_cold_water_band(static_cast<float>(asset.latitude_step) / 2) };
+            ++cell_index;
+        }
+        return grid_cells;
+    }
 
-        const std::string key = float_to_string(rounded_latitude, 1) + "_" + float_to_string(rounded_longtitude, 1);
-        return coldest_outside_temperatures_of_year_per_region.at(key);
+    constexpr std::array<GridCell, grid_rows * grid_columns> grid_cells = build_grid_cells();
+
+    const GridCell* find_grid_cell(const float latitude, const float longitude) {
+        // nullptr if the coordinates are outside the weather data
+        const int latitude_step = static_cast<int>(round_coordinate(latitude) * 2) - grid_latitude_step_min;
+        const int longitude_step = static_cast<int>(round_coordinate(longitude) * 2) - grid_longitude_step_min;
+        if (latitude_step < 0 || latitude_step >= static_cast<int>(grid_rows) || longitude_step < 0 || longitude_step >= static_cast<int>(grid_columns)) {
+            return nullptr;
+        }
+        const GridCell& grid_cell = grid_cells[static_cast<size_t>(latitude_step) * grid_columns + static_cast<size_t>(longitude_step)];
+        return grid_cell.available ? &grid_cell : nullptr;
+    }
+
+    float calculate_coldest_outside_temperature_of_year(const float latitude, const float longitude) {
+        const GridCell* grid_cell = find_grid_cell(latitude, longitude);
+        if (grid_cell == nullptr) {
+            throw std::out_of_range("no weather data for latitude " + float_to_string(latitude, 4) + ", longitude " + float_to_string(longitude, 4));
+        }
+        return grid_cell->coldest_outside_temperature;
     }
 
     float calculate_ground_temperature(const float latitude) {
@@ -727,11 +1475,13 @@ namespace heatninja {
         return static_cast<int>(house_size / 8) * 2;  // Quarter of the roof for solar, even number
     }
 
-    float calculate_house_size_thermal_transmittance_product(const float house_size, const float dwelling_thermal_transmittance) {
+    template <typename Scalar>
+    Scalar calculate_house_size_thermal_transmittance_product(const Scalar house_size, const float dwelling_thermal_transmittance) {
         return house_size * dwelling_thermal_transmittance / 1000;
     }
 
-    const std::array<float, 24>& select_temp_profile(const HeatOption hp_option, const std::array<float, 24>& hp_temp_profile, const std::array<float, 24>& erh_temp_profile) {
+    template <typename Scalar>
+    const std::array<Scalar, 24>& select_temp_profile(const HeatOption hp_option, const std::array<Scalar, 24>& hp_temp_profile, const std::array<Scalar, 24>& erh_temp_profile) {
         switch (hp_option)
         {
         case HeatOption::ASHP:
@@ -766,13 +1516,15 @@ namespace heatninja {
         }
     }
 
-    float clamp(float value, float min, float max) {
+    template <typename Scalar>
+    Scalar clamp(const Scalar value, const float min, const float max) {
         if (value < min) { return min; }
         else if (value > max) { return max; }
         else { return value; }
     }
 
-    float calculate_hp_electrical_power(const HeatOption hp_option, const float max_hourly_erh_demand, const float max_hourly_hp_demand, const float cop_worst, const float cop_ref) {
+    template <typename Scalar>
+    Scalar calculate_hp_electrical_power(const HeatOption hp_option, const Scalar max_hourly_erh_demand, const Scalar max_hourly_hp_demand, const float cop_worst, const float cop_ref) {
         // Mitsubishi have 4kWth ASHP, Kensa have 3kWth GSHP
         // 7kWth Typical maximum size for domestic power
         switch (hp_option)
@@ -801,6 +1553,12 @@ namespace heatninja {
 
     std::vector<size_t> linearly_space(float range, size_t segments) {
         std::vector<size_t> points;
+        linearly_space(range, segments, points);
+        return points;
+    }
+
+    void linearly_space(float range, size_t segments, std::vector<size_t>& points) {
+        points.clear();
         points.reserve(segments + 1);
         const float step = range / segments;
         int j = 0;
@@ -810,12 +1568,109 @@ namespace heatninja {
             points.push_back(j);
             //std::cout << i << ", " << j << '\n';
         }
-        return points;
     }
 
-    struct IndexRect {
-        size_t i1, j1, i2, j2;
-    };
+    double surrogate_kernel(const float x1, const float y1, const float x2, const float y2, const float length_scale_x, const float length_scale_y) {
+        const double dx = (x1 - x2) / length_scale_x;
+        const double dy = (y1 - y2) / length_scale_y;
+        return std::exp(-0.5 * (dx * dx + dy * dy));
+    }
+
+    size_t surrogate_row(const size_t r) {
+        // start of row r in the packed cholesky factor
+        return r * (r + 1) / 2;
+    }
+
+    Surrogate fit_surrogate(const std::vector<SurrogatePoint>& points, const float length_scale_x, const float length_scale_y, std::vector<double>& cholesky, std::vector<double>& weights) {
+        const size_t n = points.size();
+        double mean = 0;
+        for (const auto& p : points) mean += p.z;
+        mean /= static_cast<double>(n);
+        double variance = 0;
+        for (const auto& p : points) variance += (p.z - mean) * (p.z - mean);
+        const double deviation = std::max(std::sqrt(variance / static_cast<double>(n)), 1e-6);
+
+        // packed lower triangular cholesky factor of the kernel matrix, a small nugget keeps it positive definite
+        // the rows already factored don't change as points are added, so each new point appends its row in O(n^2)
+        constexpr double nugget = 1e-6;
+        size_t factored = 0;
+        while (surrogate_row(factored) < cholesky.size()) ++factored;
+        if (surrogate_row(factored) != cholesky.size() || factored > n) {
+            cholesky.clear();
+            factored = 0;
+        }
+        cholesky.resize(surrogate_row(n));
+        for (size_t r = factored; r < n; ++r) {
+            const size_t row = surrogate_row(r);
+            for (size_t c = 0; c <= r; ++c) {
+                const size_t column = surrogate_row(c);
+                double sum = surrogate_kernel(points[r].x, points[r].y, points[c].x, points[c].y, length_scale_x, length_scale_y) + (r == c ? nugget : 0);
+                for (size_t k = 0; k < c; ++k) sum -= cholesky[row + k] * cholesky[column + k];
+                cholesky[row + c] = r == c ? std::sqrt(std::max(sum, 1e-12)) : sum / cholesky[column + c];
+            }
+        }
+
+        // weights = K^-1 * normalised z, forward then back substitution, redone as the normalisation moves with every point
+        weights.resize(n);
+        for (size_t r = 0; r < n; ++r) {
+            const size_t row = surrogate_row(r);
+            double sum = (points[r].z - mean) / deviation;
+            for (size_t k = 0; k < r; ++k) sum -= cholesky[row + k] * weights[k];
+            weights[r] = sum / cholesky[row + r];
+        }
+        for (size_t r = n; r-- > 0;) {
+            double sum = weights[r];
+            for (size_t k = r + 1; k < n; ++k) sum -= cholesky[surrogate_row(k) + r] * weights[k];
+            weights[r] = sum / cholesky[surrogate_row(r) + r];
+        }
+        return { mean, deviation, length_scale_x, length_scale_y };
+    }
+
+    SurrogatePrediction predict_surrogate(const Surrogate& surrogate, const std::vector<SurrogatePoint>& points, const std::vector<double>& cholesky, const std::vector<double>& weights, const float x, const float y, std::vector<double>& kernel_column) {
+        const size_t n = points.size();
+        kernel_column.resize(n);
+        double mean = 0;
+        for (size_t k = 0; k < n; ++k) {
+            kernel_column[k] = surrogate_kernel(x, y, points[k].x, points[k].y, surrogate.length_scale_x, surrogate.length_scale_y);
+            mean += kernel_column[k] * weights[k];
+        }
+        // variance = 1 - |L^-1 k|^2, solved in place
+        double explained = 0;
+        for (size_t r = 0; r < n; ++r) {
+            const size_t row = surrogate_row(r);
+            double sum = kernel_column[r];
+            for (size_t k = 0; k < r; ++k) sum -= cholesky[row + k] * kernel_column[k];
+            kernel_column[r] = sum / cholesky[row + r];
+            explained += kernel_column[r] * kernel_column[r];
+        }
+        const double variance = std::max(1 - explained, 0.0);
+        return { static_cast<float>(surrogate.mean + mean * surrogate.deviation), static_cast<float>(std::sqrt(variance) * surrogate.deviation) };
+    }
+
+    float calculate_expected_improvement(const float min_z, const float mean, const float deviation) {
+        if (deviation <= 0) return std::max(min_z - mean, 0.0f);
+        const float u = (min_z - mean) / deviation;
+        const float cumulative = 0.5f * std::erfc(-u / std::sqrt(2.0f));
+        const float density = std::exp(-0.5f * u * u) / std::sqrt(2 * PI);
+        return (min_z - mean) * cumulative + deviation * density;
+    }
+
+    OptimiserParameters select_optimiser_parameters(const size_t x_size, const size_t y_size, const SolarOption solar_option) {
+        // bands are a grid ordered by x then y, so the first band containing the surface is its own
+        for (const TunedOptimiserParameters& tuned : tuned_optimiser_parameters) {
+            if (tuned.solar_option == static_cast<int>(solar_option) && x_size <= tuned.x_size_max && y_size <= tuned.y_size_max) {
+                return { tuned.min_step, tuned.gradient_factor, tuned.target_step };
+            }
+        }
+        return default_optimiser_parameters;
+    }
+
+    bool search_deadline_passed(const size_t combination_index) {
+        const auto deadline = search_deadlines.at(combination_index);
+        if (deadline == std::chrono::steady_clock::time_point::max() || std::chrono::steady_clock::now() < deadline) return false;
+        searches_cut_short.at(combination_index) = true;
+        return true;
+    }
 
     float min_4f(const float a, const float b, const float c, const float d) {
         float m = a;
@@ -829,7 +1684,7 @@ namespace heatninja {
         const HeatOption hp_option, const SolarOption solar_option, float& optimum_tes_npc, const int solar_maximum, const float cop_worst, const float hp_electrical_power, const float ground_temp, HeatSolarSystemSpecifications& optimal_spec, const std::array<float, 24>* temp_profile, const float thermostat_temperature, const int hot_water_temperature, const float cumulative_discount_rate, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_solar_declinations, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product) {
         constexpr float unset_z = 3.40282e+038f;
         float& z = zs.at(i + j * x_size);
-        if (z == unset_z) {
+        if (z == unset_z && !search_deadline_passed(static_cast<size_t>(hp_option) * 7 + static_cast<size_t>(solar_option))) {
             z = calculate_optimal_tariff(hp_option, solar_option, static_cast<int>(j), optimum_tes_npc, solar_maximum, static_cast<int>(i), cop_worst, hp_electrical_power, ground_temp, optimal_spec, temp_profile, thermostat_temperature, hot_water_temperature, cumulative_discount_rate, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_solar_declinations, monthly_roof_ratios_south, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product);
             if (z < min_z) min_z = z;
         }
@@ -840,7 +1695,7 @@ namespace heatninja {
         const HeatOption hp_option, const SolarOption solar_option, float& optimum_tes_npc, const int solar_maximum, const float cop_worst, const float hp_electrical_power, const float ground_temp, HeatSolarSystemSpecifications& optimal_spec, const std::array<float, 24>* temp_profile, const float thermostat_temperature, const int hot_water_temperature, const float cumulative_discount_rate, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_solar_declinations, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product) {
         constexpr float unset_z = 3.40282e+038f;
         // i = tes_option, j = solar_size
-        if (zs.at(i + j * x_size) == unset_z) {
+        if (zs.at(i + j * x_size) == unset_z && !search_deadline_passed(static_cast<size_t>(hp_option) * 7 + static_cast<size_t>(solar_option))) {
             // return what ever variable you want to optimise by (designed for npc)
             float z = calculate_optimal_tariff(hp_option, solar_option, static_cast<int>(j), optimum_tes_npc, solar_maximum, static_cast<int>(i), cop_worst, hp_electrical_power, ground_temp, optimal_spec, temp_profile, thermostat_temperature, hot_water_temperature, cumulative_discount_rate, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_solar_declinations, monthly_roof_ratios_south, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product);
             // may not need min_z
@@ -848,7 +1703,7 @@ namespace heatninja {
         }
     }
 
-    void simulate_heat_solar_combination(const HeatOption hp_option, const SolarOption solar_option, const int solar_maximum, const int tes_range, const float ground_temp, HeatSolarSystemSpecifications& optimal_spec, const std::array<float, 24>& erh_hourly_temperatures_over_day, const std::array<float, 24>& hp_hourly_temperatures_over_day, const int hot_water_temperature, const float coldest_outside_temperature_of_year, const float maximum_hourly_erh_demand, const float maximum_hourly_hp_demand, const float thermostat_temperature, const float cumulative_discount_rate, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_solar_declinations, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product) {
+    void simulate_heat_solar_combination(const HeatOption hp_option, const SolarOption solar_option, const int solar_maximum, const int tes_range, const float ground_temp, HeatSolarSystemSpecifications& optimal_spec, const std::array<float, 24>& erh_hourly_temperatures_over_day, const std::array<float, 24>& hp_hourly_temperatures_over_day, const int hot_water_temperature, const float coldest_outside_temperature_of_year, const float maximum_hourly_erh_demand, const float maximum_hourly_hp_demand, const float thermostat_temperature, const float cumulative_discount_rate, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_solar_declinations, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product, const std::vector<RepresentativeDay>& representative_days, const bool seed_only) {
 
         const std::array<float, 24>& temp_profile = select_temp_profile(hp_option, hp_hourly_temperatures_over_day, erh_hourly_temperatures_over_day);
         const float cop_ref = calculate_cop_ref(hp_option);
@@ -856,14 +1711,112 @@ namespace heatninja {
         const float hp_electrical_power = calculate_hp_electrical_power(hp_option, maximum_hourly_erh_demand, maximum_hourly_hp_demand, cop_worst, cop_ref);
         const int solar_size_range = calculate_solar_size_range(solar_option, solar_maximum);
         float optimum_tes_npc = 3.40282e+038f;
+        const size_t combination_index = static_cast<size_t>(hp_option) * 7 + static_cast<size_t>(solar_option);
+#ifdef HEATNINJA_COUNT_ALLOCATIONS
+        const size_t heap_allocations_before = thread_heap_allocations();
+#endif
+
+        if (simulation_options.output_all_specs) {
+            // worst case every point on the surface with every tariff, so the hot loop never reallocates
+            all_specs_buffers.at(combination_index).reserve(static_cast<size_t>(tes_range) * solar_size_range * 5);
+        }
+
+        if (seed_only) {
+            // the smallest system, the incumbent a time bounded search starts from
+            optimiser_scratches.at(combination_index).seed_z = calculate_optimal_tariff(hp_option, solar_option, 0, optimum_tes_npc, solar_maximum, 0, cop_worst, hp_electrical_power, ground_temp, optimal_spec, &temp_profile, thermostat_temperature, hot_water_temperature, cumulative_discount_rate, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_solar_declinations, monthly_roof_ratios_south, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product);
+            return;
+        }
+        const bool seeded = simulation_options.time_budget > 0;
+        if (seeded) optimum_tes_npc = optimal_spec.net_present_cost; // the seed stands until beaten
+
+        if (!representative_days.empty()) {
+            // coarse stage ranks every point on the representative days, fine stage runs the full year on the cheapest finalists only
+            std::vector<CoarsePoint>& coarse_points = optimiser_scratches.at(combination_index).coarse_points;
+            coarse_points.clear();
+            coarse_points.reserve(static_cast<size_t>(tes_range) * solar_size_range);
+            for (int solar_size = 0; solar_size < solar_size_range; ++solar_size) {
+                for (int tes_option = 0; tes_option < tes_range; ++tes_option) {
+                    if (search_deadline_passed(combination_index)) break; // the points ranked so far still give finalists
+                    coarse_points.push_back({ calculate_coarse_npc(hp_option, solar_option, solar_size, solar_maximum, tes_option, hp_electrical_power, ground_temp, &temp_profile, thermostat_temperature, hot_water_temperature, cumulative_discount_rate, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_roof_ratios_south, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product, representative_days), tes_option, solar_size });
+                }
+            }
+            const size_t finalists = std::min(std::max(simulation_options.representative_day_finalists, static_cast<size_t>(1)), coarse_points.size());
+            std::partial_sort(coarse_points.begin(), coarse_points.begin() + finalists, coarse_points.end(), [](const CoarsePoint& a, const CoarsePoint& b) { return a.npc < b.npc; });
+            for (size_t i = 0; i < finalists && !search_deadline_passed(combination_index); ++i) {
+                if (seeded && coarse_points[i].tes_option == 0 && coarse_points[i].solar_size == 0) continue;
+                calculate_optimal_tariff(hp_option, solar_option, coarse_points[i].solar_size, optimum_tes_npc, solar_maximum, coarse_points[i].tes_option, cop_worst, hp_electrical_power, ground_temp, optimal_spec, &temp_profile, thermostat_temperature, hot_water_temperature, cumulative_discount_rate, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_solar_declinations, monthly_roof_ratios_south, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product);
+            }
+#ifdef HEATNINJA_COUNT_ALLOCATIONS
+            combination_heap_allocations.at(combination_index) = thread_heap_allocations() - heap_allocations_before;
+#endif
+            return;
+        }
 
         // OPTIMISER ==========================================================================================
-        const size_t min_step = 3;
-        float gradient_factor = 0.2f;
-        int target_step = 7;
-        // user defined variables
         size_t x_size = static_cast<size_t>(tes_range), y_size = static_cast<size_t>(solar_size_range);
+        const OptimiserParameters optimiser_parameters = simulation_options.optimiser_parameters != nullptr ? *simulation_options.optimiser_parameters : select_optimiser_parameters(x_size, y_size, solar_option);
+        const size_t min_step = optimiser_parameters.min_step;
+        const float gradient_factor = optimiser_parameters.gradient_factor;
+        const int target_step = optimiser_parameters.target_step;
         //std::cout << "tes_range: " << tes_range << ", solar_size_range: " << solar_size_range << '\n';
+        if (x_size > 3 && y_size > 3 && simulation_options.use_surrogate_search) {
+            constexpr float unset_z = 3.40282e+038f;
+            float min_z = unset_z;
+
+            OptimiserScratch& scratch = optimiser_scratches.at(combination_index);
+            std::vector<float>& zs = scratch.zs;
+            zs.assign(x_size * y_size, unset_z);
+            if (seeded) {
+                zs.front() = scratch.seed_z; // the seed pass already evaluated the smallest system
+                min_z = zs.front();
+            }
+            std::vector<SurrogatePoint>& surrogate_points = scratch.surrogate_points;
+            surrogate_points.clear();
+            surrogate_points.reserve(zs.size());
+            scratch.surrogate_cholesky.clear();
+
+            // same starting mesh as the surface optimiser
+            const size_t x_subdivisions = std::max(x_size / target_step, min_step);
+            const size_t y_subdivisions = std::max(y_size / target_step, min_step);
+            linearly_space(static_cast<float>(x_size - 1), x_subdivisions, scratch.is);
+            linearly_space(static_cast<float>(y_size - 1), y_subdivisions, scratch.js);
+            for (const size_t j : scratch.js) {
+                for (const size_t i : scratch.is) {
+                    const float z = get_or_calculate(i, j, x_size, min_z, zs, hp_option, solar_option, optimum_tes_npc, solar_maximum, cop_worst, hp_electrical_power, ground_temp, optimal_spec, &temp_profile, thermostat_temperature, hot_water_temperature, cumulative_discount_rate, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_solar_declinations, monthly_roof_ratios_south, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product);
+                    surrogate_points.push_back({ static_cast<float>(i), static_cast<float>(j), z });
+                }
+            }
+
+            // correlation length of the starting mesh spacing
+            const float length_scale_x = static_cast<float>(x_size - 1) / x_subdivisions;
+            const float length_scale_y = static_cast<float>(y_size - 1) / y_subdivisions;
+            while (surrogate_points.size() < zs.size() && !search_deadline_passed(combination_index)) {
+                const Surrogate surrogate = fit_surrogate(surrogate_points, length_scale_x, length_scale_y, scratch.surrogate_cholesky, scratch.surrogate_weights);
+
+                // simulate the point with the highest expected improvement next
+                float max_expected_improvement = 0;
+                size_t next_index = zs.size();
+                for (size_t index = 0; index < zs.size(); ++index) {
+                    if (zs[index] != unset_z) continue;
+                    const auto [mean, deviation] = predict_surrogate(surrogate, surrogate_points, scratch.surrogate_cholesky, scratch.surrogate_weights, static_cast<float>(index % x_size), static_cast<float>(index / x_size), scratch.surrogate_kernel_column);
+                    const float expected_improvement = calculate_expected_improvement(min_z, mean, deviation);
+                    if (next_index == zs.size() || expected_improvement > max_expected_improvement) {
+                        max_expected_improvement = expected_improvement;
+                        next_index = index;
+                    }
+                }
+                if (next_index == zs.size() || max_expected_improvement < simulation_options.surrogate_improvement_threshold) break;
+
+                const size_t i = next_index % x_size, j = next_index / x_size;
+                const float z = get_or_calculate(i, j, x_size, min_z, zs, hp_option, solar_option, optimum_tes_npc, solar_maximum, cop_worst, hp_electrical_power, ground_temp, optimal_spec, &temp_profile, thermostat_temperature, hot_water_temperature, cumulative_discount_rate, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_solar_declinations, monthly_roof_ratios_south, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product);
+                surrogate_points.push_back({ static_cast<float>(i), static_cast<float>(j), z });
+            }
+#ifdef HEATNINJA_COUNT_ALLOCATIONS
+            combination_heap_allocations.at(combination_index) = thread_heap_allocations() - heap_allocations_before;
+#endif
+            return;
+        }
+
         // only use surface optimisation for surfaces larger than 3 nodes along each dimension
         if (x_size > 3 && y_size > 3 && simulation_options.use_optimisation_surfaces) {
             // non-user variables
@@ -871,17 +1824,31 @@ namespace heatninja {
             float min_z = unset_z; // record the current minimum z
             float max_mx = 0, max_my = 0; // gradient of steepest segment
 
+            OptimiserScratch& scratch = optimiser_scratches.at(combination_index);
+
             // create blank surface of z's
-            std::vector<float> zs(x_size * y_size, unset_z);
+            std::vector<float>& zs = scratch.zs;
+            zs.assign(x_size * y_size, unset_z);
+            if (seeded) {
+                zs.front() = scratch.seed_z; // the seed pass already evaluated the smallest system
+                min_z = zs.front();
+            }
 
             // calculate initial points to search on surface
             const size_t x_subdivisions = std::max(x_size / target_step, min_step);
             const size_t y_subdivisions = std::max(y_size / target_step, min_step);
-            std::vector<size_t> is = linearly_space(static_cast<float>(x_size - 1), x_subdivisions);
-            std::vector<size_t> js = linearly_space(static_cast<float>(y_size - 1), y_subdivisions);
+            std::vector<size_t>& is = scratch.is;
+            std::vector<size_t>& js = scratch.js;
+            linearly_space(static_cast<float>(x_size - 1), x_subdivisions, is);
+            linearly_space(static_cast<float>(y_size - 1), y_subdivisions, js);
 
             // combine 1D x and y indices into a 2D mesh 
-            std::vector<IndexRect> index_rects;
+            // rects on a level never overlap, so a level can't hold more rects than the surface has nodes
+            std::vector<IndexRect>& index_rects = scratch.index_rects;
+            std::vector<IndexRect>& next_index_rects = scratch.next_index_rects;
+            index_rects.clear();
+            index_rects.reserve(x_size * y_size);
+            next_index_rects.reserve(x_size * y_size);
             for (size_t j = 0; j < y_subdivisions; ++j) {
                 for (size_t i = 0; i < x_subdivisions; ++i) {
                     index_rects.emplace_back(IndexRect{ is.at(i), js.at(j), is.at(i + 1), js.at(j + 1) });
@@ -906,8 +1873,8 @@ namespace heatninja {
             max_mx *= gradient_factor;
             max_my *= gradient_factor;
 
-            while (!index_rects.empty()) {
-                std::vector<IndexRect> next_index_rects;
+            while (!index_rects.empty() && !search_deadline_passed(combination_index)) {
+                next_index_rects.clear();
                 for (IndexRect& r : index_rects) {
 
                     // calculate distance between indices
@@ -975,7 +1942,7 @@ namespace heatninja {
                         }
                     }
                 }
-                index_rects = next_index_rects;
+                std::swap(index_rects, next_index_rects);
             }
 
             if (false) {
@@ -998,6 +1965,9 @@ namespace heatninja {
                 const float efficiency = (static_cast<float>(points_searched) / static_cast<float>(zs.size())) * 100.0f;
                 std::cout << "min z: " << min_z << ", points searched: " << points_searched << ", efficiency: " << efficiency << ", gf: " << gradient_factor << ", step: " << target_step << '\n';
             }
+#ifdef HEATNINJA_COUNT_ALLOCATIONS
+            combination_heap_allocations.at(combination_index) = thread_heap_allocations() - heap_allocations_before;
+#endif
             return;
         }
 
@@ -1005,9 +1975,14 @@ namespace heatninja {
         //std::cout << "Inputs dont meeting requirements for surface optimisation. Falling back to iteration.\n";
         for (int solar_size = 0; solar_size < solar_size_range; ++solar_size) {
             for (int tes_option = 0; tes_option < tes_range; ++tes_option) {
+                if (search_deadline_passed(combination_index)) break;
+                if (seeded && tes_option == 0 && solar_size == 0) continue;
                 calculate_optimal_tariff(hp_option, solar_option, solar_size, optimum_tes_npc, solar_maximum, tes_option, cop_worst, hp_electrical_power, ground_temp, optimal_spec, &temp_profile, thermostat_temperature, hot_water_temperature, cumulative_discount_rate, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_solar_declinations, monthly_roof_ratios_south, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product);
             }
         }
+#ifdef HEATNINJA_COUNT_ALLOCATIONS
+        combination_heap_allocations.at(combination_index) = thread_heap_allocations() - heap_allocations_before;
+#endif
     }
 
     int calculate_solar_thermal_size(const SolarOption solar_option, const int solar_size) {
@@ -1035,15 +2010,17 @@ namespace heatninja {
         }
     }
 
-    float calculate_capex_heatopt(const HeatOption hp_option, const float hp_thermal_power) {
+    template <typename Scalar>
+    Scalar calculate_capex_heatopt(const HeatOption hp_option, const Scalar hp_thermal_power) {
+        using std::pow;
         switch (hp_option)
         {
         case HeatOption::ERH: // 1000 cost to install ERH, Small additional cost to TES, https://zenodo.org/record/4692649#.YQEbio5KjIV
             return 1000 + 100;
         case HeatOption::ASHP: // ASHP, https://pubs.rsc.org/en/content/articlepdf/2012/ee/c2ee22653g
-            return (200 + 4750 / std::powf(hp_thermal_power, 1.25f)) * hp_thermal_power + 1500;  // s
+            return (200 + 4750 / pow(hp_thermal_power, 1.25f)) * hp_thermal_power + 1500;  // s
         default: // GSHP, https://pubs.rsc.org/en/content/articlepdf/2012/ee/c2ee22653g
-            return (200 + 4750 / std::powf(hp_thermal_power, 1.25f)) * hp_thermal_power + 800 * hp_thermal_power;
+            return (200 + 4750 / pow(hp_thermal_power, 1.25f)) * hp_thermal_power + 800 * hp_thermal_power;
         }
     }
 
@@ -1090,7 +2067,7 @@ namespace heatninja {
 
     float calculate_capex_tes_volume(const float tes_volume_current) {
         // Formula based on this data https ://assets.publishing.service.gov.uk/government/uploads/system/uploads/attachment_data/file/545249/DELTA_EE_DECC_TES_Final__1_.pdf
-        return 2068.3f * std::powf(tes_volume_current, 0.553f);
+        return 2068.3f * std::pow(tes_volume_current, 0.553f);
     }
 
     float calculate_cumulative_discount_rate(const float discount_rate, const int npc_years) {
@@ -1120,14 +2097,7 @@ namespace heatninja {
         return ratios_roof_south;
     }
 
-    float calculate_optimal_tariff(const HeatOption hp_option, const SolarOption solar_option, const int solar_size, float& optimum_tes_npc, const int solar_maximum, const int tes_option, const float cop_worst, const float hp_electrical_power, const float ground_temp, HeatSolarSystemSpecifications& optimal_spec, const std::array<float, 24>* temp_profile, const float thermostat_temperature, const int hot_water_temperature, const float cumulative_discount_rate, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_solar_declinations, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product) {
-        // find optimal for given solar_size and tes_vol
-        const int solar_thermal_size = calculate_solar_thermal_size(solar_option, solar_size);
-        const int pv_size = calculate_pv_size(solar_option, solar_size, solar_maximum, solar_thermal_size);
-        float tes_volume_current = 0.1f + tes_option * 0.1f; // m3
-        const float hp_thermal_power = hp_electrical_power * calculate_cop_ref(hp_option); // hp option
-        const float capex = calculate_capex_heatopt(hp_option, hp_thermal_power) + calculate_capex_pv(solar_option, pv_size) + calculate_capex_solar_thermal(solar_option, solar_thermal_size) + calculate_capex_tes_volume(tes_volume_current);
-
+    TesCharges calculate_tes_charges(const float tes_volume_current, const int hot_water_temperature) {
         const float tes_radius = std::pow((tes_volume_current / (2 * PI)), (1.0f / 3.0f));  //For cylinder with height = 2x radius
         const float tes_charge_full = tes_volume_current * 1000 * 4.18f * (hot_water_temperature - 40) / 3600; // 40 min temp
         const float tes_charge_boost = tes_volume_current * 1000 * 4.18f * (60 - 40) / 3600; //  # kWh, 60C HP with PV boost
@@ -1136,48 +2106,239 @@ namespace heatninja {
         const float tes_charge_min = 10 * 4.18f * (hot_water_temperature - 10) / 3600; // 10litres hot min amount
         //CWT coming in from DHW re - fill, accounted for by DHW energy out, DHW min useful temperature 40C
         //Space heating return temperature would also be ~40C with flow at 51C
+        return { tes_radius, tes_charge_full, tes_charge_boost, tes_charge_max, tes_charge_min };
+    }
 
+    template <typename TraceSink, size_t steps_per_hour, typename Scalar>
+    BasicYearlyOperation<Scalar> simulate_heating_system_for_year(const std::array<Scalar, 24>* temp_profile, const Scalar thermostat_temperature, const TesCharges& tes_charges, const float ground_temp, const HeatOption hp_option, const SolarOption solar_option, const int pv_size, const int solar_thermal_size, const Scalar hp_electrical_power, const Tariff tariff, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const Scalar heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int hot_water_temperature, const int grid_emissions, const Scalar solar_gain_house_factor, const float body_heat_gain, const Scalar house_size_thermal_transmittance_product, TraceSink& trace_sink) {
         constexpr std::array<int, 12> days_in_months = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
 
+        size_t step_year_counter = 0;
+        Scalar inside_temp_current = thermostat_temperature;  // Initial temp
+        float solar_thermal_generation_total = 0;
+        Scalar operational_costs_peak = 0;
+        Scalar operational_costs_off_peak = 0;
+        Scalar operation_emissions = 0;
+
+        Scalar tes_state_of_charge = tes_charges.full;  // kWh, for H2O, starts full to prevent initial demand spike
+        // https ://www.sciencedirect.com/science/article/pii/S0306261916302045
+
+        int month = 0;
+        for (int days_in_month : days_in_months) {
+            float ratio_sg_south = monthly_solar_gain_ratios_south.at(month);
+            float ratio_sg_north = monthly_solar_gain_ratios_north.at(month);
+            float cwt_current = monthly_cold_water_temperatures.at(month);
+            float dhw_mf_current = dhw_monthly_factors.at(month);
+            float ratio_roof_south = monthly_roof_ratios_south.at(month);
+
+            for (size_t day = 0; day < days_in_month; ++day) {
+                simulate_heating_system_for_day<TraceSink, steps_per_hour, Scalar>(temp_profile, inside_temp_current, ratio_sg_south, ratio_sg_north, cwt_current, dhw_mf_current, tes_state_of_charge, tes_charges.full, tes_charges.boost, tes_charges.max, tes_charges.radius, ground_temp, hp_option, solar_option, pv_size, solar_thermal_size, hp_electrical_power, tariff, operational_costs_peak, operational_costs_off_peak, operation_emissions, solar_thermal_generation_total, ratio_roof_south, tes_charges.min, step_year_counter, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, hot_water_temperature, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product, trace_sink);
+            }
+            ++month;
+        }
+        return { operational_costs_peak, operational_costs_off_peak, operation_emissions };
+    }
+
+    std::vector<RepresentativeDay> select_representative_days(const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const size_t clusters) {
+        // k-means over each day's hourly temperatures & irradiances plus its position in the year,
+        // each cluster is represented by its closest real day and weighted by the number of days in it
+        constexpr std::array<int, 12> days_in_months = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        constexpr size_t days = 365;
+        constexpr size_t features = 24 * 2 + 2;
+        constexpr float temperature_scale = 1.0f / 2.0f; // 2 C counts as much as
+        constexpr float irradiance_scale = 1.0f / 50.0f; // 50 W/m2
+        constexpr float season_scale = 4.0f; // keeps clusters within a season, as monthly factors differ
+
+        std::vector<std::array<float, features>> day_features(days);
+        for (size_t day = 0; day < days; ++day) {
+            for (size_t hour = 0; hour < 24; ++hour) {
+                day_features[day][hour] = hourly_outside_temperatures_over_year.at(day * 24 + hour) * temperature_scale;
+                day_features[day][24 + hour] = hourly_solar_irradiances_over_year.at(day * 24 + hour) * irradiance_scale;
+            }
+            const float angle = 2 * PI * static_cast<float>(day) / days;
+            day_features[day][48] = std::cos(angle) * season_scale;
+            day_features[day][49] = std::sin(angle) * season_scale;
+        }
+
+        auto distance_squared = [](const std::array<float, features>& a, const std::array<float, features>& b) {
+            float d = 0;
+            for (size_t f = 0; f < features; ++f) d += (a[f] - b[f]) * (a[f] - b[f]);
+            return d;
+        };
+
+        // deterministic start, evenly spaced through the year
+        const size_t k = std::min(std::max(clusters, static_cast<size_t>(1)), days);
+        std::vector<std::array<float, features>> centroids(k);
+        for (size_t c = 0; c < k; ++c) centroids[c] = day_features[c * days / k + days / (2 * k)];
+
+        std::vector<size_t> assignments(days, 0);
+        for (int iteration = 0; iteration < 50; ++iteration) {
+            bool changed = false;
+            for (size_t day = 0; day < days; ++day) {
+                size_t nearest = 0;
+                float nearest_distance = distance_squared(day_features[day], centroids[0]);
+                for (size_t c = 1; c < k; ++c) {
+                    const float d = distance_squared(day_features[day], centroids[c]);
+                    if (d < nearest_distance) {
+                        nearest_distance = d;
+                        nearest = c;
+                    }
+                }
+                if (assignments[day] != nearest) changed = true;
+                assignments[day] = nearest;
+            }
+            if (!changed && iteration > 0) break;
+
+            std::vector<size_t> counts(k, 0);
+            for (auto& centroid : centroids) centroid.fill(0);
+            for (size_t day = 0; day < days; ++day) {
+                for (size_t f = 0; f < features; ++f) centroids[assignments[day]][f] += day_features[day][f];
+                ++counts[assignments[day]];
+            }
+            for (size_t c = 0; c < k; ++c) {
+                if (counts[c] == 0) continue; // empty cluster, dropped below
+                for (float& f : centroids[c]) f /= static_cast<float>(counts[c]);
+            }
+        }
+
+        std::array<int, days> months{};
+        size_t day_of_year = 0;
+        for (int month = 0; month < 12; ++month) {
+            for (int day = 0; day < days_in_months.at(month); ++day) months[day_of_year++] = month;
+        }
+
+        std::vector<RepresentativeDay> representative_days;
+        for (size_t c = 0; c < k; ++c) {
+            size_t medoid = days;
+            float medoid_distance = 0;
+            int weight = 0;
+            for (size_t day = 0; day < days; ++day) {
+                if (assignments[day] != c) continue;
+                ++weight;
+                const float d = distance_squared(day_features[day], centroids[c]);
+                if (medoid == days || d < medoid_distance) {
+                    medoid = day;
+                    medoid_distance = d;
+                }
+            }
+            if (weight > 0) representative_days.push_back({ static_cast<int>(medoid), months[medoid], static_cast<float>(weight) });
+        }
+        // simulated in calendar order so the house & tank state carries over sensibly
+        std::sort(representative_days.begin(), representative_days.end(), [](const RepresentativeDay& a, const RepresentativeDay& b) { return a.day_of_year < b.day_of_year; });
+        return representative_days;
+    }
+
+    template <size_t steps_per_hour>
+    YearlyOperation simulate_heating_system_for_representative_days(const std::vector<RepresentativeDay>& representative_days, const std::array<float, 24>* temp_profile, const float thermostat_temperature, const TesCharges& tes_charges, const float ground_temp, const HeatOption hp_option, const SolarOption solar_option, const int pv_size, const int solar_thermal_size, const float hp_electrical_power, const Tariff tariff, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int hot_water_temperature, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product) {
+        // same as simulate_heating_system_for_year, over the representative days only with each day's costs & emissions scaled by its weight
+        float inside_temp_current = thermostat_temperature;  // Initial temp
+        float solar_thermal_generation_total = 0;
+        float operational_costs_peak = 0;
+        float operational_costs_off_peak = 0;
+        float operation_emissions = 0;
+
+        float tes_state_of_charge = tes_charges.full;  // kWh, for H2O, starts full to prevent initial demand spike
+
+        NullTraceSink null_trace_sink;
+        for (const RepresentativeDay& representative_day : representative_days) {
+            const int month = representative_day.month;
+            float ratio_sg_south = monthly_solar_gain_ratios_south.at(month);
+            float ratio_sg_north = monthly_solar_gain_ratios_north.at(month);
+            float cwt_current = monthly_cold_water_temperatures.at(month);
+            float dhw_mf_current = dhw_monthly_factors.at(month);
+            float ratio_roof_south = monthly_roof_ratios_south.at(month);
+
+            size_t step_year_counter = static_cast<size_t>(representative_day.day_of_year) * 24 * steps_per_hour;
+            float day_costs_peak = 0, day_costs_off_peak = 0, day_emissions = 0;
+            simulate_heating_system_for_day<NullTraceSink, steps_per_hour>(temp_profile, inside_temp_current, ratio_sg_south, ratio_sg_north, cwt_current, dhw_mf_current, tes_state_of_charge, tes_charges.full, tes_charges.boost, tes_charges.max, tes_charges.radius, ground_temp, hp_option, solar_option, pv_size, solar_thermal_size, hp_electrical_power, tariff, day_costs_peak, day_costs_off_peak, day_emissions, solar_thermal_generation_total, ratio_roof_south, tes_charges.min, step_year_counter, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, hot_water_temperature, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product, null_trace_sink);
+            operational_costs_peak += day_costs_peak * representative_day.weight;
+            operational_costs_off_peak += day_costs_off_peak * representative_day.weight;
+            operation_emissions += day_emissions * representative_day.weight;
+        }
+        return { operational_costs_peak, operational_costs_off_peak, operation_emissions };
+    }
+
+    // calls simulate with the simulation's steps per hour as a compile time constant, so the hourly kernels keep their fixed trip counts
+    template <typename Simulate>
+    auto with_steps_per_hour(const Simulate& simulate) {
+        if (simulation_options.steps_per_hour == 2) return simulate(std::integral_constant<size_t, 2>());
+        return simulate(std::integral_constant<size_t, 1>());
+    }
+
+    float calculate_optimal_tariff(const HeatOption hp_option, const SolarOption solar_option, const int solar_size, float& optimum_tes_npc, const int solar_maximum, const int tes_option, const float cop_worst, const float hp_electrical_power, const float ground_temp, HeatSolarSystemSpecifications& optimal_spec, const std::array<float, 24>* temp_profile, const float thermostat_temperature, const int hot_water_temperature, const float cumulative_discount_rate, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_solar_declinations, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product) {
+        // find optimal for given solar_size and tes_vol
+        ++combination_evaluations.at(static_cast<size_t>(hp_option) * 7 + static_cast<size_t>(solar_option));
+        const int solar_thermal_size = calculate_solar_thermal_size(solar_option, solar_size);
+        const int pv_size = calculate_pv_size(solar_option, solar_size, solar_maximum, solar_thermal_size);
+        float tes_volume_current = 0.1f + tes_option * 0.1f; // m3
+        const float hp_thermal_power = hp_electrical_power * calculate_cop_ref(hp_option); // hp option
+        const float capex = calculate_capex_heatopt(hp_option, hp_thermal_power) + calculate_capex_pv(solar_option, pv_size) + calculate_capex_solar_thermal(solar_option, solar_thermal_size) + calculate_capex_tes_volume(tes_volume_current);
+
+        const TesCharges tes_charges = calculate_tes_charges(tes_volume_current, hot_water_temperature);
+
         float optimum_tariff = 1000000;
         float min_npc = 1000000;
+        NullTraceSink null_trace_sink;
+        std::array<YearlyOperation, 5> tariff_operations;
         for (int tariff_int = 0; tariff_int < 5; ++tariff_int) {
             Tariff tariff = static_cast<Tariff>(tariff_int);
-            size_t hour_year_counter = 0;
-            //std::cout << "here\n";
-            float inside_temp_current = thermostat_temperature;  // Initial temp
-            float solar_thermal_generation_total = 0;
-            float operational_costs_peak = 0;
-            float operational_costs_off_peak = 0;
-            float operation_emissions = 0;
-
-            //(hp_option == HeatOption::ERH && solar_option == SolarOption::FP_PV && pv_size == 6 && solar_thermal_size == 8 && tes_volume_current == 0.2f)
-
-            float tes_state_of_charge = tes_charge_full;  // kWh, for H2O, starts full to prevent initial demand spike
-            // https ://www.sciencedirect.com/science/article/pii/S0306261916302045
-
-            int month = 0;
-            for (int days_in_month : days_in_months) {
-                float ratio_sg_south = monthly_solar_gain_ratios_south.at(month);
-                float ratio_sg_north = monthly_solar_gain_ratios_north.at(month);
-                float cwt_current = monthly_cold_water_temperatures.at(month);
-                float dhw_mf_current = dhw_monthly_factors.at(month);
-
-                const float solar_declination_current = monthly_solar_declinations.at(month);
-                float ratio_roof_south = monthly_roof_ratios_south.at(month);
-
-                for (size_t day = 0; day < days_in_month; ++day) {
-                    simulate_heating_system_for_day(temp_profile, inside_temp_current, ratio_sg_south, ratio_sg_north, cwt_current, dhw_mf_current, tes_state_of_charge, tes_charge_full, tes_charge_boost, tes_charge_max, tes_radius, ground_temp, hp_option, solar_option, pv_size, solar_thermal_size, hp_electrical_power, tariff, operational_costs_peak, operational_costs_off_peak, operation_emissions, solar_thermal_generation_total, ratio_roof_south, tes_charge_min, hour_year_counter, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, hot_water_temperature, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product);
-                }
-                ++month;
+            tariff_operations.at(tariff_int) = with_steps_per_hour([&](auto steps) {
+                return simulate_heating_system_for_year<NullTraceSink, decltype(steps)::value>(temp_profile, thermostat_temperature, tes_charges, ground_temp, hp_option, solar_option, pv_size, solar_thermal_size, hp_electrical_power, tariff, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_roof_ratios_south, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, hot_water_temperature, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product, null_trace_sink);
+                });
+        }
+
+        // with a weather ensemble the tariff is chosen on the first year, as the tariffs' ranking barely moves with the weather,
+        // only it is run over the other years & the spec is costed, recorded & returned with the means over all of them
+        int ensemble_tariff = -1;
+        float worst_operational_cost = 0;
+        if (!ensemble_weather_years.empty()) {
+            const auto operational_cost = [](const YearlyOperation& operation) { return operation.operational_costs_peak + operation.operational_costs_off_peak; };
+            ensemble_tariff = static_cast<int>(std::min_element(tariff_operations.begin(), tariff_operations.end(), [&](const YearlyOperation& a, const YearlyOperation& b) { return operational_cost(a) < operational_cost(b); }) - tariff_operations.begin());
+            const Tariff tariff = static_cast<Tariff>(ensemble_tariff);
+            YearlyOperation& ensemble_operation = tariff_operations.at(ensemble_tariff);
+            worst_operational_cost = operational_cost(ensemble_operation);
+
+            // as tasks of their own when multithreading, the combinations alone may not fill the cores
+            std::vector<YearlyOperation>& year_operations = optimiser_scratches.at(static_cast<size_t>(hp_option) * 7 + static_cast<size_t>(solar_option)).year_operations;
+            const auto simulate_ensemble_year = [&](const EnsembleWeatherYear& ensemble_weather_year) {
+                const size_t year = static_cast<size_t>(&ensemble_weather_year - ensemble_weather_years.data());
+                year_operations.at(year) = with_steps_per_hour([&](auto steps) {
+                    return simulate_heating_system_for_year<NullTraceSink, decltype(steps)::value>(temp_profile, thermostat_temperature, tes_charges, ground_temp, hp_option, solar_option, pv_size, solar_thermal_size, hp_electrical_power, tariff, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_roof_ratios_south, ensemble_weather_year.outside_temperatures, ensemble_weather_year.solar_irradiances, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, hot_water_temperature, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product, null_trace_sink);
+                    });
+            };
+#ifndef EM_COMPATIBLE
+            if (simulation_options.use_multithreading) std::for_each(std::execution::par, ensemble_weather_years.begin(), ensemble_weather_years.end(), simulate_ensemble_year);
+            else std::for_each(ensemble_weather_years.begin(), ensemble_weather_years.end(), simulate_ensemble_year);
+#else
+            std::for_each(ensemble_weather_years.begin(), ensemble_weather_years.end(), simulate_ensemble_year);
+#endif
+            for (const YearlyOperation& year_operation : year_operations) {
+                ensemble_operation.operational_costs_peak += year_operation.operational_costs_peak;
+                ensemble_operation.operational_costs_off_peak += year_operation.operational_costs_off_peak;
+                ensemble_operation.operation_emissions += year_operation.operation_emissions;
+                worst_operational_cost = std::max(worst_operational_cost, operational_cost(year_operation));
             }
+            const float years = static_cast<float>(year_operations.size() + 1);
+            ensemble_operation.operational_costs_peak /= years;
+            ensemble_operation.operational_costs_off_peak /= years;
+            ensemble_operation.operation_emissions /= years;
+        }
+
+        for (int tariff_int = 0; tariff_int < 5; ++tariff_int) {
+            if (ensemble_tariff >= 0 && tariff_int != ensemble_tariff) continue;
+            Tariff tariff = static_cast<Tariff>(tariff_int);
+            const auto [operational_costs_peak, operational_costs_off_peak, operation_emissions] = tariff_operations.at(tariff_int);
 
             const float total_operational_cost = operational_costs_peak + operational_costs_off_peak; // tariff
             const float npc = capex + total_operational_cost * cumulative_discount_rate;
 
             if (simulation_options.output_all_specs) {
                 const float net_present_cost_current = capex + total_operational_cost * cumulative_discount_rate;
-                write_optimal_specification({ hp_option, solar_option, pv_size, solar_thermal_size, tes_volume_current, tariff, total_operational_cost, capex,  net_present_cost_current, operation_emissions }, all_specs_file);
+                all_specs_buffers.at(static_cast<size_t>(hp_option) * 7 + static_cast<size_t>(solar_option)).push_back({ hp_option, solar_option, pv_size, solar_thermal_size, tes_volume_current, tariff, total_operational_cost, capex,  net_present_cost_current, operation_emissions });
+            }
+
+            if (simulation_options.output_pareto_frontiers) {
+                update_pareto_frontier(pareto_frontiers.at(static_cast<size_t>(hp_option) * 7 + static_cast<size_t>(solar_option)), { hp_option, solar_option, pv_size, solar_thermal_size, tes_volume_current, tariff, total_operational_cost, capex, npc, operation_emissions }, simulation_options.pareto_against_capex);
             }
 
             if (npc < min_npc) min_npc = npc;
@@ -1190,33 +2351,58 @@ namespace heatninja {
                 if (net_present_cost_current < optimum_tes_npc) {
                     // Lowest cost TES & tariff for heating tech. For OpEx vs CapEx plots, with optimised TES and tariff
                     optimum_tes_npc = net_present_cost_current;
-                    optimal_spec = { hp_option, solar_option, pv_size, solar_thermal_size, tes_volume_current, tariff, total_operational_cost, capex,  net_present_cost_current, operation_emissions };
+                    optimal_spec = { hp_option, solar_option, pv_size, solar_thermal_size, tes_volume_current, tariff, total_operational_cost, capex,  net_present_cost_current, operation_emissions, capex + (ensemble_tariff >= 0 ? worst_operational_cost : total_operational_cost) * cumulative_discount_rate };
                 }
             }
         }
         return min_npc;
     }
 
-    void calculate_inside_temp_change(float& inside_temp_current, const float outside_temp_current, const float solar_irradiance_current, const float ratio_sg_south, const float ratio_sg_north, const float ratio_roof_south, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product, const float heat_capacity) {
+    float calculate_coarse_npc(const HeatOption hp_option, const SolarOption solar_option, const int solar_size, const int solar_maximum, const int tes_option, const float hp_electrical_power, const float ground_temp, const std::array<float, 24>* temp_profile, const float thermostat_temperature, const int hot_water_temperature, const float cumulative_discount_rate, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product, const std::vector<RepresentativeDay>& representative_days) {
+        // cheapest npc over the tariffs on the representative days, only used to rank points, records nothing
+        const int solar_thermal_size = calculate_solar_thermal_size(solar_option, solar_size);
+        const int pv_size = calculate_pv_size(solar_option, solar_size, solar_maximum, solar_thermal_size);
+        const float tes_volume_current = 0.1f + tes_option * 0.1f; // m3
+        const float hp_thermal_power = hp_electrical_power * calculate_cop_ref(hp_option);
+        const float capex = calculate_capex_heatopt(hp_option, hp_thermal_power) + calculate_capex_pv(solar_option, pv_size) + calculate_capex_solar_thermal(solar_option, solar_thermal_size) + calculate_capex_tes_volume(tes_volume_current);
+
+        const TesCharges tes_charges = calculate_tes_charges(tes_volume_current, hot_water_temperature);
+
+        float min_npc = 1000000;
+        for (int tariff_int = 0; tariff_int < 5; ++tariff_int) {
+            Tariff tariff = static_cast<Tariff>(tariff_int);
+            const auto [operational_costs_peak, operational_costs_off_peak, operation_emissions] = with_steps_per_hour([&](auto steps) {
+                return simulate_heating_system_for_representative_days<decltype(steps)::value>(representative_days, temp_profile, thermostat_temperature, tes_charges, ground_temp, hp_option, solar_option, pv_size, solar_thermal_size, hp_electrical_power, tariff, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_roof_ratios_south, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, hot_water_temperature, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product);
+                });
+            const float npc = capex + (operational_costs_peak + operational_costs_off_peak) * cumulative_discount_rate;
+            if (npc < min_npc) min_npc = npc;
+        }
+        return min_npc;
+    }
+
+    template <typename Scalar>
+    void calculate_inside_temp_change(Scalar& inside_temp_current, const float outside_temp_current, const float solar_irradiance_current, const float ratio_sg_south, const float ratio_sg_north, const float ratio_roof_south, const Scalar solar_gain_house_factor, const float body_heat_gain, const Scalar house_size_thermal_transmittance_product, const Scalar heat_capacity) {
         const float incident_irradiance_sg_s = solar_irradiance_current * ratio_sg_south;
         const float incident_irradiance_sg_n = solar_irradiance_current * ratio_sg_north;
-        const float solar_gain_south = incident_irradiance_sg_s * solar_gain_house_factor;
-        const float solar_gain_north = incident_irradiance_sg_n * solar_gain_house_factor;
+        const Scalar solar_gain_south = incident_irradiance_sg_s * solar_gain_house_factor;
+        const Scalar solar_gain_north = incident_irradiance_sg_n * solar_gain_house_factor;
 
         //float solar_irradiance_current = Solar_Irradiance[Weather_Count]
         //const float heat_loss = (house_size * thermal_transmittance * (inside_temp_current - outside_temp_current)) / 1000;
-        const float heat_loss = house_size_thermal_transmittance_product * (inside_temp_current - outside_temp_current);
+        const Scalar heat_loss = house_size_thermal_transmittance_product * (inside_temp_current - outside_temp_current);
 
         // heat_flow_out in kWh, +ve means heat flows out of building, -ve heat flows into building
         inside_temp_current += (-heat_loss + solar_gain_south + solar_gain_north + body_heat_gain) / heat_capacity;
     }
 
-    TesTempAndHeight::TesTempAndHeight(const float upper_temperature, const float lower_temperature, const float thermocline_height)
+    template <typename Scalar>
+    BasicTesTempAndHeight<Scalar>::BasicTesTempAndHeight(const float upper_temperature, const float lower_temperature, const Scalar thermocline_height)
         : upper_temperature(upper_temperature), lower_temperature(lower_temperature), thermocline_height(clamp_height(thermocline_height)) {
 
     }
 
-    float TesTempAndHeight::clamp_height(const float height) {
+    template <typename Scalar>
+    Scalar BasicTesTempAndHeight<Scalar>::clamp_height(const Scalar height) {
         if (height < 0) {
             return 0;
         }
@@ -1228,7 +2414,8 @@ namespace heatninja {
         }
     }
 
-    TesTempAndHeight calculate_tes_temp_and_thermocline_height(const float tes_state_of_charge, const float tes_charge_full, const float tes_charge_max, const float tes_charge_boost, const float cwt_current) {
+    template <typename Scalar>
+    BasicTesTempAndHeight<Scalar> calculate_tes_temp_and_thermocline_height(const Scalar tes_state_of_charge, const float tes_charge_full, const float tes_charge_max, const float tes_charge_boost, const float cwt_current) {
         if (tes_state_of_charge <= tes_charge_full) {  // Currently at nominal temperature ranges
             // tes_lower_temperature Bottom of the tank would still be at CWT,
             // tes_thermocline_height %, from top down, .25 is top 25 %
@@ -1303,12 +2490,13 @@ namespace heatninja {
         }
     }
 
-    float calculate_hourly_space_demand(float& inside_temp_current, const float desired_min_temp_current, const float cop_current, const float tes_state_of_charge, const float dhw_hr_demand, const float hp_electrical_power, const float heat_capacity) {
+    template <typename Scalar>
+    Scalar calculate_hourly_space_demand(Scalar& inside_temp_current, const Scalar desired_min_temp_current, const float cop_current, const Scalar tes_state_of_charge, const float dhw_hr_demand, const Scalar hp_electrical_power, const Scalar heat_capacity) {
         if (inside_temp_current > desired_min_temp_current) {
             return 0;
         }
         else {
-            float space_hr_demand = (desired_min_temp_current - inside_temp_current) * heat_capacity;
+            Scalar space_hr_demand = (desired_min_temp_current - inside_temp_current) * heat_capacity;
             //std::cout << space_hr_demand << ' ' << desired_min_temp_current << ' ' << inside_temp_current << '\n';
             if ((space_hr_demand + dhw_hr_demand) < (tes_state_of_charge + hp_electrical_power * cop_current)) {
                 inside_temp_current = desired_min_temp_current;
@@ -1327,14 +2515,15 @@ namespace heatninja {
         }
     }
 
-    float calculate_electrical_demand_for_heating(float& tes_state_of_charge, const float space_water_demand, const float hp_electrical_power, const float cop_current) {
+    template <typename Scalar>
+    Scalar calculate_electrical_demand_for_heating(Scalar& tes_state_of_charge, const Scalar space_water_demand, const Scalar hp_electrical_power, const float cop_current) {
         if (space_water_demand < tes_state_of_charge) { // TES can provide all demand
             tes_state_of_charge -= space_water_demand;
             return 0;
         }
         else if (space_water_demand < (tes_state_of_charge + hp_electrical_power * cop_current)) {
             if (tes_state_of_charge > 0) {
-                const float electrical_demand_current = (space_water_demand - tes_state_of_charge) / cop_current;;
+                const Scalar electrical_demand_current = (space_water_demand - tes_state_of_charge) / cop_current;;
                 tes_state_of_charge = 0;  // TES needs support so taken to empty if it had any charge
                 return electrical_demand_current;
             }
@@ -1348,7 +2537,8 @@ namespace heatninja {
         }
     }
 
-    void calculate_electrical_demand_for_tes_charging(float& electrical_demand_current, float& tes_state_of_charge, const float tes_charge_full, const Tariff tariff, const int hour, const float hp_electrical_power, const float cop_current, const float agile_tariff_current) {
+    template <typename Scalar>
+    void calculate_electrical_demand_for_tes_charging(Scalar& electrical_demand_current, Scalar& tes_state_of_charge, const float tes_charge_full, const Tariff tariff, const int hour, const Scalar hp_electrical_power, const float cop_current, const float agile_tariff_current) {
         // Charges TES at off peak electricity times
         if (tes_state_of_charge < tes_charge_full &&
             ((tariff == Tariff::FlatRate && 12 < hour && hour < 16) ||
@@ -1370,9 +2560,10 @@ namespace heatninja {
         }
     }
 
-    void boost_tes_and_electrical_demand(float& tes_state_of_charge, float& electrical_demand_current, const float pv_remaining_current, const float tes_charge_boost, const float hp_electrical_power, const float cop_boost) {
+    template <typename Scalar>
+    void boost_tes_and_electrical_demand(Scalar& tes_state_of_charge, Scalar& electrical_demand_current, const Scalar pv_remaining_current, const float tes_charge_boost, const Scalar hp_electrical_power, const float cop_boost) {
         //Boost temperature if any spare PV generated electricity, as reduced cop, raises to nominal temp above first
-        const float tes_boost_state_charge_diff = tes_charge_boost - tes_state_of_charge;
+        const Scalar tes_boost_state_charge_diff = tes_charge_boost - tes_state_of_charge;
         if (pv_remaining_current > 0 && tes_boost_state_charge_diff > 0) {
             if ((tes_boost_state_charge_diff < (pv_remaining_current * cop_boost)) && (tes_boost_state_charge_diff < ((hp_electrical_power - electrical_demand_current) * cop_boost))) {
                 electrical_demand_current += tes_boost_state_charge_diff / cop_boost;
@@ -1389,7 +2580,8 @@ namespace heatninja {
         }
     }
 
-    void recharge_tes_to_minimum(float& tes_state_of_charge, float& electrical_demand_current, const float tes_charge_min, const float hp_electrical_power, const float cop_current) {
+    template <typename Scalar>
+    void recharge_tes_to_minimum(Scalar& tes_state_of_charge, Scalar& electrical_demand_current, const float tes_charge_min, const Scalar hp_electrical_power, const float cop_current) {
         if (tes_state_of_charge < tes_charge_min) { // Take back up to 10L capacity if possible no matter what time
             if ((tes_charge_min - tes_state_of_charge) < (hp_electrical_power - electrical_demand_current) * cop_current) {
                 electrical_demand_current += (tes_charge_min - tes_state_of_charge) / cop_current;
@@ -1401,7 +2593,171 @@ namespace heatninja {
         }
     }
 
-    void add_electrical_import_cost_to_opex(float& operational_costs_off_peak, float& operational_costs_peak, const float electrical_import, const Tariff tariff, const float agile_tariff_current, const int hour) {
+    template <size_t steps_per_hour>
+    std::array<float, 24 * steps_per_hour> plan_tes_charging(const std::array<float, 24>* temp_profile, float inside_temp_current, const float ratio_sg_south, const float ratio_sg_north, const float cwt_current, const float dhw_mf_current, const float tes_state_of_charge, const float tes_charge_full, const float tes_charge_boost, const float tes_charge_max, const float tes_radius, const float ground_temp, const HeatOption hp_option, const SolarOption solar_option, const int pv_size, const int solar_thermal_size, const float hp_electrical_power, const Tariff tariff, const float ratio_roof_south, const size_t step_year_counter, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int hot_water_temperature, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product) {
+        // the state of charge is discretised between empty & the pv boost charge, the heat pump can't charge above it
+        constexpr size_t levels = 16;
+        constexpr size_t steps_per_day = 24 * steps_per_hour;
+        constexpr size_t horizon_max = 32 * steps_per_hour; // the day, then the following night's cheap hours to value what is left in the tes
+        constexpr float step_hours = 1.0f / steps_per_hour;
+        const size_t horizon = std::min(horizon_max, hourly_outside_temperatures_over_year.size() - step_year_counter);
+        const float step_hp_electrical_power = hp_electrical_power * step_hours;
+        const float level_step = tes_charge_boost / (levels - 1);
+        std::array<float, levels> level_charges;
+        for (size_t i = 0; i < levels; ++i) level_charges.at(i) = level_step * i;
+
+        const float pi_d = PI * tes_radius * 2;
+        const float pi_r2 = PI * tes_radius * tes_radius;
+        const float pi_d2 = pi_d * tes_radius * 2;
+        // the losses of simulate_heating_system_for_day split into a part set by the state of charge less one proportional to the inside temperature
+        const float losses_per_inside_degree = u_value * (pi_d2 + 2 * pi_r2) * step_hours;
+        const auto tes_losses_at_zero_degrees = [&](const float state_of_charge) {
+            const auto [tes_upper_temperature, tes_lower_temperature, tes_thermocline_height] = calculate_tes_temp_and_thermocline_height(state_of_charge, tes_charge_full, tes_charge_max, tes_charge_boost, cwt_current);
+            return (tes_upper_temperature * u_value * (pi_d2 * tes_thermocline_height + pi_r2) + tes_lower_temperature * u_value * (pi_d2 * (1 - tes_thermocline_height) + pi_r2)) * step_hours;
+        };
+        std::array<float, levels> level_losses_at_zero_degrees;
+        for (size_t i = 0; i < levels; ++i) level_losses_at_zero_degrees.at(i) = tes_losses_at_zero_degrees(level_charges.at(i));
+
+        // forecast of each step assuming the house is kept at its profile & the tes at nominal temperatures, with this month's factors throughout
+        std::array<float, horizon_max> heat_demands, tes_available_offsets, pv_generations, inverse_cops, inverse_cop_boosts, import_prices, export_prices;
+        for (size_t h = 0; h < horizon; ++h) {
+            const size_t hour = h / steps_per_hour % 24;
+            const float outside_temp_current = hourly_outside_temperatures_over_year.at(step_year_counter + h);
+            const float solar_irradiance_current = hourly_solar_irradiances_over_year.at(step_year_counter + h);
+            const float agile_tariff_current = agile_tariff_per_hour_over_year.at(step_year_counter + h);
+            calculate_inside_temp_change(inside_temp_current, outside_temp_current, solar_irradiance_current, ratio_sg_south, ratio_sg_north, ratio_roof_south, solar_gain_house_factor * step_hours, body_heat_gain * step_hours, house_size_thermal_transmittance_product * step_hours, heat_capacity);
+            const float desired_min_temp_current = temp_profile->at(hour);
+            const float space_hr_demand = std::max(desired_min_temp_current - inside_temp_current, 0.0f) * heat_capacity;
+            inside_temp_current = std::max(inside_temp_current, desired_min_temp_current);
+            const float dhw_hr_demand = (average_daily_hot_water_volume * 4.18f * (hot_water_temperature - cwt_current) / 3600) * dhw_mf_current * hot_water_hourly_ratios.at(hour) * step_hours;
+            heat_demands.at(h) = space_hr_demand + dhw_hr_demand;
+
+            const auto [cop_current, cop_boost] = calculate_cop_current_and_boost(hp_option, outside_temp_current, ground_temp, hot_water_temperature);
+            inverse_cops.at(h) = 1 / cop_current;
+            inverse_cop_boosts.at(h) = 1 / cop_boost;
+            const float incident_irradiance_roof_south = solar_irradiance_current * ratio_roof_south / 1000;
+            pv_generations.at(h) = pv_size * calculate_pv_efficiency(solar_option, 51, cwt_current) * incident_irradiance_roof_south * 0.8f * step_hours;
+            const float solar_thermal_generation_current = calculate_solar_thermal_generation_current(solar_option, 51, cwt_current, solar_thermal_size, incident_irradiance_roof_south, outside_temp_current) * step_hours;
+            // added to a state of charge less its losses at 0C to give what the tes has before the demand
+            tes_available_offsets.at(h) = losses_per_inside_degree * inside_temp_current + solar_thermal_generation_current;
+
+            // the tariff's price of a kWh imported & its value exported
+            float import_peak = 0, import_off_peak = 0, export_peak = 0, export_off_peak = 0;
+            add_electrical_import_cost_to_opex(import_off_peak, import_peak, 1.0f, tariff, agile_tariff_current, static_cast<int>(hour));
+            subtract_pv_revenue_from_opex(export_off_peak, export_peak, 1.0f, tariff, agile_tariff_current, static_cast<int>(hour));
+            import_prices.at(h) = import_peak + import_off_peak;
+            export_prices.at(h) = -(export_peak + export_off_peak);
+        }
+
+        // what is left of the tes after the step's losses, solar thermal & demand, and the electricity the heat pump needs for any shortfall
+        const auto hour_start = [tes_charge_max, step_hp_electrical_power](const float state_of_charge, const float losses_at_zero_degrees, const float tes_available_offset, const float heat_demand, const float inverse_cop, float& tes_after_demand, float& base_electrical_demand) {
+            const float tes_available = std::clamp(state_of_charge - losses_at_zero_degrees + tes_available_offset, 0.0f, tes_charge_max);
+            tes_after_demand = std::max(tes_available - heat_demand, 0.0f);
+            base_electrical_demand = std::min(std::max(heat_demand - tes_available, 0.0f) * inverse_cop, step_hp_electrical_power);
+        };
+        const auto hour_cost = [](const float electrical_demand, const float pv_generation, const float import_price, const float export_price) {
+            const float net_import = electrical_demand - pv_generation;
+            return std::max(net_import, 0.0f) * import_price + std::min(net_import, 0.0f) * export_price;
+        };
+        const auto charge_electrical_demand = [](const float charge, const float nominal_room, const float inverse_cop, const float inverse_cop_boost) {
+            const float nominal_charge = std::min(nominal_room, charge);
+            return nominal_charge * inverse_cop + (charge - nominal_charge) * inverse_cop_boost;
+        };
+        const float inverse_level_step = 1 / level_step;
+        const auto interpolate_cost_to_go = [inverse_level_step](const float* cost_to_go, const float state_of_charge) {
+            const float position = std::min(state_of_charge * inverse_level_step, static_cast<float>(levels - 1));
+            const int i = std::min(static_cast<int>(position), static_cast<int>(levels) - 2);
+            const float t = position - i;
+            return cost_to_go[i] * (1 - t) + cost_to_go[i + 1] * t;
+        };
+
+        // backward pass, cost_to_go[h][i] is the cheapest cost from the start of step h at level i to the end of the horizon
+        // charging from after the demand to level j, nominal charge at the hour's cop, above tes_charge_full at the boost cop
+        std::array<std::array<float, levels>, horizon_max + 1> cost_to_go;
+        cost_to_go.at(horizon).fill(0);
+        constexpr float infeasible = std::numeric_limits<float>::max();
+        for (size_t h = horizon; h-- > 0;) {
+            const float tes_available_offset = tes_available_offsets.at(h), heat_demand = heat_demands.at(h), inverse_cop = inverse_cops.at(h), inverse_cop_boost = inverse_cop_boosts.at(h);
+            const float pv_generation = pv_generations.at(h), import_price = import_prices.at(h), export_price = export_prices.at(h);
+
+            // branchless over the start levels, all of the levels at once, so the compiler can vectorise it
+            std::array<float, levels> tes_after_demand, base_electrical_demand, nominal_room, best;
+            const float* charges = level_charges.data();
+            const float* losses = level_losses_at_zero_degrees.data();
+            float* after = tes_after_demand.data();
+            float* base = base_electrical_demand.data();
+            float* room = nominal_room.data();
+            float* best_data = best.data();
+            const float* next_cost_to_go = cost_to_go.at(h + 1).data();
+            for (size_t i = 0; i < levels; ++i) {
+                hour_start(charges[i], losses[i], tes_available_offset, heat_demand, inverse_cop, after[i], base[i]);
+                room[i] = std::max(tes_charge_full - after[i], 0.0f);
+            }
+            for (size_t i = 0; i < levels; ++i) {
+                best_data[i] = interpolate_cost_to_go(next_cost_to_go, after[i]) + hour_cost(base[i], pv_generation, import_price, export_price);
+            }
+            for (size_t j = 1; j < levels; ++j) {
+                const float level_charge = charges[j], level_cost_to_go = next_cost_to_go[j];
+                for (size_t i = 0; i < levels; ++i) {
+                    const float charge = level_charge - after[i];
+                    const float electrical_demand = base[i] + charge_electrical_demand(charge, room[i], inverse_cop, inverse_cop_boost);
+                    const float cost = level_cost_to_go + hour_cost(electrical_demand, pv_generation, import_price, export_price);
+                    const float candidate = (charge > 0 && electrical_demand <= step_hp_electrical_power) ? cost : infeasible;
+                    best_data[i] = std::min(best_data[i], candidate);
+                }
+            }
+            cost_to_go.at(h) = best;
+        }
+
+        // forward pass from the actual state of charge, taking the cheapest level each step
+        std::array<float, steps_per_day> tes_charge_plan;
+        float state_of_charge = std::min(tes_state_of_charge, tes_charge_boost);
+        for (size_t h = 0; h < steps_per_day; ++h) {
+            const float inverse_cop = inverse_cops.at(h), inverse_cop_boost = inverse_cop_boosts.at(h);
+            const float pv_generation = pv_generations.at(h), import_price = import_prices.at(h), export_price = export_prices.at(h);
+            float tes_after_demand, base_electrical_demand;
+            hour_start(state_of_charge, tes_losses_at_zero_degrees(state_of_charge), tes_available_offsets.at(h), heat_demands.at(h), inverse_cop, tes_after_demand, base_electrical_demand);
+            const float room = std::max(tes_charge_full - tes_after_demand, 0.0f);
+            const float* next_cost_to_go = cost_to_go.at(h + 1).data();
+
+            std::array<float, levels> level_costs;
+            const float* charges = level_charges.data();
+            float* costs = level_costs.data();
+            for (size_t j = 0; j < levels; ++j) {
+                const float charge = charges[j] - tes_after_demand;
+                const float electrical_demand = base_electrical_demand + charge_electrical_demand(charge, room, inverse_cop, inverse_cop_boost);
+                const float cost = next_cost_to_go[j] + hour_cost(electrical_demand, pv_generation, import_price, export_price);
+                costs[j] = (charge > 0 && electrical_demand <= step_hp_electrical_power) ? cost : infeasible;
+            }
+            float target = tes_after_demand;
+            float best = interpolate_cost_to_go(next_cost_to_go, tes_after_demand) + hour_cost(base_electrical_demand, pv_generation, import_price, export_price);
+            for (size_t j = 0; j < levels; ++j) {
+                if (level_costs.at(j) < best) {
+                    best = level_costs.at(j);
+                    target = level_charges.at(j);
+                }
+            }
+            tes_charge_plan.at(h) = target;
+            state_of_charge = target;
+        }
+        return tes_charge_plan;
+    }
+
+    template <typename Scalar>
+    void charge_tes_to_plan(Scalar& tes_state_of_charge, Scalar& electrical_demand_current, const float tes_charge_planned, const float tes_charge_full, const Scalar hp_electrical_power, const float cop_current, const float cop_boost) {
+        // as far as the heat pump's spare power allows, nominal charge at the current cop then above tes_charge_full at the boost cop
+        const Scalar spare_power = hp_electrical_power - electrical_demand_current;
+        if (tes_state_of_charge >= tes_charge_planned || spare_power <= 0) return;
+        const Scalar nominal_charge = std::clamp<Scalar>(tes_charge_full - tes_state_of_charge, 0.0f, tes_charge_planned - tes_state_of_charge);
+        const Scalar boost_charge = tes_charge_planned - tes_state_of_charge - nominal_charge;
+        const Scalar nominal_power = std::min<Scalar>(nominal_charge / cop_current, spare_power);
+        const Scalar boost_power = std::min<Scalar>(boost_charge / cop_boost, spare_power - nominal_power);
+        tes_state_of_charge += nominal_power * cop_current + boost_power * cop_boost;
+        electrical_demand_current += nominal_power + boost_power;
+    }
+
+    template <typename Scalar>
+    void add_electrical_import_cost_to_opex(Scalar& operational_costs_off_peak, Scalar& operational_costs_peak, const Scalar electrical_import, const Tariff tariff, const float agile_tariff_current, const int hour) {
         switch (tariff)
         {
         case Tariff::FlatRate:
@@ -1451,7 +2807,8 @@ namespace heatninja {
         }
     }
 
-    void subtract_pv_revenue_from_opex(float& operational_costs_off_peak, float& operational_costs_peak, const float pv_equivalent_revenue, const Tariff tariff, const float agile_tariff_current, const int hour) {
+    template <typename Scalar>
+    void subtract_pv_revenue_from_opex(Scalar& operational_costs_off_peak, Scalar& operational_costs_peak, const Scalar pv_equivalent_revenue, const Tariff tariff, const float agile_tariff_current, const int hour) {
         switch (tariff)
         {
         case Tariff::FlatRate:
@@ -1508,7 +2865,8 @@ namespace heatninja {
         return solar_thermal_generation_current * 22.5f;
     }
 
-    float calculate_emissions_pv_generation(const float pv_generation_current, const float pv_equivalent_revenue, const int grid_emissions, const int pv_size) {
+    template <typename Scalar>
+    Scalar calculate_emissions_pv_generation(const float pv_generation_current, const Scalar pv_equivalent_revenue, const int grid_emissions, const int pv_size) {
         // https://www.parliament.uk/globalassets/documents/post/postpn_383-carbon-footprint-electricity-generation.pdf
         // 75 for PV, 75 - Grid_Emissions show emissions saved for the grid or for reducing other electrical bills
         if (pv_size > 0) {
@@ -1519,73 +2877,190 @@ namespace heatninja {
         }
     }
 
-    float calculate_emissions_grid_import(const float electrical_import, const int grid_emissions) {
+    template <typename Scalar>
+    Scalar calculate_emissions_grid_import(const Scalar electrical_import, const int grid_emissions) {
         return electrical_import * grid_emissions;
     }
 
-    void simulate_heating_system_for_day(const std::array<float, 24>* temp_profile, float& inside_temp_current, const float ratio_sg_south, const float ratio_sg_north, const float cwt_current, float dhw_mf_current, float& tes_state_of_charge, const float tes_charge_full, const float tes_charge_boost, const float tes_charge_max, const float tes_radius, const float ground_temp, const HeatOption hp_option, const SolarOption solar_option, const int pv_size, const int solar_thermal_size, const float hp_electrical_power, const Tariff tariff, float& operational_costs_peak, float& operational_costs_off_peak, float& operation_emissions, float& solar_thermal_generation_total, const float ratio_roof_south, const float tes_charge_min, size_t& hour_year_counter, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int hot_water_temperature, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product) {
+    template <typename TraceSink, size_t steps_per_hour, typename Scalar>
+    void simulate_heating_system_for_day(const std::array<Scalar, 24>* temp_profile, Scalar& inside_temp_current, const float ratio_sg_south, const float ratio_sg_north, const float cwt_current, float dhw_mf_current, Scalar& tes_state_of_charge, const float tes_charge_full, const float tes_charge_boost, const float tes_charge_max, const float tes_radius, const float ground_temp, const HeatOption hp_option, const SolarOption solar_option, const int pv_size, const int solar_thermal_size, const Scalar hp_electrical_power, const Tariff tariff, Scalar& operational_costs_peak, Scalar& operational_costs_off_peak, Scalar& operation_emissions, float& solar_thermal_generation_total, const float ratio_roof_south, const float tes_charge_min, size_t& step_year_counter, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const Scalar heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int hot_water_temperature, const int grid_emissions, const Scalar solar_gain_house_factor, const float body_heat_gain, const Scalar house_size_thermal_transmittance_product, TraceSink& trace_sink) {
         const float pi_d = PI * tes_radius * 2;
         const float pi_r2 = PI * tes_radius * tes_radius;
         const float pi_d2 = pi_d * tes_radius * 2;
 
-        for (size_t hour = 0; hour < 24; ++hour) {
-            const float outside_temp_current = hourly_outside_temperatures_over_year.at(hour_year_counter);
-            const float solar_irradiance_current = hourly_solar_irradiances_over_year.at(hour_year_counter);
-            calculate_inside_temp_change(inside_temp_current, outside_temp_current, solar_irradiance_current, ratio_sg_south, ratio_sg_north, ratio_roof_south, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product, heat_capacity);
-            const auto [tes_upper_temperature, tes_lower_temperature, tes_thermocline_height] = calculate_tes_temp_and_thermocline_height(tes_state_of_charge, tes_charge_full, tes_charge_max, tes_charge_boost, cwt_current);
+        // rates per hour become energies per step, multiplying by 1 compiles out of the hourly kernel
+        constexpr float step_hours = 1.0f / steps_per_hour;
+        const Scalar step_hp_electrical_power = hp_electrical_power * step_hours;
+        const Scalar step_solar_gain_house_factor = solar_gain_house_factor * step_hours;
+        const float step_body_heat_gain = body_heat_gain * step_hours;
+        const Scalar step_house_size_thermal_transmittance_product = house_size_thermal_transmittance_product * step_hours;
+
+        const bool optimal_dispatch = simulation_options.tes_dispatch == TesDispatch::Optimal;
+        std::array<float, 24 * steps_per_hour> tes_charge_plan;
+        if (optimal_dispatch) {
+            // the plan is made on the values alone, it only picks when to charge
+            std::array<float, 24> temp_profile_values;
+            const std::array<float, 24>* plan_temp_profile = nullptr;
+            if constexpr (std::is_same_v<Scalar, float>) {
+                plan_temp_profile = temp_profile;
+            }
+            else {
+                for (size_t hour = 0; hour < 24; ++hour) temp_profile_values.at(hour) = value_of(temp_profile->at(hour));
+                plan_temp_profile = &temp_profile_values;
+            }
+            tes_charge_plan = plan_tes_charging<steps_per_hour>(plan_temp_profile, value_of(inside_temp_current), ratio_sg_south, ratio_sg_north, cwt_current, dhw_mf_current, value_of(tes_state_of_charge), tes_charge_full, tes_charge_boost, tes_charge_max, tes_radius, ground_temp, hp_option, solar_option, pv_size, solar_thermal_size, value_of(hp_electrical_power), tariff, ratio_roof_south, step_year_counter, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, u_value, value_of(heat_capacity), agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, hot_water_temperature, value_of(solar_gain_house_factor), body_heat_gain, value_of(house_size_thermal_transmittance_product));
+        }
+
+        for (size_t step = 0; step < 24 * steps_per_hour; ++step) {
+            const size_t hour = step / steps_per_hour;
+            float operational_costs_before = 0;
+            if constexpr (TraceSink::enabled) operational_costs_before = operational_costs_peak + operational_costs_off_peak;
+
+            const float outside_temp_current = hourly_outside_temperatures_over_year.at(step_year_counter);
+            const float solar_irradiance_current = hourly_solar_irradiances_over_year.at(step_year_counter);
+            calculate_inside_temp_change<Scalar>(inside_temp_current, outside_temp_current, solar_irradiance_current, ratio_sg_south, ratio_sg_north, ratio_roof_south, step_solar_gain_house_factor, step_body_heat_gain, step_house_size_thermal_transmittance_product, heat_capacity);
+            const auto [tes_upper_temperature, tes_lower_temperature, tes_thermocline_height] = calculate_tes_temp_and_thermocline_height<Scalar>(tes_state_of_charge, tes_charge_full, tes_charge_max, tes_charge_boost, cwt_current);
             //std::cout << hour << " 1 " << inside_temp_current << '\n';
-            const float tes_upper_losses = (tes_upper_temperature - inside_temp_current) * u_value * (pi_d2 * tes_thermocline_height + pi_r2); // losses in kWh
-            const float tes_lower_losses = (tes_lower_temperature - inside_temp_current) * u_value * (pi_d2 * (1 - tes_thermocline_height) + pi_r2);
-            const float total_losses = tes_upper_losses + tes_lower_losses;
+            const Scalar tes_upper_losses = (tes_upper_temperature - inside_temp_current) * u_value * (pi_d2 * tes_thermocline_height + pi_r2); // losses in kWh
+            const Scalar tes_lower_losses = (tes_lower_temperature - inside_temp_current) * u_value * (pi_d2 * (1 - tes_thermocline_height) + pi_r2);
+            const Scalar total_losses = (tes_upper_losses + tes_lower_losses) * step_hours;
             tes_state_of_charge -= total_losses;
             inside_temp_current += total_losses / heat_capacity;
             //std::cout << hour << " 2 " << inside_temp_current << '\n';
-            const float desired_min_temp_current = temp_profile->at(hour);
-            const float agile_tariff_current = agile_tariff_per_hour_over_year.at(hour_year_counter);
+            const Scalar desired_min_temp_current = temp_profile->at(hour);
+            const float agile_tariff_current = agile_tariff_per_hour_over_year.at(step_year_counter);
             const float dhw_hr_current = hot_water_hourly_ratios.at(hour);
-            const float dhw_hr_demand = (average_daily_hot_water_volume * 4.18f * (hot_water_temperature - cwt_current) / 3600) * dhw_mf_current * dhw_hr_current;
+            const float dhw_hr_demand = (average_daily_hot_water_volume * 4.18f * (hot_water_temperature - cwt_current) / 3600) * dhw_mf_current * dhw_hr_current * step_hours;
 
             const auto [cop_current, cop_boost] = calculate_cop_current_and_boost(hp_option, outside_temp_current, ground_temp, hot_water_temperature);
 
             const float pv_efficiency = calculate_pv_efficiency(solar_option, tes_upper_temperature, tes_lower_temperature);
 
             const float incident_irradiance_roof_south = solar_irradiance_current * ratio_roof_south / 1000; // kW / m2
-            float pv_generation_current = pv_size * pv_efficiency * incident_irradiance_roof_south * 0.8f;  // 80 % shading factor
+            float pv_generation_current = pv_size * pv_efficiency * incident_irradiance_roof_south * 0.8f * step_hours;  // 80 % shading factor
 
-            const float solar_thermal_generation_current = calculate_solar_thermal_generation_current(solar_option, tes_upper_temperature, tes_lower_temperature, solar_thermal_size, incident_irradiance_roof_south, outside_temp_current);
+            const float solar_thermal_generation_current = calculate_solar_thermal_generation_current(solar_option, tes_upper_temperature, tes_lower_temperature, solar_thermal_size, incident_irradiance_roof_south, outside_temp_current) * step_hours;
             tes_state_of_charge += solar_thermal_generation_current;
             solar_thermal_generation_total += solar_thermal_generation_current;
             // Dumps any excess solar generated heat to prevent boiling TES
-            tes_state_of_charge = std::min(tes_state_of_charge, tes_charge_max);
+            tes_state_of_charge = std::min<Scalar>(tes_state_of_charge, tes_charge_max);
 
-            const float space_hr_demand = calculate_hourly_space_demand(inside_temp_current, desired_min_temp_current, cop_current, tes_state_of_charge, dhw_hr_demand, hp_electrical_power, heat_capacity);
+            const Scalar space_hr_demand = calculate_hourly_space_demand<Scalar>(inside_temp_current, desired_min_temp_current, cop_current, tes_state_of_charge, dhw_hr_demand, step_hp_electrical_power, heat_capacity);
             //std::cout << hour << " 3 " << inside_temp_current << '\n';
-            float electrical_demand_current = calculate_electrical_demand_for_heating(tes_state_of_charge, space_hr_demand + dhw_hr_demand, hp_electrical_power, cop_current);
-            calculate_electrical_demand_for_tes_charging(electrical_demand_current, tes_state_of_charge, tes_charge_full, tariff, static_cast<int>(hour), hp_electrical_power, cop_current, agile_tariff_current);
-            const float pv_remaining_current = pv_generation_current - electrical_demand_current;
+            Scalar electrical_demand_current = calculate_electrical_demand_for_heating<Scalar>(tes_state_of_charge, space_hr_demand + dhw_hr_demand, step_hp_electrical_power, cop_current);
+            if (optimal_dispatch) {
+                charge_tes_to_plan<Scalar>(tes_state_of_charge, electrical_demand_current, tes_charge_plan.at(step), tes_charge_full, step_hp_electrical_power, cop_current, cop_boost);
+            }
+            else {
+                calculate_electrical_demand_for_tes_charging<Scalar>(electrical_demand_current, tes_state_of_charge, tes_charge_full, tariff, static_cast<int>(hour), step_hp_electrical_power, cop_current, agile_tariff_current);
+                const Scalar pv_remaining_current = pv_generation_current - electrical_demand_current;
 
-            //Boost temperature if any spare PV generated electricity, as reduced cop, raises to nominal temp above first
-            boost_tes_and_electrical_demand(tes_state_of_charge, electrical_demand_current, pv_remaining_current, tes_charge_boost, hp_electrical_power, cop_boost);
+                //Boost temperature if any spare PV generated electricity, as reduced cop, raises to nominal temp above first
+                boost_tes_and_electrical_demand<Scalar>(tes_state_of_charge, electrical_demand_current, pv_remaining_current, tes_charge_boost, step_hp_electrical_power, cop_boost);
+            }
 
-            recharge_tes_to_minimum(tes_state_of_charge, electrical_demand_current, tes_charge_min, hp_electrical_power, cop_current);
+            recharge_tes_to_minimum<Scalar>(tes_state_of_charge, electrical_demand_current, tes_charge_min, step_hp_electrical_power, cop_current);
 
-            float pv_equivalent_revenue;
-            float electrical_import;
+            Scalar pv_equivalent_revenue;
+            Scalar electrical_import;
             if (pv_generation_current > electrical_demand_current) { // Generating more electricity than using
                 pv_equivalent_revenue = pv_generation_current - electrical_demand_current;
                 electrical_import = 0;
-                subtract_pv_revenue_from_opex(operational_costs_off_peak, operational_costs_peak, pv_equivalent_revenue, tariff, agile_tariff_current, static_cast<int>(hour));
+                subtract_pv_revenue_from_opex<Scalar>(operational_costs_off_peak, operational_costs_peak, pv_equivalent_revenue, tariff, agile_tariff_current, static_cast<int>(hour));
             }
             else {
                 pv_equivalent_revenue = 0;
                 electrical_import = electrical_demand_current - pv_generation_current;
-                add_electrical_import_cost_to_opex(operational_costs_off_peak, operational_costs_peak, electrical_import, tariff, agile_tariff_current, static_cast<int>(hour));
+                add_electrical_import_cost_to_opex<Scalar>(operational_costs_off_peak, operational_costs_peak, electrical_import, tariff, agile_tariff_current, static_cast<int>(hour));
             }
 
             operation_emissions += calculate_emissions_solar_thermal(solar_thermal_generation_current) +
-                calculate_emissions_pv_generation(pv_generation_current, pv_equivalent_revenue, grid_emissions, pv_size) +
-                calculate_emissions_grid_import(electrical_import, grid_emissions);
-            hour_year_counter++;
+                calculate_emissions_pv_generation<Scalar>(pv_generation_current, pv_equivalent_revenue, grid_emissions, pv_size) +
+                calculate_emissions_grid_import<Scalar>(electrical_import, grid_emissions);
+
+            if constexpr (TraceSink::enabled) {
+                trace_sink.record({ inside_temp_current, tes_state_of_charge, cop_current, pv_generation_current, electrical_import, pv_equivalent_revenue, operational_costs_peak + operational_costs_off_peak - operational_costs_before });
+            }
+            step_year_counter++;
+        }
+    }
+
+    std::vector<HourlyTrace> trace_heat_solar_specification(const HeatSolarSystemSpecifications& spec, const float ground_temp, const std::array<float, 24>& erh_hourly_temperatures_over_day, const std::array<float, 24>& hp_hourly_temperatures_over_day, const int hot_water_temperature, const float coldest_outside_temperature_of_year, const float maximum_hourly_erh_demand, const float maximum_hourly_hp_demand, const float thermostat_temperature, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product) {
+        // re-runs one specification with its chosen tariff, recording every step of the year
+        const std::array<float, 24>& temp_profile = select_temp_profile(spec.heat_option, hp_hourly_temperatures_over_day, erh_hourly_temperatures_over_day);
+        const float cop_ref = calculate_cop_ref(spec.heat_option);
+        const float cop_worst = calculate_cop_worst(spec.heat_option, hot_water_temperature, coldest_outside_temperature_of_year, ground_temp);
+        const float hp_electrical_power = calculate_hp_electrical_power(spec.heat_option, maximum_hourly_erh_demand, maximum_hourly_hp_demand, cop_worst, cop_ref);
+        const TesCharges tes_charges = calculate_tes_charges(spec.tes_volume, hot_water_temperature);
+
+        HourlyTraceRecorder recorder;
+        recorder.hours.reserve(hours_per_year * simulation_options.steps_per_hour);
+        with_steps_per_hour([&](auto steps) {
+            return simulate_heating_system_for_year<HourlyTraceRecorder, decltype(steps)::value>(&temp_profile, thermostat_temperature, tes_charges, ground_temp, spec.heat_option, spec.solar_option, spec.pv_size, spec.solar_thermal_size, hp_electrical_power, spec.tariff, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_roof_ratios_south, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, u_value, heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, hot_water_temperature, grid_emissions, solar_gain_house_factor, body_heat_gain, house_size_thermal_transmittance_product, recorder);
+            });
+        return recorder.hours;
+    }
+
+    SensitivityHousehold seed_sensitivity_household(const float thermostat_temperature, const float house_size, const float dwelling_thermal_transmittance, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 24>& hot_water_hourly_ratios, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float average_daily_hot_water_volume, const int hot_water_temperature, const float body_heat_gain) {
+        SensitivityHousehold household;
+        const SensitivityScalar house_size_variable = SensitivityScalar::variable(house_size, static_cast<size_t>(SensitivityInput::HouseSize));
+        household.thermostat_temperature = SensitivityScalar::variable(thermostat_temperature, static_cast<size_t>(SensitivityInput::ThermostatTemperature));
+        household.heat_pump_price_scale = SensitivityScalar::variable(1, static_cast<size_t>(SensitivityInput::HeatPumpPrice));
+
+        household.erh_hourly_temperatures_over_day = calculate_erh_hourly_temperature_profile(household.thermostat_temperature);
+        household.hp_hourly_temperatures_over_day = calculate_hp_hourly_temperature_profile(household.thermostat_temperature);
+        household.solar_gain_house_factor = calculate_solar_gain_house_factor(house_size_variable);
+        household.heat_capacity = calculate_heat_capacity(house_size_variable);
+        household.house_size_thermal_transmittance_product = calculate_house_size_thermal_transmittance_product(house_size_variable, dwelling_thermal_transmittance);
+
+        // only the maxima size the heat pump, the serial engine as the scan's maps hold floats
+        household.maximum_hourly_erh_demand = calculate_yearly_space_and_hot_water_demand(household.erh_hourly_temperatures_over_day, household.thermostat_temperature, dhw_monthly_factors, monthly_cold_water_temperatures, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, hot_water_hourly_ratios, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, average_daily_hot_water_volume, hot_water_temperature, household.solar_gain_house_factor, house_size_variable, dwelling_thermal_transmittance, household.heat_capacity, body_heat_gain).max_hourly;
+        household.maximum_hourly_hp_demand = calculate_yearly_space_and_hot_water_demand(household.hp_hourly_temperatures_over_day, household.thermostat_temperature, dhw_monthly_factors, monthly_cold_water_temperatures, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, hot_water_hourly_ratios, hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year, average_daily_hot_water_volume, hot_water_temperature, household.solar_gain_house_factor, house_size_variable, dwelling_thermal_transmittance, household.heat_capacity, body_heat_gain).max_hourly;
+        return household;
+    }
+
+    SpecificationSensitivities calculate_specification_sensitivities(const HeatSolarSystemSpecifications& spec, const SensitivityHousehold& household, const float ground_temp, const int hot_water_temperature, const float coldest_outside_temperature_of_year, const float cumulative_discount_rate, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int grid_emissions, const float body_heat_gain) {
+        // as calculate_optimal_tariff for the spec's tes & tariff, in the same order so the values match the float run
+        const std::array<SensitivityScalar, 24>& temp_profile = select_temp_profile(spec.heat_option, household.hp_hourly_temperatures_over_day, household.erh_hourly_temperatures_over_day);
+        const float cop_ref = calculate_cop_ref(spec.heat_option);
+        const float cop_worst = calculate_cop_worst(spec.heat_option, hot_water_temperature, coldest_outside_temperature_of_year, ground_temp);
+        const SensitivityScalar hp_electrical_power = calculate_hp_electrical_power(spec.heat_option, household.maximum_hourly_erh_demand, household.maximum_hourly_hp_demand, cop_worst, cop_ref);
+        const SensitivityScalar hp_thermal_power = hp_electrical_power * cop_ref;
+        const SensitivityScalar capex = calculate_capex_heatopt(spec.heat_option, hp_thermal_power) * household.heat_pump_price_scale + calculate_capex_pv(spec.solar_option, spec.pv_size) + calculate_capex_solar_thermal(spec.solar_option, spec.solar_thermal_size) + calculate_capex_tes_volume(spec.tes_volume);
+        const TesCharges tes_charges = calculate_tes_charges(spec.tes_volume, hot_water_temperature);
+
+        NullTraceSink null_trace_sink;
+        const auto simulate_year = [&](const std::vector<float>& outside_temperatures, const std::vector<float>& solar_irradiances) {
+            return with_steps_per_hour([&](auto steps) {
+                return simulate_heating_system_for_year<NullTraceSink, decltype(steps)::value, SensitivityScalar>(&temp_profile, household.thermostat_temperature, tes_charges, ground_temp, spec.heat_option, spec.solar_option, spec.pv_size, spec.solar_thermal_size, hp_electrical_power, spec.tariff, monthly_solar_gain_ratios_north, monthly_solar_gain_ratios_south, monthly_cold_water_temperatures, dhw_monthly_factors, monthly_roof_ratios_south, outside_temperatures, solar_irradiances, u_value, household.heat_capacity, agile_tariff_per_hour_over_year, hot_water_hourly_ratios, average_daily_hot_water_volume, hot_water_temperature, grid_emissions, household.solar_gain_house_factor, body_heat_gain, household.house_size_thermal_transmittance_product, null_trace_sink);
+                });
+        };
+        BasicYearlyOperation<SensitivityScalar> operation = simulate_year(hourly_outside_temperatures_over_year, hourly_solar_irradiances_over_year);
+        if (!ensemble_weather_years.empty()) {
+            for (const EnsembleWeatherYear& ensemble_weather_year : ensemble_weather_years) {
+                const BasicYearlyOperation<SensitivityScalar> year_operation = simulate_year(ensemble_weather_year.outside_temperatures, ensemble_weather_year.solar_irradiances);
+                operation.operational_costs_peak += year_operation.operational_costs_peak;
+                operation.operational_costs_off_peak += year_operation.operational_costs_off_peak;
+                operation.operation_emissions += year_operation.operation_emissions;
+            }
+            const float years = static_cast<float>(ensemble_weather_years.size() + 1);
+            operation.operational_costs_peak /= years;
+            operation.operational_costs_off_peak /= years;
+            operation.operation_emissions /= years;
+        }
+
+        const SensitivityScalar operational_expenditure = operation.operational_costs_peak + operation.operational_costs_off_peak;
+        return { operational_expenditure, capex, capex + operational_expenditure * cumulative_discount_rate, operation.operation_emissions };
+    }
+
+    void write_hourly_traces(const HeatSolarSystemSpecifications& spec, const std::vector<HourlyTrace>& hourly_traces, std::ofstream& file) {
+        // heat_option, solar_option, hour, inside_temperature, tes_state_of_charge, cop, pv_generation, electrical_import, pv_export, operational_cost
+        file << std::fixed;
+        file.precision(3);
+        size_t hour = 0;
+        for (const auto& h : hourly_traces) {
+            file << static_cast<int>(spec.heat_option) << ',' << static_cast<int>(spec.solar_option) << ',' << hour << ',' << h.inside_temperature << ',' << h.tes_state_of_charge << ',' << h.cop << ',' << h.pv_generation << ',' << h.electrical_import << ',' << h.pv_export << ',' << h.operational_cost << '\n';
+            ++hour;
         }
     }
 
@@ -1623,6 +3098,281 @@ namespace heatninja {
         file.close();
     }
 
+    // all specs binary layout, little endian: 8 byte magic, uint64 record count, then packed 28 byte records of
+    // uint8 heat_option, uint8 solar_option, uint8 tariff, uint8 padding, int16 pv_size, int16 solar_thermal_size,
+    // float tes_volume, float operational_expenditure, float capital_expenditure, float net_present_cost, float operation_emissions
+    constexpr std::array<char, 8> all_specs_magic = { 'H', 'N', 'S', 'P', 'E', 'C', 'S', '1' };
+    constexpr size_t all_specs_record_size = 28;
+    constexpr std::array<char, 8> binary_result_magic = { 'H', 'N', 'R', 'E', 'S', 'L', 'T', '1' };
+    constexpr size_t binary_result_size = binary_result_magic.size() + 2 * sizeof(uint32_t) + 2 * sizeof(Demand) + 21 * all_specs_record_size + 8 * sizeof(FixedCostSystem);
+
+    void put_all_specs_record(char*& out, const HeatSolarSystemSpecifications& spec) {
+        const auto put = [&out](const auto value) {
+            std::memcpy(out, &value, sizeof(value));
+            out += sizeof(value);
+        };
+        put(static_cast<uint8_t>(spec.heat_option));
+        put(static_cast<uint8_t>(spec.solar_option));
+        put(static_cast<uint8_t>(spec.tariff));
+        put(static_cast<uint8_t>(0));
+        put(static_cast<int16_t>(spec.pv_size));
+        put(static_cast<int16_t>(spec.solar_thermal_size));
+        put(spec.tes_volume);
+        put(spec.operational_expenditure);
+        put(spec.capital_expenditure);
+        put(spec.net_present_cost);
+        put(spec.operation_emissions);
+    }
+
+    HeatSolarSystemSpecifications get_all_specs_record(const char*& in) {
+        const auto get = [&in](auto& value) {
+            std::memcpy(&value, in, sizeof(value));
+            in += sizeof(value);
+        };
+        uint8_t heat_option, solar_option, tariff, padding;
+        int16_t pv_size, solar_thermal_size;
+        HeatSolarSystemSpecifications spec;
+        get(heat_option);
+        get(solar_option);
+        get(tariff);
+        get(padding);
+        get(pv_size);
+        get(solar_thermal_size);
+        get(spec.tes_volume);
+        get(spec.operational_expenditure);
+        get(spec.capital_expenditure);
+        get(spec.net_present_cost);
+        get(spec.operation_emissions);
+        spec.heat_option = static_cast<HeatOption>(heat_option);
+        spec.solar_option = static_cast<SolarOption>(solar_option);
+        spec.tariff = static_cast<Tariff>(tariff);
+        spec.pv_size = pv_size;
+        spec.solar_thermal_size = solar_thermal_size;
+        return spec;
+    }
+
+    void write_all_specs_binary(const std::array<std::vector<HeatSolarSystemSpecifications>, 21>& all_specs_buffers, const std::string& filename) {
+        uint64_t record_count = 0;
+        for (const auto& all_specs_buffer : all_specs_buffers) {
+            record_count += all_specs_buffer.size();
+        }
+
+        std::vector<char> bytes(all_specs_magic.size() + sizeof(record_count) + record_count * all_specs_record_size);
+        char* out = bytes.data();
+        std::memcpy(out, all_specs_magic.data(), all_specs_magic.size());
+        out += all_specs_magic.size();
+        std::memcpy(out, &record_count, sizeof(record_count));
+        out += sizeof(record_count);
+        for (const auto& all_specs_buffer : all_specs_buffers) {
+            for (const auto& spec : all_specs_buffer) {
+                put_all_specs_record(out, spec);
+            }
+        }
+
+        std::ofstream file(filename, std::ios::binary);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        file.close();
+    }
+
+    std::vector<HeatSolarSystemSpecifications> read_all_specs_binary(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        std::array<char, 8> magic = {};
+        uint64_t record_count = 0;
+        file.read(magic.data(), magic.size());
+        file.read(reinterpret_cast<char*>(&record_count), sizeof(record_count));
+        if (!file || magic != all_specs_magic) {
+            throw std::runtime_error("not an all specs binary file: " + filename);
+        }
+
+        std::vector<char> bytes(record_count * all_specs_record_size);
+        file.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!file) {
+            throw std::runtime_error("truncated all specs binary file: " + filename);
+        }
+
+        std::vector<HeatSolarSystemSpecifications> specs;
+        specs.reserve(record_count);
+        const char* in = bytes.data();
+        for (uint64_t i = 0; i < record_count; ++i) {
+            specs.push_back(get_all_specs_record(in));
+        }
+        return specs;
+    }
+
+    std::vector<char> encode_binary_result(const SimulationResult& result) {
+        std::vector<char> bytes(binary_result_size);
+        char* out = bytes.data();
+        const auto put = [&out](const auto value) {
+            std::memcpy(out, &value, sizeof(value));
+            out += sizeof(value);
+        };
+        std::memcpy(out, binary_result_magic.data(), binary_result_magic.size());
+        out += binary_result_magic.size();
+        put(static_cast<uint32_t>(result.systems.size()));
+        put(static_cast<uint32_t>(result.fixed_cost_systems.size()));
+        for (const Demand& demand : { result.demand.erh, result.demand.hp }) {
+            put(demand.total);
+            put(demand.max_hourly);
+            put(demand.space);
+            put(demand.hot_water);
+        }
+        for (const HeatSolarSystemSpecifications& spec : result.systems) {
+            put_all_specs_record(out, spec);
+        }
+        for (const FixedCostSystem& fixed_cost_system : result.fixed_cost_systems) {
+            put(fixed_cost_system.operational_expenditure);
+            put(fixed_cost_system.capital_expenditure);
+            put(fixed_cost_system.net_present_cost);
+            put(fixed_cost_system.operation_emissions);
+        }
+        return bytes;
+    }
+
+    SimulationResult decode_binary_result(const char* bytes, const size_t size) {
+        std::array<char, 8> magic = {};
+        uint32_t system_count = 0, fixed_cost_system_count = 0;
+        if (bytes == nullptr || size != binary_result_size) {
+            throw std::runtime_error("binary result must be " + std::to_string(binary_result_size) + " bytes, got " + std::to_string(size));
+        }
+        const char* in = bytes;
+        const auto get = [&in](auto& value) {
+            std::memcpy(&value, in, sizeof(value));
+            in += sizeof(value);
+        };
+        get(magic);
+        get(system_count);
+        get(fixed_cost_system_count);
+        if (magic != binary_result_magic || system_count != 21 || fixed_cost_system_count != 8) {
+            throw std::runtime_error("not a binary result");
+        }
+
+        SimulationResult result;
+        for (Demand* demand : { &result.demand.erh, &result.demand.hp }) {
+            get(demand->total);
+            get(demand->max_hourly);
+            get(demand->space);
+            get(demand->hot_water);
+        }
+        for (HeatSolarSystemSpecifications& spec : result.systems) {
+            spec = get_all_specs_record(in);
+        }
+        for (FixedCostSystem& fixed_cost_system : result.fixed_cost_systems) {
+            get(fixed_cost_system.operational_expenditure);
+            get(fixed_cost_system.capital_expenditure);
+            get(fixed_cost_system.net_present_cost);
+            get(fixed_cost_system.operation_emissions);
+        }
+        return result;
+    }
+
+    bool dominates(const HeatSolarSystemSpecifications& a, const HeatSolarSystemSpecifications& b, const bool against_capex) {
+        if (a.net_present_cost > b.net_present_cost) return false;
+        if (a.operation_emissions > b.operation_emissions) return false;
+        if (against_capex && a.capital_expenditure > b.capital_expenditure) return false;
+        return true;
+    }
+
+    void update_pareto_frontier(std::vector<HeatSolarSystemSpecifications>& pareto_frontier, const HeatSolarSystemSpecifications& candidate, const bool against_capex) {
+        for (const auto& spec : pareto_frontier) {
+            if (dominates(spec, candidate, against_capex)) return;
+        }
+        std::erase_if(pareto_frontier, [&](const HeatSolarSystemSpecifications& spec) { return dominates(candidate, spec, against_capex); });
+        pareto_frontier.push_back(candidate);
+    }
+
+    std::string pareto_frontier_to_json(std::vector<HeatSolarSystemSpecifications> pareto_frontier) {
+        const std::array<std::string, 5> tariffs_json = { "flat-rate", "economy-7", "bulb-smart", "octopus-go", "octopus-agile" };
+
+        // cheapest first, so emissions fall along the array
+        std::sort(pareto_frontier.begin(), pareto_frontier.end(), [](const HeatSolarSystemSpecifications& a, const HeatSolarSystemSpecifications& b) { return a.net_present_cost < b.net_present_cost; });
+
+        std::stringstream ss;
+        ss << '[';
+        for (size_t i = 0; i < pareto_frontier.size(); ++i) {
+            const auto& s = pareto_frontier.at(i);
+            if (i != 0) ss << ',';
+            ss << "{\"pv-size\":" << s.pv_size << ",\"solar-thermal-size\":" << s.solar_thermal_size << ",\"thermal-energy-storage-volume\":" << s.tes_volume << ",\"tariff\":\"" << tariffs_json.at(static_cast<int>(s.tariff)) << "\",\"operational-expenditure\":" << s.operational_expenditure << ",\"capital-expenditure\":" << s.capital_expenditure << ",\"net-present-cost\":" << s.net_present_cost << ",\"operational-emissions\":" << s.operation_emissions << "}";
+        }
+        ss << ']';
+        return ss.str();
+    }
+
+    RepricingTotals calculate_repricing_totals(const Tariff tariff, const std::vector<HourlyTrace>& hourly_traces, const std::vector<float>& agile_tariff_per_hour_over_year) {
+        // same pricing as the hourly kernel, split into the parts the scenarios scale
+        float import_cost_off_peak = 0, import_cost_peak = 0, export_revenue_off_peak = 0, export_revenue_peak = 0;
+        const size_t steps_per_hour = simulation_options.steps_per_hour;
+        for (size_t step_year = 0; step_year < hourly_traces.size(); ++step_year) {
+            const HourlyTrace& h = hourly_traces[step_year];
+            const int hour = static_cast<int>(step_year / steps_per_hour % 24);
+            const float agile_tariff_current = agile_tariff_per_hour_over_year.at(step_year);
+            if (h.pv_export > 0) {
+                subtract_pv_revenue_from_opex(export_revenue_off_peak, export_revenue_peak, h.pv_export, tariff, agile_tariff_current, hour);
+            }
+            else {
+                add_electrical_import_cost_to_opex(import_cost_off_peak, import_cost_peak, h.electrical_import, tariff, agile_tariff_current, hour);
+            }
+        }
+        return { import_cost_off_peak + import_cost_peak, -(export_revenue_off_peak + export_revenue_peak) };
+    }
+
+    PriceScenarios sample_price_scenarios(const MonteCarloOptions& monte_carlo, const int npc_years, const size_t weather_years) {
+        std::mt19937 generator(monte_carlo.seed);
+        std::normal_distribution<float> standard_normal(0.0f, 1.0f);
+        std::uniform_real_distribution<float> discount_rates(monte_carlo.discount_rate_min, monte_carlo.discount_rate_max);
+        std::uniform_int_distribution<size_t> weather_year_indices(0, weather_years - 1);
+
+        PriceScenarios price_scenarios;
+        price_scenarios.import_price_multipliers.resize(monte_carlo.scenarios);
+        price_scenarios.export_price_multipliers.resize(monte_carlo.scenarios);
+        price_scenarios.capex_multipliers.resize(monte_carlo.scenarios);
+        price_scenarios.cumulative_discount_rates.resize(monte_carlo.scenarios);
+        price_scenarios.weather_years.resize(monte_carlo.scenarios);
+        for (size_t n = 0; n < monte_carlo.scenarios; ++n) {
+            price_scenarios.import_price_multipliers[n] = std::exp(monte_carlo.import_price_sigma * standard_normal(generator));
+            price_scenarios.export_price_multipliers[n] = std::exp(monte_carlo.export_price_sigma * standard_normal(generator));
+            price_scenarios.capex_multipliers[n] = std::exp(monte_carlo.capex_sigma * standard_normal(generator));
+            price_scenarios.cumulative_discount_rates[n] = calculate_cumulative_discount_rate(discount_rates(generator), npc_years);
+            // drawn only with an ensemble, so a single year's scenarios are unchanged
+            price_scenarios.weather_years[n] = weather_years > 1 ? weather_year_indices(generator) : 0;
+        }
+        return price_scenarios;
+    }
+
+    NpcDistribution reprice_specification(const HeatSolarSystemSpecifications& spec, const std::vector<RepricingTotals>& repricing_totals, const PriceScenarios& price_scenarios, std::vector<float>& npcs) {
+        const size_t scenarios = price_scenarios.cumulative_discount_rates.size();
+        npcs.resize(scenarios);
+
+        const float* import_price_multipliers = price_scenarios.import_price_multipliers.data();
+        const float* export_price_multipliers = price_scenarios.export_price_multipliers.data();
+        const float* capex_multipliers = price_scenarios.capex_multipliers.data();
+        const float* cumulative_discount_rates = price_scenarios.cumulative_discount_rates.data();
+        const size_t* weather_years = price_scenarios.weather_years.data();
+        const RepricingTotals* repricing_totals_data = repricing_totals.data();
+        float* npcs_data = npcs.data();
+        const float capex = spec.capital_expenditure;
+        // branchless over independent scenarios so the compiler can vectorise it
+        for (size_t n = 0; n < scenarios; ++n) {
+            const RepricingTotals& year_totals = repricing_totals_data[weather_years[n]];
+            const float operational_expenditure = year_totals.import_cost * import_price_multipliers[n] - year_totals.export_revenue * export_price_multipliers[n];
+            npcs_data[n] = capex * capex_multipliers[n] + operational_expenditure * cumulative_discount_rates[n];
+        }
+
+        double npc_sum = 0;
+        for (const float npc : npcs) {
+            npc_sum += npc;
+        }
+
+        auto percentile = [&](const float p) {
+            const size_t index = static_cast<size_t>(p * static_cast<float>(scenarios - 1) + 0.5f);
+            std::nth_element(npcs.begin(), npcs.begin() + index, npcs.end());
+            return npcs.at(index);
+        };
+        const float p5 = percentile(0.05f);
+        const float p50 = percentile(0.50f);
+        const float p95 = percentile(0.95f);
+        return { p5, p50, p95, static_cast<float>(npc_sum / static_cast<double>(scenarios)) };
+    }
+
     std::string output_to_javascript(const std::array<HeatSolarSystemSpecifications, 21>& optimal_specifications) {
         const std::array<std::string, 3> heat_opt_names = { "ERH", "ASHP", "GSHP" };
         const std::array<std::string, 7> solar_opt_names = { "None", "PV", "FP", "ET", "FP+PV", "ET+PV", "PVT" };
@@ -1639,4 +3389,17 @@ namespace heatninja {
         ss << ']';
         return ss.str();
     }
+
+    template std::array<float, 24> calculate_erh_hourly_temperature_profile(const float t);
+    template std::array<float, 24> calculate_hp_hourly_temperature_profile(const float t);
+    template float calculate_solar_gain_house_factor(const float house_size);
+    template float calculate_heat_capacity(const float house_size);
+    template float calculate_house_size_thermal_transmittance_product(const float house_size, const float dwelling_thermal_transmittance);
+    template const std::array<float, 24>& select_temp_profile(const HeatOption hp_option, const std::array<float, 24>& hp_temp_profile, const std::array<float, 24>& erh_temp_profile);
+    template Demand calculate_yearly_space_and_hot_water_demand(const std::array<float, 24>& hourly_temperatures_over_day, const float thermostat_temperature, const std::array<float, 12>& hot_water_monthly_factors, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 24>& dhw_hourly_ratios, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float average_daily_hot_water_volume, const int hot_water_temperature, const float solar_gain_house_factor, const float house_size, const float dwelling_thermal_transmittance, const float heat_capacity, const float body_heat_gain);
+    template float calculate_hp_electrical_power(const HeatOption hp_option, const float max_hourly_erh_demand, const float max_hourly_hp_demand, const float cop_worst, const float cop_ref);
+    template float calculate_capex_heatopt(const HeatOption hp_option, const float hp_thermal_power);
+    template struct BasicTesTempAndHeight<float>;
+    template YearlyOperation simulate_heating_system_for_year<NullTraceSink>(const std::array<float, 24>* temp_profile, const float thermostat_temperature, const TesCharges& tes_charges, const float ground_temp, const HeatOption hp_option, const SolarOption solar_option, const int pv_size, const int solar_thermal_size, const float hp_electrical_power, const Tariff tariff, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int hot_water_temperature, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product, NullTraceSink& trace_sink);
+    template YearlyOperation simulate_heating_system_for_year<HourlyTraceRecorder>(const std::array<float, 24>* temp_profile, const float thermostat_temperature, const TesCharges& tes_charges, const float ground_temp, const HeatOption hp_option, const SolarOption solar_option, const int pv_size, const int solar_thermal_size, const float hp_electrical_power, const Tariff tariff, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int hot_water_temperature, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product, HourlyTraceRecorder& trace_sink);
 }
\ No newline at end of file
@@ -1,8 +1,19 @@
 #pragma once
+// EM_COMPATIBLE compiles out the native only code (multithreading, debug files, Timer)
+// Emscripten builds always get it, native builds set it from the build (CMake option HEATNINJA_EM_COMPATIBLE)
+#if defined(__EMSCRIPTEN__) && !defined(EM_COMPATIBLE)
 #define EM_COMPATIBLE
+#endif
 #include <array>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <functional>
+
+#include "dual.h"
 
 namespace heatninja {
     // key terms
@@ -10,16 +21,97 @@ namespace heatninja {
     // hp = heat pump
     // dhw = domestic hot water
 
+    struct WeatherStore;
+    struct OptimiserParameters;
+    struct HeatSolarSystemSpecifications;
+    struct SimulationResult;
+
+    // pieces of the result json handed over as soon as they are ready, every callback is optional
+    // the returned json is still assembled in full, the streamed pieces are identical to the parts of it
+    struct ResultStream {
+        std::function<void(std::string_view demand_json)> on_demand; // the "demand" object, before any optimisation
+        // a heat & solar system's object, from the task that optimised it, so concurrently with use_multithreading
+        std::function<void(const HeatSolarSystemSpecifications& spec, std::string_view system_json)> on_system;
+        std::function<void(std::string_view fixed_cost_systems_json)> on_fixed_cost_systems; // hydrogen, gas & biomass systems as one object
+    };
+
+    // brackets the stages of run_simulation, "epc-fit", "demand" & "<heat option>/<solar option>" for a combination's optimisation
+    // both calls of a stage are made on the thread running it, so concurrently with use_multithreading
+    struct StageHooks {
+        std::function<void(std::string_view stage)> on_stage_start;
+        std::function<void(std::string_view stage)> on_stage_end;
+    };
+
+    struct MonteCarloOptions {
+        size_t scenarios = 0; // 0 disables repricing of the optimal specs
+        unsigned int seed = 1;
+        float import_price_sigma = 0.2f; // log-normal multiplier on import prices
+        float export_price_sigma = 0.2f; // log-normal multiplier on export revenue
+        float capex_sigma = 0.1f; // log-normal multiplier on capex
+        float discount_rate_min = 1.02f, discount_rate_max = 1.05f; // uniform
+    };
+
+    enum class TesDispatch : int {
+        Heuristic = 0, // charge in each tariff's cheap hours, boost from spare pv
+        Optimal = 1 // cheapest charging by dynamic programming over the tes state of charge, planned a day at a time
+    };
+
+    enum class DemandEngine : int {
+        Serial = 0, // one 8760 hour chain
+        Scan = 1 // days composed in parallel & scanned, see calculate_yearly_space_and_hot_water_demand_scan
+    };
+
     struct SimulationOptions {
         bool output_demand;
         bool output_optimal_specs;
-        bool output_all_specs; // not compatible with multithreading or optimal surfaces
+        bool output_all_specs; // buffered per heat & solar combination, written as binary, see tools/all_specs_to_csv.cpp
         size_t output_file_index;
 
         bool use_multithreading;
         bool use_optimisation_surfaces;
+
+        bool output_hourly_traces = false; // re-runs each optimal spec recording every hour of the year
+
+        bool output_pareto_frontiers = false; // non-dominated evaluated specs per combination, added to the json
+        bool output_sensitivities = false; // derivatives of each optimal spec's costs & emissions, added to the json, see calculate_specification_sensitivities
+        bool pareto_against_capex = false; // capex as a third objective next to npc & emissions
+
+        MonteCarloOptions monte_carlo = {};
+
+        size_t representative_days = 0; // > 0 ranks every point on this many clustered days, then runs the full year on the finalists
+        size_t representative_day_finalists = 10;
+
+        bool use_surrogate_search = false; // gaussian process guided search instead of the optimisation surfaces
+        float surrogate_improvement_threshold = 1.0f; // stop once the expected npc improvement is below this
+
+        const WeatherStore* weather_store = nullptr; // resident weather & tariff data, no files are read when set
+
+        const ResultStream* result_stream = nullptr;
+        const StageHooks* stage_hooks = nullptr;
+
+        // seconds from the call to run_simulation, 0 is unbounded. every combination first gets the smallest system as an incumbent,
+        // the searches then refine until the deadline & systems cut short are flagged "search-complete":false in the json,
+        // systems finished after the deadline leave out their npc distribution & sensitivities
+        float time_budget = 0;
+
+        TesDispatch tes_dispatch = TesDispatch::Heuristic;
+        DemandEngine demand_engine = DemandEngine::Serial; // scan sums in a different order, so demands differ from serial by float rounding
+
+        // operational steps per hour, 1 or 2 (half hourly, 17520 steps a year), each instantiates its own kernels
+        // the epc fit & demand stay hourly, hourly series are held over both half hours & half hourly ones averaged for the demand
+        size_t steps_per_hour = 1;
+
+        const OptimiserParameters* optimiser_parameters = nullptr; // replaces the tuned table for every surface, used by the tuner
+
+        SimulationResult* result = nullptr; // filled with the result's numbers when set, see encode_binary_result
+        bool output_json = true; // false returns an empty string without formatting the json, streamed pieces are still formatted
     };
 
+    inline constexpr std::array<float, 12> dhw_monthly_factors = { 1.10f, 1.06f, 1.02f, 0.98f, 0.94f, 0.90f, 0.90f, 0.94f, 0.98f, 1.02f, 1.06f, 1.10f };
+    inline constexpr std::array<float, 24> hot_water_hourly_ratios = { 0.025f, 0.018f, 0.011f, 0.010f, 0.008f, 0.013f, 0.017f, 0.044f, 0.088f, 0.075f, 0.060f, 0.056f, 0.050f, 0.043f, 0.036f, 0.029f, 0.030f, 0.036f, 0.053f, 0.074f, 0.071f, 0.059f, 0.050f, 0.041f };
+    inline constexpr int hot_water_temperature = 51;
+    inline constexpr std::array<float, 12> monthly_solar_declinations = { -20.7f, -12.8f, -1.8f, 9.8f, 18.8f, 23.1f, 21.2f, 13.7f, 2.9f, -8.7f, -18.4f, -23.0f };
+
     // tools
     std::string float_to_string(const float value, const int precision);
 
@@ -29,17 +121,41 @@ namespace heatninja {
 
     // simulation
 
+    // points simulated (calculate_optimal_tariff calls) by the last run of each heat & solar combination
+    extern std::array<size_t, 21> combination_evaluations;
+
+#ifdef HEATNINJA_COUNT_ALLOCATIONS
+    // heap allocations made by the last simulate_heat_solar_combination of each heat & solar combination
+    extern std::array<size_t, 21> combination_heap_allocations;
+#endif
+
     std::string run_simulation(const float thermostat_temperature, const float latitude, const float longitude, const int num_occupants, const float house_size, const std::string& postcode, const int epc_space_heating, const float tes_volume_max, const SimulationOptions& simulation_options);
 
     float round_coordinate(const float coordinate);
 
     std::vector<float> import_weather_data(const std::string& data_type, const float latitude, const float longitude);
 
+    inline constexpr size_t hours_per_year = 8760;
+
+    // one value per line, hourly (8760) or half hourly (17520), throws on any other length & is empty when the file can't be read
     std::vector<float> import_per_hour_of_year_data(const std::string& filename);
 
-    std::array<float, 24> calculate_erh_hourly_temperature_profile(const float t);
+    // an hourly or half hourly series at steps_per_hour, hours are held over their steps & steps averaged over their hour
+    std::vector<float> resample_series(std::vector<float> series, const size_t steps_per_hour);
+
+    // the household helpers below are templated on the scalar, float or a Dual carrying sensitivities (see calculate_specification_sensitivities)
+    template <typename Scalar>
+    std::array<Scalar, 24> calculate_erh_hourly_temperature_profile(const Scalar t);
 
-    std::array<float, 24> calculate_hp_hourly_temperature_profile(const float t);
+    template <typename Scalar>
+    std::array<Scalar, 24> calculate_hp_hourly_temperature_profile(const Scalar t);
+
+    constexpr int calculate_cold_water_band(const float latitude) {
+        if (latitude < 52.2f) return 0; // South of England
+        else if (latitude < 53.3f) return 1; // Middle of England and Wales
+        else if (latitude < 54.95f) return 2; // North of England and Northern Ireland
+        else return 3; // Scotland
+    }
 
     std::array<float, 12> calculate_monthly_cold_water_temperatures(const float latitude);
 
@@ -59,15 +175,19 @@ namespace heatninja {
 
     float calculate_average_daily_hot_water_volume(const int num_occupants);
 
-    float calculate_solar_gain_house_factor(const float house_size);
+    template <typename Scalar>
+    Scalar calculate_solar_gain_house_factor(const Scalar house_size);
 
     float calculate_epc_body_gain(const float house_size);
 
-    float calculate_heat_capacity(const float house_size);
+    template <typename Scalar>
+    Scalar calculate_heat_capacity(const Scalar house_size);
 
     float calculate_body_heat_gain(const int num_occupants);
 
-    int calculate_region_identifier(const std::string& postcode);
+    int calculate_region_identifier(const std::string_view postcode);
+
+    std::vector<int> calculate_region_identifiers(const std::vector<std::string>& postcodes);
 
     std::array<float, 12> calculate_monthly_epc_outside_temperatures(int region_identifier);
 
@@ -79,15 +199,66 @@ namespace heatninja {
         float thermal_transmittance, optimised_epc_demand;
     };
 
+    // the transmittances the fit tries, 0.5 to 3.0 in 0.01 steps
+    const std::vector<float>& epc_thermal_transmittance_steps();
+
+    // yearly space heating demand of the EPC heating pattern at one transmittance
+    float calculate_epc_demand(const float thermal_transmittance, const float house_size, const float epc_body_gain, const std::array<float, 12>& monthly_epc_outside_temperatures, const std::array<float, 12>& monthly_solar_gains_south, const std::array<float, 12>& monthly_solar_gains_north, const float heat_capacity);
+
+    // scans up the steps until the demand stops getting closer to epc_space_heating
     ThermalTransmittanceAndOptimisedEpcDemand calculate_dwellings_thermal_transmittance(const float house_size, const float epc_body_gain, const std::array<float, 12>& monthly_epc_outside_temperatures, const std::array<int, 12>& monthly_epc_solar_irradiances, const std::array<float, 12>& monthly_solar_height_factors, const std::array<float, 12>& monthly_solar_declinations, const std::array<float, 12>& monthly_solar_gains_south, const std::array<float, 12>& monthly_solar_gains_north, const float heat_capacity, const int epc_space_heating);
 
-    struct Demand {
-        float total, max_hourly, space, hot_water;
+    // same result as calculate_dwellings_thermal_transmittance, starting from a step interpolated from epc_transmittance_table.h
+    // (see tools/generate_epc_table.cpp) so only a few demands are simulated, falls back to the scan outside the table
+    ThermalTransmittanceAndOptimisedEpcDemand lookup_dwellings_thermal_transmittance(const int region_identifier, const float house_size, const float epc_body_gain, const std::array<float, 12>& monthly_epc_outside_temperatures, const std::array<int, 12>& monthly_epc_solar_irradiances, const std::array<float, 12>& monthly_solar_height_factors, const std::array<float, 12>& monthly_solar_declinations, const std::array<float, 12>& monthly_solar_gains_south, const std::array<float, 12>& monthly_solar_gains_north, const float heat_capacity, const int epc_space_heating);
+
+    template <typename Scalar>
+    struct BasicDemand {
+        Scalar total, max_hourly, space, hot_water;
     };
 
-    Demand calculate_yearly_space_and_hot_water_demand(const std::array<float, 24>& hourly_temperatures_over_day, const float thermostat_temperature, const std::array<float, 12>& hot_water_monthly_factors, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 24>& dhw_hourly_ratios, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float average_daily_hot_water_volume, const int hot_water_temperature, const float solar_gain_house_factor, const float house_size, const float dwelling_thermal_transmittance, const float heat_capacity, const float body_heat_gain);
+    using Demand = BasicDemand<float>;
+
+    template <typename Scalar>
+    BasicDemand<Scalar> calculate_yearly_space_and_hot_water_demand(const std::array<Scalar, 24>& hourly_temperatures_over_day, const Scalar thermostat_temperature, const std::array<float, 12>& hot_water_monthly_factors, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 24>& dhw_hourly_ratios, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float average_daily_hot_water_volume, const int hot_water_temperature, const Scalar solar_gain_house_factor, const Scalar house_size, const float dwelling_thermal_transmittance, const Scalar heat_capacity, const float body_heat_gain);
 
-    void calculate_hourly_space_and_hot_water_demand(const std::array<float, 24>& hourly_temperatures_over_day, float& inside_temp_current, const float ratio_solar_gain_south, const float ratio_solar_gain_north, const float cwt_current, const float dhw_mf_current, float& demand_total, float& dhw_total, float& max_hourly_demand, const size_t hour_year_counter, const size_t hour, const std::array<float, 24>& dhw_hourly_ratios, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float average_daily_hot_water_volume, const int hot_water_temperature, const float solar_gain_house_factor, const float house_size, const float dwelling_thermal_transmittance, const float heat_capacity, const float body_heat_gain);
+    // an hour's inside temperature is max(scale * previous + offset, floor): the heat loss is affine in the previous temperature & the
+    // thermostat clamp a floor, the form is closed under composition since scale > 0, so a floor dominating any input resets the chain
+    struct InsideTemperatureMap {
+        float scale = 1, offset = 0, floor = -std::numeric_limits<float>::infinity();
+
+        float operator()(const float inside_temperature) const { return std::max(scale * inside_temperature + offset, floor); }
+    };
+
+    // then applies after
+    InsideTemperatureMap compose_inside_temperature_maps(const InsideTemperatureMap& first, const InsideTemperatureMap& then);
+
+    // same demand as calculate_yearly_space_and_hot_water_demand as a segmented scan over the days: each day's hourly maps are composed
+    // (in parallel with use_multithreading), a scan over the 365 day maps gives each day's starting temperature, then every day is
+    // re-run hour by hour from it (in parallel) so only the day boundaries go through the composed maps
+    Demand calculate_yearly_space_and_hot_water_demand_scan(const std::array<float, 24>& hourly_temperatures_over_day, const float thermostat_temperature, const std::array<float, 12>& hot_water_monthly_factors, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 24>& dhw_hourly_ratios, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float average_daily_hot_water_volume, const int hot_water_temperature, const float solar_gain_house_factor, const float house_size, const float dwelling_thermal_transmittance, const float heat_capacity, const float body_heat_gain, const bool use_multithreading);
+
+    template <typename Scalar>
+    void calculate_hourly_space_and_hot_water_demand(const std::array<Scalar, 24>& hourly_temperatures_over_day, Scalar& inside_temp_current, const float ratio_solar_gain_south, const float ratio_solar_gain_north, const float cwt_current, const float dhw_mf_current, Scalar& demand_total, Scalar& dhw_total, Scalar& max_hourly_demand, const size_t hour_year_counter, const size_t hour, const std::array<float, 24>& dhw_hourly_ratios, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float average_daily_hot_water_volume, const int hot_water_temperature, const Scalar solar_gain_house_factor, const Scalar house_size, const float dwelling_thermal_transmittance, const Scalar heat_capacity, const float body_heat_gain);
+
+    // demand screening
+
+    struct HouseholdDemandInputs {
+        float thermostat_temperature;
+        int num_occupants;
+        float house_size;
+        float dwelling_thermal_transmittance; // EPC fitted, from calculate_dwellings_thermal_transmittance
+    };
+
+    struct HouseholdDemand {
+        Demand erh, hp;
+    };
+
+    constexpr size_t demand_screening_lanes = 16; // households per block, one SIMD lane each
+
+    std::vector<HouseholdDemand> screen_household_demands(const std::vector<HouseholdDemandInputs>& households, const float latitude, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year);
+
+    void screen_household_demand_block(const HouseholdDemandInputs* households, const size_t count, HouseholdDemand* demands, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year);
 
     void write_demand_data(const std::string filename, const float dwelling_thermal_transmittance, const float optimised_epc_demand, const float yearly_erh_demand, const float maximum_hourly_erh_demand, const float yearly_erh_space_demand, const float yearly_erh_hot_water_demand, const float yearly_hp_demand, const float maximum_hourly_hp_demand, const float yearly_hp_space_demand, const float yearly_hp_hot_water_demand);
 
@@ -132,8 +303,48 @@ namespace heatninja {
         float net_present_cost;
 
         float operation_emissions;
+
+        float worst_net_present_cost = 0; // highest over the weather ensemble's years, whose mean is net_present_cost
+    };
+
+    struct GridCell {
+        bool available;
+        size_t cell_index; // position in grid_cell_assets, packed weather stores keep cells in this order
+        float coldest_outside_temperature;
+        int cold_water_band; // of the cell centre, see calculate_cold_water_band
     };
 
+    const GridCell* find_grid_cell(const float latitude, const float longitude);
+
+    // whole weather dataset kept resident as int16 with a per cell scale & offset, ~7.9 MB for 225 cells
+    // value = offset + scale * (q + 32768), scale = (max - min) / 65535 of the cell's series, so the decoded value is
+    // within scale / 2 of the csv value (plus float rounding): <= 0.0004 C for temperatures, <= 0.008 W/m2 for irradiances
+    struct QuantisedSeries {
+        float offset, scale;
+    };
+
+    // with more than one year every spec is costed over all of them, see run_simulation, the demand is sized on the first
+    struct WeatherStore {
+        size_t years = 1; // weather years per cell
+        // 8760 per year (half hourly csvs are averaged to hours), a cell's years consecutive, cells in grid_cell_assets order
+        std::vector<int16_t> outside_temperatures, solar_irradiances;
+        std::vector<QuantisedSeries> outside_temperature_scales, solar_irradiance_scales; // one per cell & year, in the same order
+        std::vector<float> agile_tariff_per_hour_over_year;
+    };
+
+    void quantise_series(const std::vector<float>& series, std::vector<int16_t>& quantised, QuantisedSeries& quantised_series);
+
+    // reads every grid cell's csvs & the agile tariff once. each of year_directories (relative to assets_directory) holds
+    // outside_temps/ & solar_irradiances/ for one year of an ensemble, empty reads the single year in assets_directory
+    WeatherStore load_weather_store(const std::string& assets_directory, const std::vector<std::string>& year_directories = {});
+
+    // adds synthetic_years years to every cell, each day drawn from within a week of the same date in one of the stored years
+    // the same dates are drawn for every cell, so the synthetic weather stays spatially coherent
+    void add_synthetic_weather_years(WeatherStore& weather_store, const size_t synthetic_years, const unsigned int seed);
+
+    // fills hourly_data with the 8760 hours of series series_index, cell_index * years + year in a WeatherStore
+    void decode_weather_series(const std::vector<int16_t>& quantised, const QuantisedSeries& quantised_series, const size_t series_index, std::vector<float>& hourly_data);
+
     float calculate_coldest_outside_temperature_of_year(const float latitude, const float longitude);
 
     float calculate_ground_temperature(const float latitude);
@@ -142,18 +353,62 @@ namespace heatninja {
 
     int calculate_solar_maximum(const float house_size);
 
-    float calculate_house_size_thermal_transmittance_product(const float house_size, const float dwelling_thermal_transmittance);
+    template <typename Scalar>
+    Scalar calculate_house_size_thermal_transmittance_product(const Scalar house_size, const float dwelling_thermal_transmittance);
 
-    const std::array<float, 24>& select_temp_profile(const HeatOption hp_option, const std::array<float, 24>& hp_temp_profile, const std::array<float, 24>& erh_temp_profile);
+    template <typename Scalar>
+    const std::array<Scalar, 24>& select_temp_profile(const HeatOption hp_option, const std::array<Scalar, 24>& hp_temp_profile, const std::array<Scalar, 24>& erh_temp_profile);
 
     float calculate_cop_worst(const HeatOption hp_option, const int hot_water_temp, const float coldest_outside_temp, const float ground_temp);
 
-    float calculate_hp_electrical_power(const HeatOption hp_option, const float max_hourly_erh_demand, const float max_hourly_hp_demand, const float cop_worst);
+    template <typename Scalar>
+    Scalar calculate_hp_electrical_power(const HeatOption hp_option, const Scalar max_hourly_erh_demand, const Scalar max_hourly_hp_demand, const float cop_worst, const float cop_ref);
 
     int calculate_solar_size_range(const SolarOption solar_option, const int solar_maximum);
 
     std::vector<size_t> linearly_space(float range, size_t segments);
 
+    // fills points in place, reusing its capacity
+    void linearly_space(float range, size_t segments, std::vector<size_t>& points);
+
+    // surface optimiser parameters, tuned per surface size & solar option by tools/tune_optimiser.cpp into optimiser_parameters.h
+    struct OptimiserParameters {
+        size_t min_step; // fewest subdivisions of the starting mesh along each axis
+        float gradient_factor; // scales the steepest starting gradient, lower subdivides fewer rects
+        int target_step; // starting mesh spacing in surface nodes
+    };
+
+    constexpr OptimiserParameters default_optimiser_parameters = { 3, 0.2f, 7 };
+
+    // the tuned band containing the surface, default_optimiser_parameters if there is none
+    OptimiserParameters select_optimiser_parameters(const size_t x_size, const size_t y_size, const SolarOption solar_option);
+
+    // surrogate search, a gaussian process with a squared exponential kernel over (tes_option, solar_size)
+    struct SurrogatePoint {
+        float x, y, z;
+    };
+
+    struct Surrogate {
+        double mean, deviation; // of the evaluated zs, the process works on normalised zs
+        float length_scale_x, length_scale_y;
+    };
+
+    struct SurrogatePrediction {
+        float mean, deviation;
+    };
+
+    // cholesky is the packed factor of the points it was last fitted to & is extended by the points appended since,
+    // so clear it when the points are replaced, weights are refilled, both reuse their capacity
+    Surrogate fit_surrogate(const std::vector<SurrogatePoint>& points, const float length_scale_x, const float length_scale_y, std::vector<double>& cholesky, std::vector<double>& weights);
+
+    // kernel_column is scratch
+    SurrogatePrediction predict_surrogate(const Surrogate& surrogate, const std::vector<SurrogatePoint>& points, const std::vector<double>& cholesky, const std::vector<double>& weights, const float x, const float y, std::vector<double>& kernel_column);
+
+    float calculate_expected_improvement(const float min_z, const float mean, const float deviation);
+
+    // true once the combination's time bounded search is out of time, which marks it as cut short
+    bool search_deadline_passed(const size_t combination_index);
+
     float min_4f(const float a, const float b, const float c, const float d);
 
     float get_or_calculate(const size_t i, const size_t j, const size_t x_size, float& min_z, std::vector<float>& zs,
@@ -162,13 +417,22 @@ namespace heatninja {
     void if_unset_calculate(const size_t i, const size_t j, const size_t x_size, float& min_z, std::vector<float>& zs,
         const HeatOption hp_option, const SolarOption solar_option, float& optimum_tes_npc, const int solar_maximum, const float cop_worst, const float hp_electrical_power, const float ground_temp, HeatSolarSystemSpecifications& optimal_spec, const std::array<float, 24>* temp_profile, const float thermostat_temperature, const int hot_water_temperature, const float cumulative_discount_rate, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_solar_declinations, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product);
 
-    void simulate_heat_solar_combination(const HeatOption hp_option, const SolarOption solar_option, const int solar_maximum, const int tes_range, const float ground_temp, HeatSolarSystemSpecifications& optimal_spec, const std::array<float, 24>& erh_hourly_temperatures_over_day, const std::array<float, 24>& hp_hourly_temperatures_over_day, const int hot_water_temperature, const float coldest_outside_temperature_of_year, const float maximum_hourly_erh_demand, const float maximum_hourly_hp_demand, const float thermostat_temperature, const float cumulative_discount_rate, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_solar_declinations, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product);
+    // a real day of the year standing in for weight days like it
+    struct RepresentativeDay {
+        int day_of_year, month;
+        float weight;
+    };
+
+    std::vector<RepresentativeDay> select_representative_days(const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const size_t clusters);
+
+    void simulate_heat_solar_combination(const HeatOption hp_option, const SolarOption solar_option, const int solar_maximum, const int tes_range, const float ground_temp, HeatSolarSystemSpecifications& optimal_spec, const std::array<float, 24>& erh_hourly_temperatures_over_day, const std::array<float, 24>& hp_hourly_temperatures_over_day, const int hot_water_temperature, const float coldest_outside_temperature_of_year, const float maximum_hourly_erh_demand, const float maximum_hourly_hp_demand, const float thermostat_temperature, const float cumulative_discount_rate, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_solar_declinations, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product, const std::vector<RepresentativeDay>& representative_days, const bool seed_only);
 
     int calculate_solar_thermal_size(const SolarOption solar_option, const int solar_size);
 
     int calculate_pv_size(const SolarOption solar_option, const int solar_size, const int solar_maximum, const int solar_thermal_size);
 
-    float calculate_capex_heatopt(const HeatOption hp_option, const float hp_electrical_power_worst);
+    template <typename Scalar>
+    Scalar calculate_capex_heatopt(const HeatOption hp_option, const Scalar hp_thermal_power);
 
     float calculate_capex_pv(const SolarOption solar_option, const int pv_size);
 
@@ -180,19 +444,64 @@ namespace heatninja {
 
     std::array<float, 12> calculate_roof_ratios_south(const std::array<float, 12>& monthly_solar_declinations, const float latitude);
 
+    struct TesCharges {
+        float radius, full, boost, max, min;
+    };
+
+    TesCharges calculate_tes_charges(const float tes_volume_current, const int hot_water_temperature);
+
+    template <typename Scalar>
+    struct BasicYearlyOperation {
+        Scalar operational_costs_peak, operational_costs_off_peak, operation_emissions;
+    };
+
+    using YearlyOperation = BasicYearlyOperation<float>;
+
+    // trace sinks for the hourly kernel, NullTraceSink compiles out completely
+    struct HourlyTrace {
+        float inside_temperature, tes_state_of_charge, cop, pv_generation, electrical_import, pv_export, operational_cost;
+    };
+
+    struct NullTraceSink {
+        static constexpr bool enabled = false;
+        void record(const HourlyTrace&) {}
+    };
+
+    struct HourlyTraceRecorder {
+        static constexpr bool enabled = true;
+        std::vector<HourlyTrace> hours;
+        void record(const HourlyTrace& hour) { hours.push_back(hour); }
+    };
+
+    // the operational kernels step steps_per_hour times an hour, the weather & agile series they take hold a value per step
+    // Scalar is float or a Dual, whose runs take the float run's branches, the optimal dispatch plan is made on the values
+    template <typename TraceSink, size_t steps_per_hour = 1, typename Scalar = float>
+    BasicYearlyOperation<Scalar> simulate_heating_system_for_year(const std::array<Scalar, 24>* temp_profile, const Scalar thermostat_temperature, const TesCharges& tes_charges, const float ground_temp, const HeatOption hp_option, const SolarOption solar_option, const int pv_size, const int solar_thermal_size, const Scalar hp_electrical_power, const Tariff tariff, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const Scalar heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int hot_water_temperature, const int grid_emissions, const Scalar solar_gain_house_factor, const float body_heat_gain, const Scalar house_size_thermal_transmittance_product, TraceSink& trace_sink);
+
+    template <size_t steps_per_hour = 1>
+    YearlyOperation simulate_heating_system_for_representative_days(const std::vector<RepresentativeDay>& representative_days, const std::array<float, 24>* temp_profile, const float thermostat_temperature, const TesCharges& tes_charges, const float ground_temp, const HeatOption hp_option, const SolarOption solar_option, const int pv_size, const int solar_thermal_size, const float hp_electrical_power, const Tariff tariff, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int hot_water_temperature, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product);
+
     float calculate_optimal_tariff(const HeatOption hp_option, const SolarOption solar_option, const int solar_size, float& optimum_tes_npc, const int solar_maximum, const int tes_option, const float cop_worst, const float hp_electrical_power, const float ground_temp, HeatSolarSystemSpecifications& optimal_spec, const std::array<float, 24>* temp_profile, const float thermostat_temperature, const int hot_water_temperature, const float cumulative_discount_rate, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_solar_declinations, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product);
 
-    void calculate_inside_temp_change(float& inside_temp_current, const float outside_temp_current, const float solar_irradiance_current, const float ratio_sg_south, const float ratio_sg_north, const float ratio_roof_south, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product, const float heat_capacity);
+    float calculate_coarse_npc(const HeatOption hp_option, const SolarOption solar_option, const int solar_size, const int solar_maximum, const int tes_option, const float hp_electrical_power, const float ground_temp, const std::array<float, 24>* temp_profile, const float thermostat_temperature, const int hot_water_temperature, const float cumulative_discount_rate, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product, const std::vector<RepresentativeDay>& representative_days);
 
-    struct TesTempAndHeight {
-        float upper_temperature, lower_temperature, thermocline_height;
+    template <typename Scalar>
+    void calculate_inside_temp_change(Scalar& inside_temp_current, const float outside_temp_current, const float solar_irradiance_current, const float ratio_sg_south, const float ratio_sg_north, const float ratio_roof_south, const Scalar solar_gain_house_factor, const float body_heat_gain, const Scalar house_size_thermal_transmittance_product, const Scalar heat_capacity);
 
-        TesTempAndHeight(const float upper_temperature, const float lower_temperature, const float thermocline_height);
+    template <typename Scalar>
+    struct BasicTesTempAndHeight {
+        float upper_temperature, lower_temperature;
+        Scalar thermocline_height;
 
-        float clamp_height(const float height);
+        BasicTesTempAndHeight(const float upper_temperature, const float lower_temperature, const Scalar thermocline_height);
+
+        Scalar clamp_height(const Scalar height);
     };
 
-    TesTempAndHeight calculate_tes_temp_and_thermocline_height(const float tes_state_of_charge, const float tes_charge_full, const float tes_charge_max, const float tes_charge_boost, const float cwt_current);
+    using TesTempAndHeight = BasicTesTempAndHeight<float>;
+
+    template <typename Scalar>
+    BasicTesTempAndHeight<Scalar> calculate_tes_temp_and_thermocline_height(const Scalar tes_state_of_charge, const float tes_charge_full, const float tes_charge_max, const float tes_charge_boost, const float cwt_current);
 
     struct CopCurrentAndBoost
     {
@@ -206,27 +515,78 @@ namespace heatninja {
 
     float calculate_solar_thermal_generation_current(const SolarOption solar_option, const float tes_upper_temperature, const float tes_lower_temperature, const int solar_thermal_size, const float incident_irradiance_roof_south, const float outside_temp_current);
 
-    float calculate_hourly_space_demand(float& inside_temp_current, const float desired_min_temp_current, const float cop_current, const float tes_state_of_charge, const float dhw_hr_demand, const float hp_electrical_power, const float heat_capacity);
+    template <typename Scalar>
+    Scalar calculate_hourly_space_demand(Scalar& inside_temp_current, const Scalar desired_min_temp_current, const float cop_current, const Scalar tes_state_of_charge, const float dhw_hr_demand, const Scalar hp_electrical_power, const Scalar heat_capacity);
 
-    float calculate_electrical_demand_for_heating(float& tes_state_of_charge, const float space_water_demand, const float hp_electrical_power, const float cop_current);
+    template <typename Scalar>
+    Scalar calculate_electrical_demand_for_heating(Scalar& tes_state_of_charge, const Scalar space_water_demand, const Scalar hp_electrical_power, const float cop_current);
 
-    void calculate_electrical_demand_for_tes_charging(float& electrical_demand_current, float& tes_state_of_charge, const float tes_charge_full, const Tariff tariff, const int hour, const float hp_electrical_power, const float cop_current, const float agile_tariff_current);
+    template <typename Scalar>
+    void calculate_electrical_demand_for_tes_charging(Scalar& electrical_demand_current, Scalar& tes_state_of_charge, const float tes_charge_full, const Tariff tariff, const int hour, const Scalar hp_electrical_power, const float cop_current, const float agile_tariff_current);
 
-    void boost_tes_and_electrical_demand(float& tes_state_of_charge, float& electrical_demand_current, const float pv_remaining_current, const float tes_charge_boost, const float hp_electrical_power, const float cop_boost);
+    template <typename Scalar>
+    void boost_tes_and_electrical_demand(Scalar& tes_state_of_charge, Scalar& electrical_demand_current, const Scalar pv_remaining_current, const float tes_charge_boost, const Scalar hp_electrical_power, const float cop_boost);
 
-    void recharge_tes_to_minimum(float& tes_state_of_charge, float& electrical_demand_current, const float tes_charge_min, const float hp_electrical_power, const float cop_current);
+    template <typename Scalar>
+    void recharge_tes_to_minimum(Scalar& tes_state_of_charge, Scalar& electrical_demand_current, const float tes_charge_min, const Scalar hp_electrical_power, const float cop_current);
 
-    void add_electrical_import_cost_to_opex(float& operational_costs_off_peak, float& operational_costs_peak, const float electrical_import, const Tariff tariff, const float agile_tariff_current, const int hour);
+    // tes state of charge to reach by the end of each step of the day starting at step_year_counter, planned over the day & the following night
+    template <size_t steps_per_hour = 1>
+    std::array<float, 24 * steps_per_hour> plan_tes_charging(const std::array<float, 24>* temp_profile, float inside_temp_current, const float ratio_sg_south, const float ratio_sg_north, const float cwt_current, const float dhw_mf_current, const float tes_state_of_charge, const float tes_charge_full, const float tes_charge_boost, const float tes_charge_max, const float tes_radius, const float ground_temp, const HeatOption hp_option, const SolarOption solar_option, const int pv_size, const int solar_thermal_size, const float hp_electrical_power, const Tariff tariff, const float ratio_roof_south, const size_t step_year_counter, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int hot_water_temperature, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product);
 
-    void subtract_pv_revenue_from_opex(float& operational_costs_off_peak, float& operational_costs_peak, const float pv_equivalent_revenue, const Tariff tariff, const float agile_tariff_current, const int hour);
+    template <typename Scalar>
+    void charge_tes_to_plan(Scalar& tes_state_of_charge, Scalar& electrical_demand_current, const float tes_charge_planned, const float tes_charge_full, const Scalar hp_electrical_power, const float cop_current, const float cop_boost);
+
+    template <typename Scalar>
+    void add_electrical_import_cost_to_opex(Scalar& operational_costs_off_peak, Scalar& operational_costs_peak, const Scalar electrical_import, const Tariff tariff, const float agile_tariff_current, const int hour);
+
+    template <typename Scalar>
+    void subtract_pv_revenue_from_opex(Scalar& operational_costs_off_peak, Scalar& operational_costs_peak, const Scalar pv_equivalent_revenue, const Tariff tariff, const float agile_tariff_current, const int hour);
 
     float calculate_emissions_solar_thermal(const float solar_thermal_generation_current);
 
-    float calculate_emissions_pv_generation(const float pv_generation_current, const float pv_equivalent_revenue, const int grid_emissions, const int pv_size);
+    template <typename Scalar>
+    Scalar calculate_emissions_pv_generation(const float pv_generation_current, const Scalar pv_equivalent_revenue, const int grid_emissions, const int pv_size);
+
+    template <typename Scalar>
+    Scalar calculate_emissions_grid_import(const Scalar electrical_import, const int grid_emissions);
+
+    template <typename TraceSink, size_t steps_per_hour = 1, typename Scalar = float>
+    void simulate_heating_system_for_day(const std::array<Scalar, 24>* temp_profile, Scalar& inside_temp_current, const float ratio_sg_south, const float ratio_sg_north, const float cwt_current, float dhw_mf_current, Scalar& tes_state_of_charge, const float tes_charge_full, const float tes_charge_boost, const float tes_charge_max, const float tes_radius, const float ground_temp, const HeatOption hp_option, const SolarOption solar_option, const int pv_size, const int solar_thermal_size, const Scalar hp_electrical_power, const Tariff tariff, Scalar& operational_costs_peak, Scalar& operational_costs_off_peak, Scalar& operation_emissions, float& solar_thermal_generation_total, const float ratio_roof_south, const float tes_charge_min, size_t& step_year_counter, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const Scalar heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int hot_water_temperature, const int grid_emissions, const Scalar solar_gain_house_factor, const float body_heat_gain, const Scalar house_size_thermal_transmittance_product, TraceSink& trace_sink);
+
+    std::vector<HourlyTrace> trace_heat_solar_specification(const HeatSolarSystemSpecifications& spec, const float ground_temp, const std::array<float, 24>& erh_hourly_temperatures_over_day, const std::array<float, 24>& hp_hourly_temperatures_over_day, const int hot_water_temperature, const float coldest_outside_temperature_of_year, const float maximum_hourly_erh_demand, const float maximum_hourly_hp_demand, const float thermostat_temperature, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product);
+
+    void write_hourly_traces(const HeatSolarSystemSpecifications& spec, const std::vector<HourlyTrace>& hourly_traces, std::ofstream& file);
+
+    // sensitivities, by the index of each input's derivative in SensitivityScalar
+    enum class SensitivityInput : size_t {
+        HouseSize = 0, // floor area in m2, the fitted thermal transmittance & the solar maximum are held
+        ThermostatTemperature = 1, // degrees C
+        HeatPumpPrice = 2 // multiplier on the heat option's capex, 1 as simulated
+    };
 
-    float calculate_emissions_grid_import(const float electrical_import, const int grid_emissions);
+    inline constexpr size_t sensitivity_input_count = 3;
+    inline constexpr std::array<std::string_view, sensitivity_input_count> sensitivity_inputs_json = { "house-size", "thermostat-temperature", "heat-pump-price" };
 
-    void simulate_heating_system_for_day(const std::array<float, 24>* temp_profile, float& inside_temp_current, const float ratio_sg_south, const float ratio_sg_north, const float cwt_current, float dhw_mf_current, float& tes_state_of_charge, const float tes_charge_full, const float tes_charge_boost, const float tes_charge_max, const float tes_radius, const float ground_temp, const HeatOption hp_option, const SolarOption solar_option, const int pv_size, const int solar_thermal_size, const float hp_electrical_power, const Tariff tariff, float& operational_costs_peak, float& operational_costs_off_peak, float& operation_emissions, float& solar_thermal_generation_total, const float ratio_roof_south, const float tes_charge_min, size_t& hour_year_counter, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const float heat_capacity, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int hot_water_temperature, const int grid_emissions, const float solar_gain_house_factor, const float body_heat_gain, const float house_size_thermal_transmittance_product);
+    using SensitivityScalar = Dual<sensitivity_input_count>;
+
+    // the household's inputs seeded as dual variables & the demand run on them, shared by every spec's sensitivities
+    struct SensitivityHousehold {
+        SensitivityScalar thermostat_temperature, heat_pump_price_scale, solar_gain_house_factor, heat_capacity, house_size_thermal_transmittance_product, maximum_hourly_erh_demand, maximum_hourly_hp_demand;
+        std::array<SensitivityScalar, 24> erh_hourly_temperatures_over_day, hp_hourly_temperatures_over_day;
+    };
+
+    SensitivityHousehold seed_sensitivity_household(const float thermostat_temperature, const float house_size, const float dwelling_thermal_transmittance, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 24>& hot_water_hourly_ratios, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float average_daily_hot_water_volume, const int hot_water_temperature, const float body_heat_gain);
+
+    // values equal the spec's, derivatives are with respect to each SensitivityInput
+    struct SpecificationSensitivities {
+        SensitivityScalar operational_expenditure, capital_expenditure, net_present_cost, operation_emissions;
+    };
+
+    // one forward pass re-running the spec's sizing, capex & year (every ensemble year) on dual numbers, with the spec's tariff & tes held
+    SpecificationSensitivities calculate_specification_sensitivities(const HeatSolarSystemSpecifications& spec, const SensitivityHousehold& household, const float ground_temp, const int hot_water_temperature, const float coldest_outside_temperature_of_year, const float cumulative_discount_rate, const std::array<float, 12>& monthly_solar_gain_ratios_north, const std::array<float, 12>& monthly_solar_gain_ratios_south, const std::array<float, 12>& monthly_cold_water_temperatures, const std::array<float, 12>& dhw_monthly_factors, const std::array<float, 12>& monthly_roof_ratios_south, const std::vector<float>& hourly_outside_temperatures_over_year, const std::vector<float>& hourly_solar_irradiances_over_year, const float u_value, const std::vector<float>& agile_tariff_per_hour_over_year, const std::array<float, 24>& hot_water_hourly_ratios, const float average_daily_hot_water_volume, const int grid_emissions, const float body_heat_gain);
+
+    std::string specification_sensitivities_to_json(const SpecificationSensitivities& sensitivities);
 
     void print_optimal_specifications(const std::array<HeatSolarSystemSpecifications, 21>& optimal_specifications, const int float_print_precision);
 
@@ -234,7 +594,80 @@ namespace heatninja {
 
     void write_optimal_specifications(const std::array<HeatSolarSystemSpecifications, 21>& optimal_specifications, const std::string& filename);
 
+    void write_all_specs_binary(const std::array<std::vector<HeatSolarSystemSpecifications>, 21>& all_specs_buffers, const std::string& filename);
+
+    std::vector<HeatSolarSystemSpecifications> read_all_specs_binary(const std::string& filename);
+
+    // true if a is no worse than b in every objective, equal specs count as dominated so the frontier holds no duplicates
+    bool dominates(const HeatSolarSystemSpecifications& a, const HeatSolarSystemSpecifications& b, const bool against_capex);
+
+    // online update, drops the candidate if it is dominated, otherwise removes the specs it dominates and adds it
+    void update_pareto_frontier(std::vector<HeatSolarSystemSpecifications>& pareto_frontier, const HeatSolarSystemSpecifications& candidate, const bool against_capex);
+
+    std::string pareto_frontier_to_json(std::vector<HeatSolarSystemSpecifications> pareto_frontier);
+
+    // yearly import cost & export revenue of a traced spec, repricing scales these instead of re-simulating
+    struct RepricingTotals {
+        float import_cost, export_revenue;
+    };
+
+    // one entry per scenario in each vector
+    struct PriceScenarios {
+        std::vector<float> import_price_multipliers, export_price_multipliers, capex_multipliers, cumulative_discount_rates;
+        std::vector<size_t> weather_years; // the ensemble year each scenario is priced on, 0 is the first
+    };
+
+    struct NpcDistribution {
+        float p5, p50, p95, mean;
+    };
+
+    RepricingTotals calculate_repricing_totals(const Tariff tariff, const std::vector<HourlyTrace>& hourly_traces, const std::vector<float>& agile_tariff_per_hour_over_year);
+
+    // each scenario draws a weather year uniformly, so with a weather ensemble the spread includes the weather's as well as the prices'
+    PriceScenarios sample_price_scenarios(const MonteCarloOptions& monte_carlo, const int npc_years, const size_t weather_years);
+
+    // repricing_totals has one entry per weather year, npcs is scratch, resized to the scenario count
+    NpcDistribution reprice_specification(const HeatSolarSystemSpecifications& spec, const std::vector<RepricingTotals>& repricing_totals, const PriceScenarios& price_scenarios, std::vector<float>& npcs);
+
+    // json keys of the heat & solar options, by HeatOption & SolarOption value
+    inline constexpr std::array<std::string_view, 3> heat_options_json = { "electric-boiler", "air-source-heat-pump", "ground-source-heat-pump" };
+    inline constexpr std::array<std::string_view, 7> solar_options_json = { "none", "photovoltaic", "flat-plate", "evacuated-tube", "flat-plate-and-photovoltaic", "evacuated-tube-and-photovoltaic", "photovoltaic-thermal-hybrid" };
+
+    // pareto_frontier, npc_distribution, search_complete, weather_years & sensitivities are left out of the object when null
+    std::string heat_solar_system_to_json(const HeatSolarSystemSpecifications& spec, const std::vector<HeatSolarSystemSpecifications>* pareto_frontier, const NpcDistribution* npc_distribution, const bool* search_complete, const size_t* weather_years, const SpecificationSensitivities* sensitivities);
+
     std::string output_to_javascript(const std::array<HeatSolarSystemSpecifications, 21>& optimal_specifications);
 
-    std::string calculate_hydrogen_gas_biomass_systems(const float yearly_erh_demand, const float yearly_hp_demand, const int epc_space_heating, const float cumulative_discount_rate, const int npc_years, const int grid_emissions);
+    struct FixedCostSystem {
+        float operational_expenditure, capital_expenditure, net_present_cost, operation_emissions;
+    };
+
+    // grey, blue & green hydrogen boilers, grey, blue & green hydrogen fuel cells, then the gas & biomass boilers
+    std::array<FixedCostSystem, 8> calculate_hydrogen_gas_biomass_systems(const float yearly_erh_demand, const float yearly_hp_demand, const int epc_space_heating, const float cumulative_discount_rate, const int npc_years, const int grid_emissions);
+
+    // the members of the "systems" object after the heat & solar systems
+    std::string fixed_cost_systems_to_json(const std::array<FixedCostSystem, 8>& fixed_cost_systems);
+
+    std::string household_demand_to_json(const HouseholdDemand& demand);
+
+    // {"demand":...,"systems":{...},"search-complete-systems":N}, search_complete_systems is only added by time bounded runs
+    std::string assemble_result_json(const std::string& demand_json, const std::array<std::string, 21>& systems_json, const size_t* search_complete_systems, const std::string& fixed_cost_systems_json);
+
+    // everything run_simulation's json holds but the optional parts, heat & solar systems in heat_option * 7 + solar_option order
+    struct SimulationResult {
+        HouseholdDemand demand;
+        std::array<HeatSolarSystemSpecifications, 21> systems;
+        std::array<FixedCostSystem, 8> fixed_cost_systems;
+    };
+
+    // run_simulation's json of the result, as returned by a run without pareto frontiers, monte carlo, time budget or weather ensemble
+    std::string simulation_result_to_json(const SimulationResult& result);
+
+    // fixed layout, native byte order (little endian on every target), 764 bytes:
+    // "HNRESLT1", uint32 system count (21), uint32 fixed cost system count (8), erh then hp demand as float total, max_hourly, space, hot_water,
+    // each heat & solar system as an all specs record (see write_all_specs_binary), each fixed cost system as float opex, capex, npc, emissions
+    std::vector<char> encode_binary_result(const SimulationResult& result);
+
+    // throws std::runtime_error unless bytes hold an encode_binary_result of the same layout
+    SimulationResult decode_binary_result(const char* bytes, const size_t size);
 }
\ No newline at end of file
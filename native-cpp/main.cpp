@@ -3,6 +3,10 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+#include <filesystem>
+#include <cstdint>
 
 #ifndef EM_COMPATIBLE
 #include <chrono>
@@ -13,6 +17,11 @@ void runSimulationWithDefaultParameters();
 extern "C" {
     const char* run_simulation(const char* postcode_char, float latitude, float longitude,
         int num_occupants, float house_size, float temp, int epc_space_heating, float tes_volume_max, bool use_optimisation_surfaces);
+    const char* run_simulation_streaming(const char* postcode_char, float latitude, float longitude,
+        int num_occupants, float house_size, float temp, int epc_space_heating, float tes_volume_max, bool use_optimisation_surfaces, void (*on_result)(const char* key, const char* json));
+    const uint8_t* run_simulation_binary(const char* postcode_char, float latitude, float longitude,
+        int num_occupants, float house_size, float temp, int epc_space_heating, float tes_volume_max, bool use_optimisation_surfaces, size_t* length);
+    const char* binary_result_to_json(const uint8_t* bytes, size_t length);
 }
 
 // FUNCTION DEFINITIONS
@@ -73,10 +82,83 @@ void runSimulationWithDefaultParameters()
 #endif
 }
 
-void readInputFile(std::string filename) {
-    std::ifstream infile(filename);
+struct Shard {
+    size_t index;
+    size_t count;
+};
+
+Shard parseShard(const std::string& shard_str) {
+    // "k/N", k counted from 0
+    const size_t slash = shard_str.find('/');
+    if (slash == std::string::npos) {
+        throw std::invalid_argument("shard must be k/N: " + shard_str);
+    }
+    const Shard shard = { std::stoul(shard_str.substr(0, slash)), std::stoul(shard_str.substr(slash + 1)) };
+    if (shard.count == 0 || shard.index >= shard.count) {
+        throw std::invalid_argument("shard must satisfy 0 <= k < N: " + shard_str);
+    }
+    return shard;
+}
+
+std::unordered_set<size_t> readCheckpoint(const std::string& checkpoint_filename) {
+    std::unordered_set<size_t> completed_row_ids;
+    std::ifstream checkpoint_file(checkpoint_filename);
     std::string line;
-    int i = 0;
+    while (std::getline(checkpoint_file, line)) {
+        // a torn last line from a crash is ignored, that row is simply run again
+        if (!line.empty() && line.find_first_not_of("0123456789") == std::string::npos) {
+            completed_row_ids.insert(std::stoul(line));
+        }
+    }
+    return completed_row_ids;
+}
+
+void truncateToLastLine(const std::string& filename) {
+    // drops a torn last line left by a crash mid-write, so the next append starts a line of its own
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file) return;
+    std::streamoff length = file.tellg();
+    std::streamoff kept = 0;
+    char c;
+    while (length > 0) {
+        file.seekg(length - 1);
+        file.get(c);
+        if (c == '\n') {
+            kept = length;
+            break;
+        }
+        --length;
+    }
+    file.close();
+    if (kept >= 0 && static_cast<std::uintmax_t>(kept) != std::filesystem::file_size(filename)) std::filesystem::resize_file(filename, static_cast<std::uintmax_t>(kept));
+}
+
+void runBatch(const std::string& input_filename, const std::string& output_filename, const Shard shard) {
+    // rows are assigned to shards by row_id % N, so separate processes only share the input file
+    // each result is flushed to the append-only output before its row_id is flushed to the checkpoint,
+    // a crash between the two can leave a duplicate row_id in the output which readers should keep the last of,
+    // a crash mid-line leaves a torn line, cut off here before appending
+    const std::string checkpoint_filename = output_filename + ".checkpoint";
+    truncateToLastLine(output_filename);
+    truncateToLastLine(checkpoint_filename);
+    const std::unordered_set<size_t> completed_row_ids = readCheckpoint(checkpoint_filename);
+
+    std::ifstream infile(input_filename);
+    if (!infile) {
+        throw std::runtime_error("could not open input file: " + input_filename);
+    }
+    std::ofstream output_file(output_filename, std::ios::app);
+    std::ofstream checkpoint_file(checkpoint_filename, std::ios::app);
+
+    // the whole weather dataset stays resident, so rows read no files
+    const heatninja::WeatherStore weather_store = heatninja::load_weather_store("assets");
+    heatninja::SimulationOptions simulation_options = { false, false, false, 0, false, true };
+    simulation_options.weather_store = &weather_store;
+
+    std::string line;
+    size_t row_id = 0;
+    size_t rows_run = 0;
+    size_t rows_failed = 0;
     while (std::getline(infile, line))
     {
         std::stringstream ss(line);
@@ -85,38 +167,52 @@ void readInputFile(std::string filename) {
         std::getline(ss, postcode, ',');
 
         if (postcode == "postcode") continue;
-        ++i;
-        if (i < 70) {
+        const size_t current_row_id = row_id++;
+        if (current_row_id % shard.count != shard.index || completed_row_ids.contains(current_row_id)) {
             continue;
         }
 
-        std::string temporary;
+        // a bad row (unparsable, unknown postcode or cell) is logged & left out of the checkpoint, so a rerun retries it
+        try {
+            std::string temporary;
+
+            std::getline(ss, temporary, ',');
+            float latitude = std::stof(temporary);
 
-        std::getline(ss, temporary, ',');
-        float latitude = std::stof(temporary);
+            std::getline(ss, temporary, ',');
+            float longitude = std::stof(temporary);
 
-        std::getline(ss, temporary, ',');
-        float longitude = std::stof(temporary);
+            std::getline(ss, temporary, ',');
+            int num_occupants = std::stoi(temporary);
 
-        std::getline(ss, temporary, ',');
-        int num_occupants = std::stoi(temporary);
+            std::getline(ss, temporary, ',');
+            float house_size = std::stof(temporary);
 
-        std::getline(ss, temporary, ',');
-        float house_size = std::stof(temporary);
+            std::getline(ss, temporary, ',');
+            float temp = std::stof(temporary);
 
-        std::getline(ss, temporary, ',');
-        float temp = std::stof(temporary);
+            std::getline(ss, temporary, ',');
+            int epc_space_heating = std::stoi(temporary);
 
-        std::getline(ss, temporary, ',');
-        int epc_space_heating = std::stoi(temporary);
+            std::getline(ss, temporary, ',');
+            float tes_volume_max = std::stof(temporary);
 
-        std::getline(ss, temporary, ',');
-        float tes_volume_max = std::stof(temporary);
+            std::cout << current_row_id << ": " << postcode << ", " << latitude << ", " << longitude << ", " << num_occupants << ", " << house_size << ", " << temp << ", " << epc_space_heating << ", " << tes_volume_max << ", " << '\n';
+            const std::string result = heatninja::run_simulation(temp, latitude, longitude, num_occupants, house_size, postcode, epc_space_heating, tes_volume_max, simulation_options);
 
-        std::cout << postcode << ", " << latitude << ", " << longitude << ", " << num_occupants << ", " << house_size << ", " << temp << ", " << epc_space_heating << ", " << tes_volume_max << ", " << '\n';
-        run_simulation(postcode.c_str(), latitude, longitude, num_occupants, house_size, temp, epc_space_heating, tes_volume_max, true);
+            output_file << current_row_id << ',' << result << '\n';
+            output_file.flush();
+            checkpoint_file << current_row_id << '\n';
+            checkpoint_file.flush();
+            ++rows_run;
+        }
+        catch (const std::exception& e) {
+            std::cerr << current_row_id << ": failed, " << e.what() << '\n';
+            ++rows_failed;
+        }
     }
     infile.close();
+    std::cout << "Shard " << shard.index << "/" << shard.count << ": " << rows_run << " rows run, " << rows_failed << " rows failed, " << completed_row_ids.size() << " rows already completed\n";
 }
 
 // FUNCTIONS ACCESSIBLE FROM JAVASCRIPT
@@ -140,9 +236,91 @@ extern "C" {
         result_char[java_script_output.size()] = '\0';
         return result_char;
     }
+
+    // as run_simulation, also handing each part of the result to on_result as soon as it is ready
+    // key is "demand", "<heat option>/<solar option>" (e.g. "air-source-heat-pump/photovoltaic") or "fixed-cost-systems"
+    const char* run_simulation_streaming(const char* postcode_char, float latitude, float longitude,
+        int num_occupants, float house_size, float thermostat_temperature, int epc_space_heating, float tes_volume_max, bool use_optimisation_surfaces, void (*on_result)(const char* key, const char* json))
+    {
+        const std::string postcode(postcode_char);
+
+        heatninja::ResultStream result_stream;
+        result_stream.on_demand = [on_result](std::string_view demand_json) {
+            on_result("demand", std::string(demand_json).c_str());
+        };
+        result_stream.on_system = [on_result](const heatninja::HeatSolarSystemSpecifications& spec, std::string_view system_json) {
+            const std::string key = std::string(heatninja::heat_options_json.at(static_cast<int>(spec.heat_option))) + "/" + std::string(heatninja::solar_options_json.at(static_cast<int>(spec.solar_option)));
+            on_result(key.c_str(), std::string(system_json).c_str());
+        };
+        result_stream.on_fixed_cost_systems = [on_result](std::string_view fixed_cost_systems_json) {
+            on_result("fixed-cost-systems", std::string(fixed_cost_systems_json).c_str());
+        };
+
+        heatninja::SimulationOptions simulation_options = { false, false, false, 0, false, use_optimisation_surfaces };
+        simulation_options.result_stream = &result_stream;
+        const std::string java_script_output = heatninja::run_simulation(thermostat_temperature, latitude, longitude, num_occupants, house_size, postcode, epc_space_heating, tes_volume_max, simulation_options);
+
+        char* result_char = new char[java_script_output.size() + 1];
+        std::copy(java_script_output.begin(), java_script_output.end(), result_char);
+        result_char[java_script_output.size()] = '\0';
+        return result_char;
+    }
+
+    // as run_simulation without formatting any json, the result is *length bytes laid out as heatninja::encode_binary_result
+    // so javascript can read it through a DataView over the wasm heap
+    const uint8_t* run_simulation_binary(const char* postcode_char, float latitude, float longitude,
+        int num_occupants, float house_size, float thermostat_temperature, int epc_space_heating, float tes_volume_max, bool use_optimisation_surfaces, size_t* length)
+    {
+        const std::string postcode(postcode_char);
+
+        heatninja::SimulationResult simulation_result;
+        heatninja::SimulationOptions simulation_options = { false, false, false, 0, false, use_optimisation_surfaces };
+        simulation_options.result = &simulation_result;
+        simulation_options.output_json = false;
+        heatninja::run_simulation(thermostat_temperature, latitude, longitude, num_occupants, house_size, postcode, epc_space_heating, tes_volume_max, simulation_options);
+
+        const std::vector<char> bytes = heatninja::encode_binary_result(simulation_result);
+        uint8_t* result_bytes = new uint8_t[bytes.size()];
+        std::copy(bytes.begin(), bytes.end(), result_bytes);
+        *length = bytes.size();
+        return result_bytes;
+    }
+
+    // run_simulation's json of a run_simulation_binary result, only needed where json is asked for
+    const char* binary_result_to_json(const uint8_t* bytes, size_t length)
+    {
+        const std::string java_script_output = heatninja::simulation_result_to_json(heatninja::decode_binary_result(reinterpret_cast<const char*>(bytes), length));
+
+        char* result_char = new char[java_script_output.size() + 1];
+        std::copy(java_script_output.begin(), java_script_output.end(), result_char);
+        result_char[java_script_output.size()] = '\0';
+        return result_char;
+    }
 }
 
-int main()
+int main(int argc, char* argv[])
 {
-    runSimulationWithDefaultParameters();
+    // heatninja <input.csv> <output> [--shard k/N], without arguments the default household is run
+    // anything else is rejected, a shard flag that went unnoticed would have every node run every row
+    const std::string usage = "usage: heatninja [<input.csv> <output> [--shard k/N]]\n";
+    if (argc == 1) {
+        runSimulationWithDefaultParameters();
+        return 0;
+    }
+    if (argc != 3 && !(argc == 5 && std::string(argv[3]) == "--shard")) {
+        std::cerr << usage;
+        return 1;
+    }
+    Shard shard = { 0, 1 };
+    if (argc == 5) {
+        try {
+            shard = parseShard(argv[4]);
+        }
+        catch (const std::exception& e) {
+            std::cerr << e.what() << '\n' << usage;
+            return 1;
+        }
+    }
+    runBatch(argv[1], argv[2], shard);
+    return 0;
 }
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+// GENERATED by tools/tune_optimiser.cpp, do not edit
+#include <array>
+#include <cstddef>
+
+namespace heatninja {
+    struct TunedOptimiserParameters {
+        int solar_option;
+        size_t x_size_max, y_size_max; // inclusive bounds of the surface size band
+        size_t min_step;
+        float gradient_factor;
+        int target_step;
+    };
+
+    constexpr std::array<TunedOptimiserParameters, 54> tuned_optimiser_parameters = { {
+        { 1, 8, 8, 3, 0.1f, 5 },
+        { 1, 8, 16, 3, 0.2f, 7 },
+        { 1, 8, static_cast<size_t>(-1), 3, 0.1f, 7 },
+        { 1, 16, 8, 3, 0.2f, 7 },
+        { 1, 16, 16, 2, 0.1f, 7 },
+        { 1, 16, static_cast<size_t>(-1), 3, 0.2f, 7 },
+        { 1, static_cast<size_t>(-1), 8, 2, 0.1f, 5 },
+        { 1, static_cast<size_t>(-1), 16, 3, 0.2f, 7 },
+        { 1, static_cast<size_t>(-1), static_cast<size_t>(-1), 3, 0.1f, 10 },
+        { 2, 8, 8, 3, 0.1f, 5 },
+        { 2, 8, 16, 3, 0.2f, 7 },
+        { 2, 8, static_cast<size_t>(-1), 2, 0.1f, 5 },
+        { 2, 16, 8, 3, 0.2f, 7 },
+        { 2, 16, 16, 2, 0.1f, 7 },
+        { 2, 16, static_cast<size_t>(-1), 3, 0.2f, 7 },
+        { 2, static_cast<size_t>(-1), 8, 2, 0.1f, 7 },
+        { 2, static_cast<size_t>(-1), 16, 3, 0.2f, 7 },
+        { 2, static_cast<size_t>(-1), static_cast<size_t>(-1), 3, 0.1f, 10 },
+        { 3, 8, 8, 3, 0.1f, 5 },
+        { 3, 8, 16, 3, 0.2f, 7 },
+        { 3, 8, static_cast<size_t>(-1), 2, 0.1f, 5 },
+        { 3, 16, 8, 3, 0.2f, 7 },
+        { 3, 16, 16, 2, 0.1f, 7 },
+        { 3, 16, static_cast<size_t>(-1), 3, 0.2f, 7 },
+        { 3, static_cast<size_t>(-1), 8, 2, 0.1f, 7 },
+        { 3, static_cast<size_t>(-1), 16, 3, 0.2f, 7 },
+        { 3, static_cast<size_t>(-1), static_cast<size_t>(-1), 2, 0.1f, 7 },
+        { 4, 8, 8, 2, 0.1f, 5 },
+        { 4, 8, 16, 3, 0.2f, 7 },
+        { 4, 8, static_cast<size_t>(-1), 2, 0.1f, 5 },
+        { 4, 16, 8, 3, 0.2f, 7 },
+        { 4, 16, 16, 2, 0.1f, 7 },
+        { 4, 16, static_cast<size_t>(-1), 3, 0.2f, 7 },
+        { 4, static_cast<size_t>(-1), 8, 2, 0.1f, 5 },
+        { 4, static_cast<size_t>(-1), 16, 3, 0.2f, 7 },
+        { 4, static_cast<size_t>(-1), static_cast<size_t>(-1), 3, 0.1f, 10 },
+        { 5, 8, 8, 2, 0.1f, 5 },
+        { 5, 8, 16, 3, 0.2f, 7 },
+        { 5, 8, static_cast<size_t>(-1), 2, 0.1f, 5 },
+        { 5, 16, 8, 3, 0.2f, 7 },
+        { 5, 16, 16, 2, 0.1f, 7 },
+        { 5, 16, static_cast<size_t>(-1), 3, 0.2f, 7 },
+        { 5, static_cast<size_t>(-1), 8, 2, 0.1f, 5 },
+        { 5, static_cast<size_t>(-1), 16, 3, 0.2f, 7 },
+        { 5, static_cast<size_t>(-1), static_cast<size_t>(-1), 3, 0.1f, 10 },
+        { 6, 8, 8, 3, 0.1f, 5 },
+        { 6, 8, 16, 3, 0.2f, 7 },
+        { 6, 8, static_cast<size_t>(-1), 3, 0.1f, 7 },
+        { 6, 16, 8, 3, 0.2f, 7 },
+        { 6, 16, 16, 2, 0.1f, 7 },
+        { 6, 16, static_cast<size_t>(-1), 3, 0.2f, 7 },
+        { 6, static_cast<size_t>(-1), 8, 2, 0.1f, 7 },
+        { 6, static_cast<size_t>(-1), 16, 3, 0.2f, 7 },
+        { 6, static_cast<size_t>(-1), static_cast<size_t>(-1), 2, 0.1f, 10 }
+    } };
+}
@@ -0,0 +1,525 @@
+#include "../heatninja.h"
+
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <stdexcept>
+#include <fstream>
+#include <iterator>
+
+// regression test of the default household against the reference npcs of every heat & solar system
+
+int failures = 0;
+
+void check(const bool condition, const std::string& message) {
+    if (!condition) {
+        std::cout << "FAILED: " << message << '\n';
+        ++failures;
+    }
+}
+
+std::vector<float> extractNetPresentCosts(const std::string& json) {
+    // the first 21 "net-present-cost" entries are the heat & solar systems, in order
+    std::vector<float> net_present_costs;
+    const std::string key = "\"net-present-cost\":";
+    size_t position = json.find(key);
+    while (position != std::string::npos && net_present_costs.size() < 21) {
+        net_present_costs.push_back(std::stof(json.substr(position + key.size())));
+        position = json.find(key, position + key.size());
+    }
+    return net_present_costs;
+}
+
+std::vector<float> extractSensitivities(const std::string& json, const std::string_view input) {
+    // the npc derivative of every system with respect to input, in order
+    std::vector<float> derivatives;
+    const std::string key = "\"" + std::string(input) + "\":{\"net-present-cost\":";
+    size_t position = json.find(key);
+    while (position != std::string::npos) {
+        derivatives.push_back(std::stof(json.substr(position + key.size())));
+        position = json.find(key, position + key.size());
+    }
+    return derivatives;
+}
+
+std::string readFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+std::string allSpecsToCsv(const std::vector<heatninja::HeatSolarSystemSpecifications>& specs, const std::string& filename) {
+    // the conversion of tools/all_specs_to_csv.cpp
+    std::ofstream file(filename);
+    for (const auto& spec : specs) {
+        heatninja::write_optimal_specification(spec, file);
+    }
+    file.close();
+    return readFile(filename);
+}
+
+std::vector<float> runDefaultHousehold(const heatninja::SimulationOptions& simulation_options) {
+    std::stringstream discarded;
+    std::streambuf* cout_buffer = std::cout.rdbuf(discarded.rdbuf());
+    const std::string json = heatninja::run_simulation(20.0f, 52.3833f, -1.5833f, 2, 60.0f, "CV4 7AL", 3000, 0.5f, simulation_options);
+    std::cout.rdbuf(cout_buffer);
+    return extractNetPresentCosts(json);
+}
+
+heatninja::ThermalTransmittanceAndOptimisedEpcDemand fitThermalTransmittance(const bool use_table, const int region_identifier, const float latitude, const float house_size, const int epc_space_heating) {
+    const std::array<float, 12> monthly_solar_height_factors = heatninja::calculate_monthly_solar_height_factors(latitude, heatninja::monthly_solar_declinations);
+    const std::array<float, 12> monthly_epc_outside_temperatures = heatninja::calculate_monthly_epc_outside_temperatures(region_identifier);
+    const std::array<int, 12> monthly_epc_solar_irradiances = heatninja::calculate_monthly_epc_solar_irradiances(region_identifier);
+    const float solar_gain_house_factor = heatninja::calculate_solar_gain_house_factor(house_size);
+    const std::array<float, 12> monthly_solar_gains_south = heatninja::calculate_monthly_solar_gains_south(heatninja::calculate_monthly_incident_irradiance_solar_gains_south(heatninja::calculate_monthly_solar_gain_ratios_south(monthly_solar_height_factors), monthly_epc_solar_irradiances), solar_gain_house_factor);
+    const std::array<float, 12> monthly_solar_gains_north = heatninja::calculate_monthly_solar_gains_north(heatninja::calculate_monthly_incident_irradiance_solar_gains_north(heatninja::calculate_monthly_solar_gain_ratios_north(monthly_solar_height_factors), monthly_epc_solar_irradiances), solar_gain_house_factor);
+    const float epc_body_gain = heatninja::calculate_epc_body_gain(house_size);
+    const float heat_capacity = heatninja::calculate_heat_capacity(house_size);
+
+    std::stringstream discarded;
+    std::streambuf* cout_buffer = std::cout.rdbuf(discarded.rdbuf());
+    const heatninja::ThermalTransmittanceAndOptimisedEpcDemand fit = use_table
+        ? heatninja::lookup_dwellings_thermal_transmittance(region_identifier, house_size, epc_body_gain, monthly_epc_outside_temperatures, monthly_epc_solar_irradiances, monthly_solar_height_factors, heatninja::monthly_solar_declinations, monthly_solar_gains_south, monthly_solar_gains_north, heat_capacity, epc_space_heating)
+        : heatninja::calculate_dwellings_thermal_transmittance(house_size, epc_body_gain, monthly_epc_outside_temperatures, monthly_epc_solar_irradiances, monthly_solar_height_factors, heatninja::monthly_solar_declinations, monthly_solar_gains_south, monthly_solar_gains_north, heat_capacity, epc_space_heating);
+    std::cout.rdbuf(cout_buffer);
+    return fit;
+}
+
+int main()
+{
+    const std::array<float, 21> reference_net_present_costs = {
+        7435.42f, 7307.84f, 9182.45f, 9129.13f, 9372.12f, 9172.39f, 10365.84f,
+        8368.76f, 7750.80f, 10703.42f, 10745.02f, 10318.61f, 10235.71f, 11879.87f,
+        10933.07f, 9780.04f, 13329.41f, 13393.71f, 12422.16f, 12395.91f, 14509.56f
+    };
+
+    const std::vector<float> serial = runDefaultHousehold({ false, false, false, 0, false, true });
+    check(serial.size() == 21, "21 systems in the json");
+    for (size_t i = 0; i < serial.size(); ++i) {
+        check(std::abs(serial.at(i) - reference_net_present_costs.at(i)) < 0.5f, "npc of system " + std::to_string(i) + " is " + std::to_string(serial.at(i)) + ", expected " + std::to_string(reference_net_present_costs.at(i)));
+    }
+
+    // postcodes outside the regioncode table are rejected rather than read as region -1
+    check(heatninja::calculate_region_identifier("CV4 7AL") == 5, "CV4 7AL is in region 6");
+    check(heatninja::calculate_region_identifier("") == -1, "empty postcode has no region");
+    check(heatninja::calculate_region_identifier("47AL") == -1, "postcode without an area has no region");
+    check(heatninja::calculate_region_identifier("QQ1 1AA") == -1, "unknown area has no region");
+    const std::vector<std::string> postcodes = { "CV4 7AL", "", "sy15 1aa", "QQ1 1AA", "ZE1 0AA", "47AL", "EH44 1AA" };
+    const std::vector<int> region_identifiers = heatninja::calculate_region_identifiers(postcodes);
+    check(region_identifiers.size() == postcodes.size(), "one region identifier per postcode");
+    for (size_t i = 0; i < postcodes.size() && i < region_identifiers.size(); ++i) {
+        check(region_identifiers.at(i) == heatninja::calculate_region_identifier(postcodes.at(i)), "bulk region lookup of \"" + postcodes.at(i) + "\"");
+    }
+    bool unknown_postcode_rejected = false;
+    try {
+        heatninja::run_simulation(20.0f, 52.3833f, -1.5833f, 2, 60.0f, "QQ1 1AA", 3000, 0.5f, { false, false, false, 0, false, true });
+    }
+    catch (const std::invalid_argument&) {
+        unknown_postcode_rejected = true;
+    }
+    check(unknown_postcode_rejected, "run_simulation rejects an unknown postcode");
+
+    // resident quantised weather stays within its documented error bound
+    const heatninja::WeatherStore weather_store = heatninja::load_weather_store("assets");
+    const heatninja::GridCell* grid_cell = heatninja::find_grid_cell(52.3833f, -1.5833f);
+    std::vector<float> decoded;
+    heatninja::decode_weather_series(weather_store.outside_temperatures, weather_store.outside_temperature_scales.at(grid_cell->cell_index), grid_cell->cell_index, decoded);
+    const std::vector<float> outside_temperatures = heatninja::import_weather_data("outside_temps", 52.3833f, -1.5833f);
+    float max_error = 0;
+    for (size_t hour = 0; hour < 8760; ++hour) max_error = std::max(max_error, std::abs(decoded.at(hour) - outside_temperatures.at(hour)));
+    check(max_error <= 0.0004f, "quantised outside temperatures within 0.0004 C, error " + std::to_string(max_error));
+
+    heatninja::SimulationOptions resident_options = { false, false, false, 0, false, true };
+    resident_options.weather_store = &weather_store;
+    const std::vector<float> resident = runDefaultHousehold(resident_options);
+    for (size_t i = 0; i < resident.size(); ++i) {
+        check(std::abs(resident.at(i) - reference_net_present_costs.at(i)) < 0.5f, "npc of system " + std::to_string(i) + " from the weather store");
+    }
+
+    // a weather ensemble reports the mean npc of every system with its worst year, which is no cheaper
+    heatninja::WeatherStore ensemble_store = heatninja::load_weather_store("assets");
+    heatninja::add_synthetic_weather_years(ensemble_store, 2, 1);
+    check(ensemble_store.years == 3 && ensemble_store.outside_temperatures.size() == weather_store.outside_temperatures.size() * 3, "two synthetic years added to every cell");
+    heatninja::SimulationOptions ensemble_options = { false, false, false, 0, false, true };
+    ensemble_options.weather_store = &ensemble_store;
+    std::stringstream ensemble_discarded;
+    std::streambuf* ensemble_cout_buffer = std::cout.rdbuf(ensemble_discarded.rdbuf());
+    const std::string ensemble_json = heatninja::run_simulation(20.0f, 52.3833f, -1.5833f, 2, 60.0f, "CV4 7AL", 3000, 0.5f, ensemble_options);
+    std::cout.rdbuf(ensemble_cout_buffer);
+    const std::vector<float> ensemble_means = extractNetPresentCosts(ensemble_json);
+    check(ensemble_means.size() == 21, "21 systems over the weather ensemble");
+    const std::string worst_key = "\"weather-ensemble\":{\"years\":3,\"worst-net-present-cost\":";
+    size_t worst_position = ensemble_json.find(worst_key);
+    size_t ensemble_systems = 0;
+    for (; ensemble_systems < ensemble_means.size() && worst_position != std::string::npos; ++ensemble_systems) {
+        const float worst = std::stof(ensemble_json.substr(worst_position + worst_key.size()));
+        check(worst >= ensemble_means.at(ensemble_systems) - 0.01f, "worst year npc of system " + std::to_string(ensemble_systems) + " is " + std::to_string(worst) + ", no less than the mean " + std::to_string(ensemble_means.at(ensemble_systems)));
+        worst_position = ensemble_json.find(worst_key, worst_position + worst_key.size());
+    }
+    check(ensemble_systems == 21, "every system reports its worst weather year");
+
+    // repricing with no variance & the deterministic discount rate gives back each system's npc in every scenario
+    heatninja::SimulationOptions repricing_options = { false, false, false, 0, false, true };
+    repricing_options.monte_carlo = { 16, 1, 0, 0, 0, 1.035f, 1.035f };
+    std::stringstream repricing_discarded;
+    std::streambuf* repricing_cout_buffer = std::cout.rdbuf(repricing_discarded.rdbuf());
+    const std::string repricing_json = heatninja::run_simulation(20.0f, 52.3833f, -1.5833f, 2, 60.0f, "CV4 7AL", 3000, 0.5f, repricing_options);
+    std::cout.rdbuf(repricing_cout_buffer);
+    const std::string distribution_key = "\"net-present-cost-distribution\":{\"p5\":";
+    size_t distribution_position = repricing_json.find(distribution_key);
+    size_t repriced_systems = 0;
+    while (distribution_position != std::string::npos && repriced_systems < 21) {
+        const float p5 = std::stof(repricing_json.substr(distribution_position + distribution_key.size()));
+        const size_t mean_position = repricing_json.find("\"mean\":", distribution_position);
+        const float mean = std::stof(repricing_json.substr(mean_position + 7));
+        const float reference = reference_net_present_costs.at(repriced_systems);
+        check(std::abs(p5 - reference) < 0.5f && std::abs(mean - reference) < 0.5f, "repriced npc of system " + std::to_string(repriced_systems) + " is " + std::to_string(mean) + ", expected " + std::to_string(reference));
+        ++repriced_systems;
+        distribution_position = repricing_json.find(distribution_key, mean_position);
+    }
+    check(repriced_systems == 21, "every system repriced");
+
+    // over a weather ensemble each scenario is priced on a drawn year, so with no price variance the spread is the weather's & holds the mean npc
+    ensemble_options.monte_carlo = { 64, 1, 0, 0, 0, 1.035f, 1.035f };
+    std::stringstream ensemble_repricing_discarded;
+    std::streambuf* ensemble_repricing_cout_buffer = std::cout.rdbuf(ensemble_repricing_discarded.rdbuf());
+    const std::string ensemble_repricing_json = heatninja::run_simulation(20.0f, 52.3833f, -1.5833f, 2, 60.0f, "CV4 7AL", 3000, 0.5f, ensemble_options);
+    std::cout.rdbuf(ensemble_repricing_cout_buffer);
+    distribution_position = ensemble_repricing_json.find(distribution_key);
+    size_t ensemble_repriced_systems = 0;
+    bool weather_spread = false;
+    while (distribution_position != std::string::npos && ensemble_repriced_systems < ensemble_means.size()) {
+        const float p5 = std::stof(ensemble_repricing_json.substr(distribution_position + distribution_key.size()));
+        const size_t p95_position = ensemble_repricing_json.find("\"p95\":", distribution_position);
+        const float p95 = std::stof(ensemble_repricing_json.substr(p95_position + 6));
+        const float ensemble_mean = ensemble_means.at(ensemble_repriced_systems);
+        check(p5 - 0.5f <= ensemble_mean && ensemble_mean <= p95 + 0.5f, "ensemble npc of system " + std::to_string(ensemble_repriced_systems) + " is " + std::to_string(ensemble_mean) + ", outside its repriced p5 " + std::to_string(p5) + " to p95 " + std::to_string(p95));
+        weather_spread |= p95 > p5 + 0.5f;
+        ++ensemble_repriced_systems;
+        distribution_position = ensemble_repricing_json.find(distribution_key, p95_position);
+    }
+    check(ensemble_repriced_systems == 21 && weather_spread, "every system repriced over the weather ensemble, with the weather's spread");
+
+    // a frontier only keeps points no other evaluated point matches or beats on both npc & emissions, so along its cheapest first array
+    // emissions strictly fall, & the optimal spec, the cheapest evaluated, is its first point
+    heatninja::SimulationResult pareto_result;
+    heatninja::SimulationOptions pareto_options = { false, false, false, 0, false, true };
+    pareto_options.output_pareto_frontiers = true;
+    pareto_options.result = &pareto_result;
+    std::stringstream pareto_discarded;
+    std::streambuf* pareto_cout_buffer = std::cout.rdbuf(pareto_discarded.rdbuf());
+    const std::string pareto_json = heatninja::run_simulation(20.0f, 52.3833f, -1.5833f, 2, 60.0f, "CV4 7AL", 3000, 0.5f, pareto_options);
+    std::cout.rdbuf(pareto_cout_buffer);
+    const std::string frontier_key = "\"pareto-frontier\":[";
+    size_t frontier_position = pareto_json.find(frontier_key);
+    size_t frontiers = 0;
+    while (frontier_position != std::string::npos && frontiers < 21) {
+        const size_t frontier_end = pareto_json.find(']', frontier_position);
+        std::vector<std::pair<float, float>> points; // npc, emissions
+        size_t point_position = pareto_json.find("\"net-present-cost\":", frontier_position);
+        while (point_position < frontier_end) {
+            const size_t emissions_position = pareto_json.find("\"operational-emissions\":", point_position);
+            points.push_back({ std::stof(pareto_json.substr(point_position + 19)), std::stof(pareto_json.substr(emissions_position + 24)) });
+            point_position = pareto_json.find("\"net-present-cost\":", emissions_position);
+        }
+        bool non_dominated = !points.empty();
+        for (size_t p = 1; p < points.size(); ++p) {
+            non_dominated = non_dominated && points.at(p).first >= points.at(p - 1).first && points.at(p).second < points.at(p - 1).second;
+        }
+        check(non_dominated, "frontier of system " + std::to_string(frontiers) + " has no dominated point");
+        const heatninja::HeatSolarSystemSpecifications& optimal = pareto_result.systems.at(frontiers);
+        check(!points.empty() && std::abs(points.front().first - optimal.net_present_cost) <= 1e-5f * optimal.net_present_cost && std::abs(points.front().second - optimal.operation_emissions) <= 1e-5f * std::abs(optimal.operation_emissions),
+            "optimal spec of system " + std::to_string(frontiers) + " lies on its frontier");
+        ++frontiers;
+        frontier_position = pareto_json.find(frontier_key, frontier_end);
+    }
+    check(frontiers == 21, "every system has a frontier");
+
+    // a candidate joins unless matched or beaten on every objective, & evicts the points it beats
+    std::vector<heatninja::HeatSolarSystemSpecifications> frontier;
+    const auto candidate = [](const float capital_expenditure, const float net_present_cost, const float operation_emissions) {
+        heatninja::HeatSolarSystemSpecifications spec = {};
+        spec.capital_expenditure = capital_expenditure;
+        spec.net_present_cost = net_present_cost;
+        spec.operation_emissions = operation_emissions;
+        return spec;
+    };
+    heatninja::update_pareto_frontier(frontier, candidate(1000, 100, 50), false);
+    heatninja::update_pareto_frontier(frontier, candidate(1000, 120, 40), false);
+    heatninja::update_pareto_frontier(frontier, candidate(1000, 130, 45), false);
+    heatninja::update_pareto_frontier(frontier, candidate(1000, 100, 50), false);
+    heatninja::update_pareto_frontier(frontier, candidate(1000, 90, 45), false);
+    check(frontier.size() == 2 && frontier.at(0).net_present_cost == 120 && frontier.at(1).net_present_cost == 90, "frontier keeps the non-dominated candidates");
+    heatninja::update_pareto_frontier(frontier, candidate(500, 95, 46), true);
+    check(frontier.size() == 3, "a cheaper capex joins against capex");
+
+    // a time bounded run keeps every system's smallest spec as an incumbent and can't beat the full search
+    heatninja::SimulationOptions bounded_options = { false, false, false, 0, false, true };
+    bounded_options.time_budget = 1e-6f;
+    bounded_options.monte_carlo.scenarios = 100;
+    std::stringstream bounded_discarded;
+    std::streambuf* bounded_cout_buffer = std::cout.rdbuf(bounded_discarded.rdbuf());
+    const std::string bounded_json = heatninja::run_simulation(20.0f, 52.3833f, -1.5833f, 2, 60.0f, "CV4 7AL", 3000, 0.5f, bounded_options);
+    std::cout.rdbuf(bounded_cout_buffer);
+    const std::vector<float> bounded = extractNetPresentCosts(bounded_json);
+    check(bounded.size() == 21, "21 systems in the time bounded json");
+    for (size_t i = 0; i < bounded.size(); ++i) {
+        check(bounded.at(i) > reference_net_present_costs.at(i) - 0.5f, "time bounded npc of system " + std::to_string(i) + " no better than the full search");
+    }
+    const size_t search_complete_position = bounded_json.rfind("},\"search-complete-systems\":");
+    check(bounded_json.find("\"search-complete\":false") != std::string::npos && search_complete_position != std::string::npos && bounded_json.find('}', search_complete_position + 1) == bounded_json.size() - 1, "cut short searches are flagged, the count as the last top level key");
+    check(bounded_json.find("\"net-present-cost-distribution\"") == std::string::npos, "no repricing after the deadline");
+
+    bounded_options.time_budget = 1000.0f;
+    bounded_options.monte_carlo.scenarios = 0;
+    const std::vector<float> unhurried = runDefaultHousehold(bounded_options);
+    check(unhurried == serial, "a generous time budget matches the unbounded run");
+
+    // representative day ranking stops at the deadline too, leaving the seeds
+    heatninja::SimulationOptions bounded_representative_options = { false, false, false, 0, false, false };
+    bounded_representative_options.representative_days = 12;
+    bounded_representative_options.time_budget = 1e-6f;
+    std::stringstream bounded_representative_discarded;
+    std::streambuf* bounded_representative_cout_buffer = std::cout.rdbuf(bounded_representative_discarded.rdbuf());
+    const std::string bounded_representative_json = heatninja::run_simulation(20.0f, 52.3833f, -1.5833f, 2, 60.0f, "CV4 7AL", 3000, 0.5f, bounded_representative_options);
+    std::cout.rdbuf(bounded_representative_cout_buffer);
+    check(extractNetPresentCosts(bounded_representative_json).size() == 21 && bounded_representative_json.find("\"search-complete\":false") != std::string::npos, "time bounded representative day search is cut short");
+
+    // streamed parts arrive in order demand, systems, fixed cost systems, and are the parts of the returned json
+    std::vector<std::string> streamed;
+    heatninja::ResultStream result_stream;
+    result_stream.on_demand = [&](std::string_view demand_json) { streamed.push_back("demand:" + std::string(demand_json)); };
+    result_stream.on_system = [&](const heatninja::HeatSolarSystemSpecifications& spec, std::string_view system_json) {
+        streamed.push_back(std::string(heatninja::solar_options_json.at(static_cast<int>(spec.solar_option))) + ":" + std::string(system_json));
+    };
+    result_stream.on_fixed_cost_systems = [&](std::string_view fixed_cost_systems_json) { streamed.push_back("fixed:" + std::string(fixed_cost_systems_json)); };
+    heatninja::SimulationOptions streaming_options = { false, false, false, 0, false, true };
+    streaming_options.result_stream = &result_stream;
+    std::stringstream discarded;
+    std::streambuf* cout_buffer = std::cout.rdbuf(discarded.rdbuf());
+    const std::string streamed_json = heatninja::run_simulation(20.0f, 52.3833f, -1.5833f, 2, 60.0f, "CV4 7AL", 3000, 0.5f, streaming_options);
+    std::cout.rdbuf(cout_buffer);
+    check(streamed.size() == 23, "demand, 21 systems & the fixed cost systems streamed");
+    if (streamed.size() == 23) {
+        check(streamed.front().starts_with("demand:") && streamed_json.starts_with("{\"demand\":" + streamed.front().substr(7) + ","), "streamed demand is the json's demand");
+        for (size_t i = 1; i < 22; ++i) {
+            const size_t colon = streamed.at(i).find(':');
+            const std::string part = "\"" + streamed.at(i).substr(0, colon) + "\":" + streamed.at(i).substr(colon + 1);
+            check(streamed_json.find(part) != std::string::npos, "streamed system " + std::to_string(i - 1) + " is in the json");
+        }
+        check(streamed.back().starts_with("fixed:{") && streamed_json.ends_with(streamed.back().substr(7) + "}"), "streamed fixed cost systems end the json");
+    }
+
+    // the binary result round trips to the returned json, & a run without json fills the same result
+    heatninja::SimulationResult simulation_result;
+    heatninja::SimulationOptions binary_options = { false, false, false, 0, false, true };
+    binary_options.result = &simulation_result;
+    std::stringstream binary_discarded;
+    std::streambuf* binary_cout_buffer = std::cout.rdbuf(binary_discarded.rdbuf());
+    const std::string binary_json = heatninja::run_simulation(20.0f, 52.3833f, -1.5833f, 2, 60.0f, "CV4 7AL", 3000, 0.5f, binary_options);
+    heatninja::SimulationResult json_less_result;
+    binary_options.result = &json_less_result;
+    binary_options.output_json = false;
+    const std::string json_less = heatninja::run_simulation(20.0f, 52.3833f, -1.5833f, 2, 60.0f, "CV4 7AL", 3000, 0.5f, binary_options);
+    std::cout.rdbuf(binary_cout_buffer);
+    const std::vector<char> bytes = heatninja::encode_binary_result(simulation_result);
+    check(bytes.size() == 764, "binary result is 764 bytes, got " + std::to_string(bytes.size()));
+    check(heatninja::simulation_result_to_json(heatninja::decode_binary_result(bytes.data(), bytes.size())) == binary_json, "decoded binary result formats to the returned json");
+    check(json_less.empty() && heatninja::encode_binary_result(json_less_result) == bytes, "a run without json returns nothing & fills the same result");
+    bool truncated_threw = false;
+    try {
+        heatninja::decode_binary_result(bytes.data(), bytes.size() - 1);
+    }
+    catch (const std::runtime_error&) {
+        truncated_threw = true;
+    }
+    check(truncated_threw, "truncated binary result throws");
+
+    // the segmented scan demand only differs from the serial chain by float rounding, & so do the systems built on it
+    heatninja::SimulationResult scan_result;
+    heatninja::SimulationOptions scan_options = { false, false, false, 0, true, true };
+    scan_options.demand_engine = heatninja::DemandEngine::Scan;
+    scan_options.result = &scan_result;
+    const std::vector<float> scan = runDefaultHousehold(scan_options);
+    for (const auto& [scanned, chained] : { std::pair(scan_result.demand.erh, simulation_result.demand.erh), std::pair(scan_result.demand.hp, simulation_result.demand.hp) }) {
+        check(std::abs(scanned.total - chained.total) < 1e-4f * chained.total && std::abs(scanned.space - chained.space) < 1e-4f * chained.total && std::abs(scanned.max_hourly - chained.max_hourly) < 1e-4f * chained.max_hourly,
+            "scan demand " + std::to_string(scanned.total) + " kWh matches the serial " + std::to_string(chained.total) + " kWh");
+    }
+    check(scan.size() == 21, "21 systems with the scan demand");
+    for (size_t i = 0; i < scan.size(); ++i) {
+        check(std::abs(scan.at(i) - reference_net_present_costs.at(i)) < 0.5f, "npc of system " + std::to_string(i) + " with the scan demand is " + std::to_string(scan.at(i)));
+    }
+
+    // the dual run reproduces each system's npc derivatives: the price scales the heat option's capex, a larger house at the same
+    // thermal transmittance costs more, & the thermostat's derivative matches central differences of full runs (only the envelope moves)
+    heatninja::SimulationOptions sensitivity_options = { false, false, false, 0, false, true };
+    sensitivity_options.output_sensitivities = true;
+    heatninja::SimulationResult lower_result, upper_result;
+    heatninja::SimulationOptions difference_options = { false, false, false, 0, false, true };
+    difference_options.output_json = false;
+    const float thermostat_step = 0.25f;
+    std::stringstream sensitivity_discarded;
+    std::streambuf* sensitivity_cout_buffer = std::cout.rdbuf(sensitivity_discarded.rdbuf());
+    const std::string sensitivity_json = heatninja::run_simulation(20.0f, 52.3833f, -1.5833f, 2, 60.0f, "CV4 7AL", 3000, 0.5f, sensitivity_options);
+    difference_options.result = &lower_result;
+    heatninja::run_simulation(20.0f - thermostat_step, 52.3833f, -1.5833f, 2, 60.0f, "CV4 7AL", 3000, 0.5f, difference_options);
+    difference_options.result = &upper_result;
+    heatninja::run_simulation(20.0f + thermostat_step, 52.3833f, -1.5833f, 2, 60.0f, "CV4 7AL", 3000, 0.5f, difference_options);
+    std::cout.rdbuf(sensitivity_cout_buffer);
+    const std::vector<float> price_derivatives = extractSensitivities(sensitivity_json, "heat-pump-price");
+    const std::vector<float> house_size_derivatives = extractSensitivities(sensitivity_json, "house-size");
+    const std::vector<float> thermostat_derivatives = extractSensitivities(sensitivity_json, "thermostat-temperature");
+    check(price_derivatives.size() == 21 && house_size_derivatives.size() == 21 && thermostat_derivatives.size() == 21, "21 systems with sensitivities");
+    for (size_t i = 0; i < thermostat_derivatives.size() && i < 21; ++i) {
+        const heatninja::HeatSolarSystemSpecifications& spec = simulation_result.systems.at(i);
+        check(price_derivatives.at(i) > 0 && price_derivatives.at(i) <= spec.capital_expenditure && (spec.heat_option != heatninja::HeatOption::ERH || std::abs(price_derivatives.at(i) - 1100) < 0.01f), "heat pump price derivative of system " + std::to_string(i) + " is " + std::to_string(price_derivatives.at(i)));
+        check(house_size_derivatives.at(i) > 0, "house size derivative of system " + std::to_string(i) + " is " + std::to_string(house_size_derivatives.at(i)));
+        const float difference = (upper_result.systems.at(i).net_present_cost - lower_result.systems.at(i).net_present_cost) / (2 * thermostat_step);
+        check(std::abs(thermostat_derivatives.at(i) - difference) < 0.05f * difference, "thermostat derivative of system " + std::to_string(i) + " is " + std::to_string(thermostat_derivatives.at(i)) + ", central difference " + std::to_string(difference));
+    }
+
+    // planning the tes charging a day at a time finds systems at least as cheap as charging in the tariffs' cheap hours
+    heatninja::SimulationOptions dispatch_options = { false, false, false, 0, true, true };
+    dispatch_options.tes_dispatch = heatninja::TesDispatch::Optimal;
+    const std::vector<float> optimal_dispatch = runDefaultHousehold(dispatch_options);
+    check(optimal_dispatch.size() == 21, "21 systems with optimal tes dispatch");
+    for (size_t i = 0; i < optimal_dispatch.size(); ++i) {
+        check(optimal_dispatch.at(i) <= reference_net_present_costs.at(i) + 0.5f, "npc of system " + std::to_string(i) + " with optimal tes dispatch is " + std::to_string(optimal_dispatch.at(i)) + ", no more than " + std::to_string(reference_net_present_costs.at(i)));
+    }
+
+    // half hourly operation on held hourly weather & prices stays close to the hourly run, & holding then averaging is lossless
+    const std::vector<float> held = heatninja::resample_series(outside_temperatures, 2);
+    check(held.size() == 17520 && heatninja::resample_series(held, 1) == outside_temperatures, "hourly series held over half hours averages back to itself");
+    heatninja::SimulationOptions half_hourly_options = { false, false, false, 0, true, true };
+    half_hourly_options.steps_per_hour = 2;
+    const std::vector<float> half_hourly = runDefaultHousehold(half_hourly_options);
+    check(half_hourly.size() == 21, "21 systems with half hourly steps");
+    for (size_t i = 0; i < half_hourly.size(); ++i) {
+        check(std::abs(half_hourly.at(i) - reference_net_present_costs.at(i)) < 0.01f * reference_net_present_costs.at(i), "half hourly npc of system " + std::to_string(i) + " is " + std::to_string(half_hourly.at(i)) + ", within 1% of " + std::to_string(reference_net_present_costs.at(i)));
+    }
+
+    // representative days cover the year with their weights, and ranking on them keeps brute force's optimum among the finalists
+    const std::vector<float> solar_irradiances = heatninja::import_weather_data("solar_irradiances", 52.3833f, -1.5833f);
+    const std::vector<heatninja::RepresentativeDay> representative_days = heatninja::select_representative_days(outside_temperatures, solar_irradiances, 12);
+    float representative_weight = 0;
+    for (const heatninja::RepresentativeDay& representative_day : representative_days) representative_weight += representative_day.weight;
+    check(!representative_days.empty() && representative_days.size() <= 12 && std::abs(representative_weight - 365) < 0.01f, "12 representative days weighted over the year, " + std::to_string(representative_days.size()) + " days weigh " + std::to_string(representative_weight));
+    const std::vector<float> brute_force = runDefaultHousehold({ false, false, false, 0, false, false });
+    heatninja::SimulationOptions representative_options = { false, false, false, 0, false, false };
+    representative_options.representative_days = 12;
+    representative_options.representative_day_finalists = 30;
+    const std::vector<float> finalists = runDefaultHousehold(representative_options);
+    check(brute_force.size() == 21 && finalists.size() == 21, "21 systems brute force & from representative day finalists");
+    for (size_t i = 0; i < finalists.size() && i < brute_force.size(); ++i) {
+        check(std::abs(finalists.at(i) - brute_force.at(i)) < 0.01f, "finalists' npc of system " + std::to_string(i) + " is " + std::to_string(finalists.at(i)) + ", brute force " + std::to_string(brute_force.at(i)));
+    }
+
+    // extending the surrogate's cholesky factor point by point gives the same process as factoring all the points at once
+    std::vector<heatninja::SurrogatePoint> surrogate_points;
+    std::vector<double> extended_cholesky, extended_weights, fresh_cholesky, fresh_weights, kernel_column;
+    heatninja::Surrogate extended_surrogate = {};
+    for (size_t k = 0; k < 12; ++k) {
+        const float x = static_cast<float>(k % 4) * 2.0f, y = static_cast<float>(k / 4) * 3.0f;
+        surrogate_points.push_back({ x, y, 9000.0f + 40.0f * (x - 3.0f) * (x - 3.0f) + 25.0f * y });
+        extended_surrogate = heatninja::fit_surrogate(surrogate_points, 2.0f, 3.0f, extended_cholesky, extended_weights);
+    }
+    const heatninja::Surrogate fresh_surrogate = heatninja::fit_surrogate(surrogate_points, 2.0f, 3.0f, fresh_cholesky, fresh_weights);
+    const heatninja::SurrogatePrediction extended_prediction = heatninja::predict_surrogate(extended_surrogate, surrogate_points, extended_cholesky, extended_weights, 3.0f, 4.0f, kernel_column);
+    const heatninja::SurrogatePrediction fresh_prediction = heatninja::predict_surrogate(fresh_surrogate, surrogate_points, fresh_cholesky, fresh_weights, 3.0f, 4.0f, kernel_column);
+    check(extended_cholesky == fresh_cholesky && extended_weights == fresh_weights && extended_prediction.mean == fresh_prediction.mean && extended_prediction.deviation == fresh_prediction.deviation, "extended surrogate matches the one fitted at once");
+
+    // the gaussian process search stops at its default expected improvement of 1, so allow it 0.1% above brute force's optimum
+    heatninja::SimulationOptions surrogate_options = { false, false, false, 0, false, false };
+    surrogate_options.use_surrogate_search = true;
+    const std::vector<float> surrogate = runDefaultHousehold(surrogate_options);
+    check(surrogate.size() == 21, "21 systems from the surrogate search");
+    for (size_t i = 0; i < surrogate.size() && i < brute_force.size(); ++i) {
+        check(surrogate.at(i) >= brute_force.at(i) - 0.01f && surrogate.at(i) <= brute_force.at(i) * 1.001f, "surrogate npc of system " + std::to_string(i) + " is " + std::to_string(surrogate.at(i)) + ", brute force " + std::to_string(brute_force.at(i)));
+    }
+
+    // screening many households sharing the weather in simd lanes gives each exactly its own serial demand, 19 fill one block & part of another
+    std::vector<heatninja::HouseholdDemandInputs> screened_households;
+    for (size_t h = 0; h < 19; ++h) {
+        screened_households.push_back({ 18.0f + 0.25f * static_cast<float>(h % 17), 1 + static_cast<int>(h % 5), 40.0f + 9.0f * static_cast<float>(h), 1.0f + 0.11f * static_cast<float>(h) });
+    }
+    const std::vector<heatninja::HouseholdDemand> screened = heatninja::screen_household_demands(screened_households, 52.3833f, outside_temperatures, solar_irradiances);
+    check(screened.size() == screened_households.size(), "a demand per screened household");
+    const std::array<float, 12> screening_solar_height_factors = heatninja::calculate_monthly_solar_height_factors(52.3833f, heatninja::monthly_solar_declinations);
+    std::stringstream screening_discarded;
+    std::streambuf* screening_cout_buffer = std::cout.rdbuf(screening_discarded.rdbuf());
+    for (size_t h = 0; h < screened.size(); ++h) {
+        const heatninja::HouseholdDemandInputs& household = screened_households.at(h);
+        const auto serial_demand = [&](const std::array<float, 24>& hourly_temperatures_over_day) {
+            return heatninja::calculate_yearly_space_and_hot_water_demand(hourly_temperatures_over_day, household.thermostat_temperature, heatninja::dhw_monthly_factors, heatninja::calculate_monthly_cold_water_temperatures(52.3833f), heatninja::calculate_monthly_solar_gain_ratios_north(screening_solar_height_factors), heatninja::calculate_monthly_solar_gain_ratios_south(screening_solar_height_factors), heatninja::hot_water_hourly_ratios, outside_temperatures, solar_irradiances, heatninja::calculate_average_daily_hot_water_volume(household.num_occupants), heatninja::hot_water_temperature, heatninja::calculate_solar_gain_house_factor(household.house_size), household.house_size, household.dwelling_thermal_transmittance, heatninja::calculate_heat_capacity(household.house_size), heatninja::calculate_body_heat_gain(household.num_occupants));
+        };
+        const heatninja::Demand erh = serial_demand(heatninja::calculate_erh_hourly_temperature_profile(household.thermostat_temperature));
+        const heatninja::Demand hp = serial_demand(heatninja::calculate_hp_hourly_temperature_profile(household.thermostat_temperature));
+        for (const auto& [lane, chain] : { std::pair(screened.at(h).erh, erh), std::pair(screened.at(h).hp, hp) }) {
+            check(lane.total == chain.total && lane.max_hourly == chain.max_hourly && lane.space == chain.space && lane.hot_water == chain.hot_water, "screened demand of household " + std::to_string(h) + " is " + std::to_string(lane.total) + " kWh, serial " + std::to_string(chain.total) + " kWh");
+        }
+    }
+    std::cout.rdbuf(screening_cout_buffer);
+
+#ifndef EM_COMPATIBLE
+    const std::vector<float> parallel = runDefaultHousehold({ false, false, false, 0, true, true });
+    check(parallel == serial, "multithreaded run matches the serial run");
+#endif
+
+#ifndef EM_COMPATIBLE
+    // the all specs capture merges its per combination buffers in the order the serial run evaluated them, which the csv path wrote line by line
+    runDefaultHousehold({ false, true, true, 90, false, true });
+    runDefaultHousehold({ false, false, true, 91, true, true });
+    const std::vector<heatninja::HeatSolarSystemSpecifications> serial_specs = heatninja::read_all_specs_binary("debug_data/all_specs_90.bin");
+    const std::vector<heatninja::HeatSolarSystemSpecifications> parallel_specs = heatninja::read_all_specs_binary("debug_data/all_specs_91.bin");
+    const std::string serial_specs_csv = allSpecsToCsv(serial_specs, "debug_data/all_specs_90.csv");
+    check(!serial_specs.empty() && serial_specs.size() % 5 == 0, "every evaluated spec captured with all 5 tariffs, " + std::to_string(serial_specs.size()) + " specs");
+    check(allSpecsToCsv(parallel_specs, "debug_data/all_specs_91.csv") == serial_specs_csv, "multithreaded all specs csv matches the serial one");
+    std::array<std::vector<heatninja::HeatSolarSystemSpecifications>, 21> all_specs_buffers;
+    bool combinations_in_order = true;
+    for (size_t i = 0; i < serial_specs.size(); ++i) {
+        const size_t combination_index = static_cast<size_t>(serial_specs.at(i).heat_option) * 7 + static_cast<size_t>(serial_specs.at(i).solar_option);
+        combinations_in_order &= combination_index < 21 && (i == 0 || combination_index >= static_cast<size_t>(serial_specs.at(i - 1).heat_option) * 7 + static_cast<size_t>(serial_specs.at(i - 1).solar_option));
+        if (combination_index < 21) all_specs_buffers.at(combination_index).push_back(serial_specs.at(i));
+    }
+    check(combinations_in_order, "all specs are grouped by heat & solar combination in order");
+    heatninja::SimulationOptions seeded_options = { false, false, true, 93, true, true };
+    seeded_options.time_budget = 1000.0f;
+    runDefaultHousehold(seeded_options);
+    check(heatninja::read_all_specs_binary("debug_data/all_specs_93.bin").size() == serial_specs.size(), "the time bounded run's seeds aren't evaluated again");
+    heatninja::write_all_specs_binary(all_specs_buffers, "debug_data/all_specs_92.bin");
+    check(readFile("debug_data/all_specs_92.bin") == readFile("debug_data/all_specs_90.bin"), "decoded all specs encode to the same bytes");
+    std::istringstream optimal_specs_csv(readFile("debug_data/optimal_specs_90.csv"));
+    size_t optimal_spec_lines = 0;
+    for (std::string line; std::getline(optimal_specs_csv, line); ++optimal_spec_lines) {
+        check(serial_specs_csv.find(line + '\n') != std::string::npos, "optimal spec " + line + " is among the all specs csv");
+    }
+    check(optimal_spec_lines == 21, "21 optimal specs written");
+#endif
+
+    // the precomputed table only picks where the exact scan starts, so the fit is unchanged, also off the table's latitude & grid
+    for (const int region_identifier : { 0, 9, 20 }) {
+        for (const float latitude : { 50.1f, 52.3833f, 58.6f }) {
+            for (const float house_size : { 37.0f, 60.0f, 255.0f, 340.0f }) {
+                for (const int epc_space_heating : { 0, 3000, 17250, 45000 }) {
+                    const heatninja::ThermalTransmittanceAndOptimisedEpcDemand scanned = fitThermalTransmittance(false, region_identifier, latitude, house_size, epc_space_heating);
+                    const heatninja::ThermalTransmittanceAndOptimisedEpcDemand looked_up = fitThermalTransmittance(true, region_identifier, latitude, house_size, epc_space_heating);
+                    check(scanned.thermal_transmittance == looked_up.thermal_transmittance && scanned.optimised_epc_demand == looked_up.optimised_epc_demand,
+                        "table fit of region " + std::to_string(region_identifier) + ", " + std::to_string(house_size) + " m2, epc " + std::to_string(epc_space_heating) + " matches the scan");
+                }
+            }
+        }
+    }
+
+    check(heatninja::find_grid_cell(52.3833f, -1.5833f) != nullptr, "default household has weather data");
+    check(heatninja::find_grid_cell(40.0f, -1.5833f) == nullptr, "no weather data outside the UK");
+    bool threw = false;
+    try {
+        heatninja::calculate_coldest_outside_temperature_of_year(40.0f, -1.5833f);
+    }
+    catch (const std::out_of_range&) {
+        threw = true;
+    }
+    check(threw, "coldest temperature outside the UK throws");
+
+    if (failures == 0) std::cout << "simulation_test passed\n";
+    return failures == 0 ? 0 : 1;
+}
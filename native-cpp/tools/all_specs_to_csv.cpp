@@ -0,0 +1,21 @@
+#include "../heatninja.h"
+
+#include <iostream>
+#include <fstream>
+
+// converts debug_data/all_specs_<index>.bin written with SimulationOptions::output_all_specs into the csv format of write_optimal_specification
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        std::cout << "usage: all_specs_to_csv <all_specs.bin> <all_specs.csv>\n";
+        return 1;
+    }
+
+    const std::vector<heatninja::HeatSolarSystemSpecifications> specs = heatninja::read_all_specs_binary(argv[1]);
+    std::ofstream file(argv[2]);
+    for (const auto& spec : specs) {
+        heatninja::write_optimal_specification(spec, file);
+    }
+    file.close();
+    std::cout << specs.size() << " specifications written to " << argv[2] << '\n';
+}
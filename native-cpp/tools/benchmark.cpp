@@ -0,0 +1,230 @@
+#include "../heatninja.h"
+
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+
+#if defined(__linux__) && !defined(EM_COMPATIBLE)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define HEATNINJA_PERF_COUNTERS
+#endif
+
+// cycles, instructions, branches, branch misses & last level cache misses
+constexpr size_t counter_count = 5;
+const std::array<const char*, counter_count> counter_names = { "cycles", "instructions", "branches", "branch-misses", "cache-misses" };
+
+// hardware counters of the calling thread, each event is missing (-1) when the pmu doesn't offer it
+class PerfCounterGroup {
+    std::array<int, counter_count> fds;
+public:
+    PerfCounterGroup() { fds.fill(-1); }
+    PerfCounterGroup(const PerfCounterGroup&) = delete;
+    PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+    ~PerfCounterGroup() { close(); }
+
+    // returns errno of the group leader, 0 when at least cycles are counted
+    int open() {
+#ifdef HEATNINJA_PERF_COUNTERS
+        constexpr std::array<uint64_t, counter_count> configs = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES };
+        for (size_t c = 0; c < counter_count; ++c) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs.at(c);
+            attr.disabled = c == 0;
+            // user space only, so perf_event_paranoid up to 2 allows it
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds.at(c) = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, fds.at(0), 0));
+            if (c == 0 && fds.at(0) < 0) return errno;
+        }
+        ioctl(fds.at(0), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fds.at(0), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        return 0;
+#else
+        return ENOSYS;
+#endif
+    }
+
+    // stops the group, counts are scaled up when the kernel multiplexed them
+    std::array<int64_t, counter_count> stop() {
+        std::array<int64_t, counter_count> counts;
+        counts.fill(-1);
+#ifdef HEATNINJA_PERF_COUNTERS
+        if (fds.at(0) < 0) return counts;
+        ioctl(fds.at(0), PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        for (size_t c = 0; c < counter_count; ++c) {
+            std::array<uint64_t, 3> value_enabled_running;
+            if (fds.at(c) < 0 || read(fds.at(c), value_enabled_running.data(), sizeof(value_enabled_running)) != sizeof(value_enabled_running) || value_enabled_running.at(2) == 0) continue;
+            counts.at(c) = static_cast<int64_t>(static_cast<double>(value_enabled_running.at(0)) * value_enabled_running.at(1) / value_enabled_running.at(2));
+        }
+#endif
+        return counts;
+    }
+
+    void close() {
+#ifdef HEATNINJA_PERF_COUNTERS
+        for (int& fd : fds) {
+            if (fd >= 0) ::close(fd);
+            fd = -1;
+        }
+#endif
+    }
+};
+
+struct StageTotals {
+    size_t runs = 0;
+    double milliseconds = 0;
+    std::array<int64_t, counter_count> counts = {}; // -1 once any run of the stage missed the event
+};
+
+// counts every stage on the thread running it, a stage's group is only open between its start & end
+class StageCounters {
+    std::mutex totals_mutex;
+    std::map<std::string, StageTotals> totals;
+    bool use_counters;
+
+    struct OpenStage {
+        std::string stage;
+        std::chrono::steady_clock::time_point start_time;
+        PerfCounterGroup group;
+    };
+    static thread_local std::vector<std::unique_ptr<OpenStage>> open_stages;
+
+public:
+    int counters_errno = 0;
+
+    explicit StageCounters(const bool use_counters)
+        :use_counters(use_counters)
+    {
+        if (use_counters) {
+            PerfCounterGroup probe;
+            counters_errno = probe.open();
+            this->use_counters = counters_errno == 0;
+        }
+    }
+
+    heatninja::StageHooks hooks() {
+        heatninja::StageHooks stage_hooks;
+        stage_hooks.on_stage_start = [this](std::string_view stage) {
+            open_stages.push_back(std::make_unique<OpenStage>());
+            OpenStage& open_stage = *open_stages.back();
+            open_stage.stage = stage;
+            if (use_counters) open_stage.group.open();
+            open_stage.start_time = std::chrono::steady_clock::now();
+        };
+        stage_hooks.on_stage_end = [this](std::string_view stage) {
+            const auto end_time = std::chrono::steady_clock::now();
+            std::unique_ptr<OpenStage> open_stage = std::move(open_stages.back());
+            open_stages.pop_back();
+            const std::array<int64_t, counter_count> counts = open_stage->group.stop();
+
+            std::lock_guard<std::mutex> lock(totals_mutex);
+            StageTotals& stage_totals = totals[std::string(stage)];
+            ++stage_totals.runs;
+            stage_totals.milliseconds += std::chrono::duration<double, std::milli>(end_time - open_stage->start_time).count();
+            for (size_t c = 0; c < counter_count; ++c) {
+                stage_totals.counts.at(c) = counts.at(c) < 0 || stage_totals.counts.at(c) < 0 ? -1 : stage_totals.counts.at(c) + counts.at(c);
+            }
+        };
+        return stage_hooks;
+    }
+
+    void print(const int iterations) const {
+        // the fit & demand come first, then each combination and the sum over all of them
+        StageTotals combinations;
+        for (const auto& [stage, stage_totals] : totals) {
+            if (stage == "epc-fit" || stage == "demand") continue;
+            combinations.runs += stage_totals.runs;
+            combinations.milliseconds += stage_totals.milliseconds;
+            for (size_t c = 0; c < counter_count; ++c) {
+                combinations.counts.at(c) = stage_totals.counts.at(c) < 0 || combinations.counts.at(c) < 0 ? -1 : combinations.counts.at(c) + stage_totals.counts.at(c);
+            }
+        }
+
+        std::cout << "stage, mean ms";
+        if (use_counters) {
+            for (const char* counter_name : counter_names) std::cout << ", " << counter_name;
+            std::cout << ", ipc, branch miss %, cache misses per 1k instructions";
+        }
+        std::cout << '\n';
+        const auto print_stage = [&](const std::string& stage, const StageTotals& stage_totals) {
+            std::cout << stage << ", " << stage_totals.milliseconds / iterations;
+            if (use_counters) {
+                const auto& counts = stage_totals.counts;
+                for (const int64_t count : counts) {
+                    if (count < 0) std::cout << ", n/a";
+                    else std::cout << ", " << count / iterations;
+                }
+                const auto ratio = [](const int64_t numerator, const int64_t denominator, const double scale) {
+                    return numerator < 0 || denominator <= 0 ? std::string("n/a") : std::to_string(scale * numerator / denominator);
+                };
+                std::cout << ", " << ratio(counts.at(1), counts.at(0), 1) << ", " << ratio(counts.at(3), counts.at(2), 100) << ", " << ratio(counts.at(4), counts.at(1), 1000);
+            }
+            std::cout << '\n';
+        };
+        for (const std::string stage : { "epc-fit", "demand" }) {
+            if (totals.contains(stage)) print_stage(stage, totals.at(stage));
+        }
+        for (const auto& [stage, stage_totals] : totals) {
+            if (stage != "epc-fit" && stage != "demand") print_stage(stage, stage_totals);
+        }
+        if (combinations.runs > 0) print_stage("all combinations", combinations);
+    }
+};
+
+thread_local std::vector<std::unique_ptr<StageCounters::OpenStage>> StageCounters::open_stages;
+
+// times run_simulation for the default household, usage: heatninja_benchmark [iterations] [--counters]
+// --counters adds per stage wall time & linux hardware counters, without counter access only the wall times are reported
+int main(int argc, char* argv[])
+{
+    int iterations = 5;
+    bool report_stages = false;
+    for (int a = 1; a < argc; ++a) {
+        if (std::string(argv[a]) == "--counters") report_stages = true;
+        else iterations = std::max(std::stoi(argv[a]), 1);
+    }
+#ifndef EM_COMPATIBLE
+    const bool use_multithreading = true;
+#else
+    const bool use_multithreading = false;
+#endif
+    heatninja::SimulationOptions simulation_options = { false, false, false, 0, use_multithreading, true };
+
+    StageCounters stage_counters(report_stages);
+    const heatninja::StageHooks stage_hooks = stage_counters.hooks();
+    if (report_stages) {
+        simulation_options.stage_hooks = &stage_hooks;
+        if (stage_counters.counters_errno != 0) {
+            std::cout << "hardware counters unavailable (" << std::strerror(stage_counters.counters_errno) << "), check /proc/sys/kernel/perf_event_paranoid, reporting wall time only\n";
+        }
+    }
+
+    double min_runtime = 0, runtime_sum = 0;
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        std::stringstream discarded;
+        std::streambuf* cout_buffer = std::cout.rdbuf(discarded.rdbuf());
+        const auto start_time = std::chrono::steady_clock::now();
+        heatninja::run_simulation(20.0f, 52.3833f, -1.5833f, 2, 60.0f, "CV4 7AL", 3000, 0.5f, simulation_options);
+        const double runtime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+        std::cout.rdbuf(cout_buffer);
+
+        if (iteration == 0 || runtime < min_runtime) min_runtime = runtime;
+        runtime_sum += runtime;
+    }
+    std::cout << "multithreading: " << use_multithreading << ", iterations: " << iterations << ", min: " << min_runtime << " ms, mean: " << runtime_sum / iterations << " ms\n";
+    if (report_stages) stage_counters.print(iterations);
+}
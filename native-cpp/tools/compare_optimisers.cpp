@@ -0,0 +1,92 @@
+#include "../heatninja.h"
+
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cmath>
+
+// optimiser harness, runs a set of households with each optimiser and reports the npc error against brute force & the runtime
+
+struct Household {
+    float thermostat_temperature, latitude, longitude;
+    int num_occupants;
+    float house_size;
+    std::string postcode;
+    int epc_space_heating;
+    float tes_volume_max;
+};
+
+struct OptimiserMode {
+    std::string name;
+    heatninja::SimulationOptions simulation_options;
+};
+
+std::vector<float> extractNetPresentCosts(const std::string& json) {
+    // the first 21 "net-present-cost" entries are the heat & solar systems, in order
+    std::vector<float> net_present_costs;
+    const std::string key = "\"net-present-cost\":";
+    size_t position = json.find(key);
+    while (position != std::string::npos && net_present_costs.size() < 21) {
+        net_present_costs.push_back(std::stof(json.substr(position + key.size())));
+        position = json.find(key, position + key.size());
+    }
+    return net_present_costs;
+}
+
+int main()
+{
+    const std::vector<Household> households = {
+        { 20.0f, 52.3833f, -1.5833f, 2, 60.0f, "CV4 7AL", 3000, 0.5f },
+        { 21.0f, 50.3f, -4.1f, 4, 120.0f, "PL4 8AA", 9000, 1.5f },
+        { 19.0f, 57.1f, -2.1f, 3, 90.0f, "AB10 1AA", 7000, 1.0f },
+        { 20.0f, 51.5f, -0.1f, 1, 45.0f, "SW1A 1AA", 2000, 0.3f },
+        { 20.0f, 54.6f, -5.9f, 5, 200.0f, "BT1 1AA", 15000, 3.0f },
+    };
+
+    std::vector<OptimiserMode> modes = {
+        { "brute force", { false, false, false, 0, true, false } },
+        { "surfaces", { false, false, false, 0, true, true } },
+    };
+    for (const size_t representative_days : { 12, 24, 48 }) {
+        for (const size_t finalists : { 5, 10 }) {
+            heatninja::SimulationOptions simulation_options = { false, false, false, 0, true, false };
+            simulation_options.representative_days = representative_days;
+            simulation_options.representative_day_finalists = finalists;
+            modes.push_back({ "representative days " + std::to_string(representative_days) + ", top " + std::to_string(finalists), simulation_options });
+        }
+    }
+    for (const float surrogate_improvement_threshold : { 1.0f, 5.0f, 20.0f }) {
+        heatninja::SimulationOptions simulation_options = { false, false, false, 0, true, false };
+        simulation_options.use_surrogate_search = true;
+        simulation_options.surrogate_improvement_threshold = surrogate_improvement_threshold;
+        modes.push_back({ "surrogate, expected improvement < " + heatninja::float_to_string(surrogate_improvement_threshold, 0), simulation_options });
+    }
+
+    std::vector<std::vector<float>> reference_net_present_costs;
+    std::cout << "mode, runtime s, max npc error %, mean npc error %\n";
+    for (const OptimiserMode& mode : modes) {
+        double runtime = 0, max_error = 0, error_sum = 0;
+        size_t errors = 0;
+        for (size_t h = 0; h < households.size(); ++h) {
+            const Household& household = households.at(h);
+            std::stringstream discarded;
+            std::streambuf* cout_buffer = std::cout.rdbuf(discarded.rdbuf());
+            const auto start_time = std::chrono::steady_clock::now();
+            const std::string json = heatninja::run_simulation(household.thermostat_temperature, household.latitude, household.longitude, household.num_occupants, household.house_size, household.postcode, household.epc_space_heating, household.tes_volume_max, mode.simulation_options);
+            runtime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+            std::cout.rdbuf(cout_buffer);
+
+            const std::vector<float> net_present_costs = extractNetPresentCosts(json);
+            if (reference_net_present_costs.size() < households.size()) { // first mode is the reference
+                reference_net_present_costs.push_back(net_present_costs);
+            }
+            for (size_t i = 0; i < net_present_costs.size(); ++i) {
+                const double error = 100.0 * (net_present_costs.at(i) - reference_net_present_costs.at(h).at(i)) / reference_net_present_costs.at(h).at(i);
+                max_error = std::max(max_error, std::abs(error));
+                error_sum += std::abs(error);
+                ++errors;
+            }
+        }
+        std::cout << mode.name << ", " << runtime << ", " << max_error << ", " << error_sum / static_cast<double>(errors) << '\n';
+    }
+}
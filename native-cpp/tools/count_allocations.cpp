@@ -0,0 +1,41 @@
+#include "../heatninja.h"
+
+#include <iostream>
+#include <string>
+
+#ifdef HEATNINJA_COUNT_ALLOCATIONS
+size_t countHeapAllocations(const std::string& name, const heatninja::SimulationOptions& simulation_options) {
+    // first run sizes the per combination scratch buffers, second run must reuse them
+    heatninja::run_simulation(20.0f, 52.3833f, -1.5833f, 2, 60.0f, "CV4 7AL", 3000, 0.5f, simulation_options);
+    heatninja::run_simulation(20.0f, 52.3833f, -1.5833f, 2, 60.0f, "CV4 7AL", 3000, 0.5f, simulation_options);
+
+    size_t total_heap_allocations = 0;
+    for (size_t i = 0; i < heatninja::combination_heap_allocations.size(); ++i) {
+        std::cout << name << " combination " << i << ": " << heatninja::combination_heap_allocations.at(i) << " heap allocations\n";
+        total_heap_allocations += heatninja::combination_heap_allocations.at(i);
+    }
+    return total_heap_allocations;
+}
+#endif
+
+// build with HEATNINJA_COUNT_ALLOCATIONS (and allocation_counter.cpp) to check that
+// simulate_heat_solar_combination stops allocating once its scratch buffers are warmed up
+int main()
+{
+#ifdef HEATNINJA_COUNT_ALLOCATIONS
+    const heatninja::SimulationOptions simulation_options = { false, false, false, 0, false, true, false };
+    size_t total_heap_allocations = countHeapAllocations("single year", simulation_options);
+
+    // every evaluation also runs the weather ensemble's other years
+    heatninja::WeatherStore ensemble_store = heatninja::load_weather_store("assets");
+    heatninja::add_synthetic_weather_years(ensemble_store, 2, 1);
+    heatninja::SimulationOptions ensemble_options = simulation_options;
+    ensemble_options.weather_store = &ensemble_store;
+    total_heap_allocations += countHeapAllocations("weather ensemble", ensemble_options);
+
+    return total_heap_allocations == 0 ? 0 : 1;
+#else
+    std::cout << "count_allocations needs HEATNINJA_COUNT_ALLOCATIONS\n";
+    return 1;
+#endif
+}
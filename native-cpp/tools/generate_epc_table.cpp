@@ -0,0 +1,84 @@
+#include "../heatninja.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+// generates epc_transmittance_table.h, the fitted transmittance step over (region, house_size, epc_space_heating)
+// run whenever the EPC fit or its inputs change
+// usage: generate_epc_table <output header>
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::cout << "usage: generate_epc_table <output header>\n";
+        return 1;
+    }
+
+    // the fit depends on latitude through the solar gains, the lookup corrects for it with a few extra steps
+    constexpr float latitude = 53.0f;
+    constexpr size_t regions = 21;
+    constexpr float house_size_min = 20, house_size_step = 20;
+    constexpr size_t house_sizes = 15; // to 300 m2
+    constexpr int epc_space_heating_min = 0, epc_space_heating_step = 1000;
+    constexpr size_t epc_space_heating_values = 31; // to 30000 kWh
+
+    const std::vector<float>& steps = heatninja::epc_thermal_transmittance_steps();
+    std::vector<int> table;
+    table.reserve(regions * house_sizes * epc_space_heating_values);
+
+    std::stringstream discarded;
+    std::streambuf* cout_buffer = std::cout.rdbuf(discarded.rdbuf());
+    const std::array<float, 12> monthly_solar_height_factors = heatninja::calculate_monthly_solar_height_factors(latitude, heatninja::monthly_solar_declinations);
+    const std::array<float, 12> monthly_solar_gain_ratios_north = heatninja::calculate_monthly_solar_gain_ratios_north(monthly_solar_height_factors);
+    const std::array<float, 12> monthly_solar_gain_ratios_south = heatninja::calculate_monthly_solar_gain_ratios_south(monthly_solar_height_factors);
+    for (size_t region = 0; region < regions; ++region) {
+        const std::array<float, 12> monthly_epc_outside_temperatures = heatninja::calculate_monthly_epc_outside_temperatures(static_cast<int>(region));
+        const std::array<int, 12> monthly_epc_solar_irradiances = heatninja::calculate_monthly_epc_solar_irradiances(static_cast<int>(region));
+        const std::array<float, 12> monthly_incident_irradiance_solar_gains_north = heatninja::calculate_monthly_incident_irradiance_solar_gains_north(monthly_solar_gain_ratios_north, monthly_epc_solar_irradiances);
+        const std::array<float, 12> monthly_incident_irradiance_solar_gains_south = heatninja::calculate_monthly_incident_irradiance_solar_gains_south(monthly_solar_gain_ratios_south, monthly_epc_solar_irradiances);
+        for (size_t h = 0; h < house_sizes; ++h) {
+            const float house_size = house_size_min + h * house_size_step;
+            const float solar_gain_house_factor = heatninja::calculate_solar_gain_house_factor(house_size);
+            const float epc_body_gain = heatninja::calculate_epc_body_gain(house_size);
+            const std::array<float, 12> monthly_solar_gains_south = heatninja::calculate_monthly_solar_gains_south(monthly_incident_irradiance_solar_gains_south, solar_gain_house_factor);
+            const std::array<float, 12> monthly_solar_gains_north = heatninja::calculate_monthly_solar_gains_north(monthly_incident_irradiance_solar_gains_north, solar_gain_house_factor);
+            const float heat_capacity = heatninja::calculate_heat_capacity(house_size);
+            for (size_t e = 0; e < epc_space_heating_values; ++e) {
+                const int epc_space_heating = epc_space_heating_min + static_cast<int>(e) * epc_space_heating_step;
+                const auto [thermal_transmittance, optimised_epc_demand] = heatninja::calculate_dwellings_thermal_transmittance(house_size, epc_body_gain, monthly_epc_outside_temperatures, monthly_epc_solar_irradiances, monthly_solar_height_factors, heatninja::monthly_solar_declinations, monthly_solar_gains_south, monthly_solar_gains_north, heat_capacity, epc_space_heating);
+                // stored as step + 1, 0 is the scan's starting point where no step got closer than 0 demand
+                const int step = optimised_epc_demand == 0 ? -1 : static_cast<int>(std::find(steps.begin(), steps.end(), thermal_transmittance) - steps.begin());
+                table.push_back(step + 1);
+            }
+        }
+    }
+    std::cout.rdbuf(cout_buffer);
+
+    std::ofstream header(argv[1]);
+    header << "#pragma once\n";
+    header << "// GENERATED by tools/generate_epc_table.cpp, do not edit\n";
+    header << "#include <array>\n";
+    header << "#include <cstddef>\n";
+    header << "#include <cstdint>\n\n";
+    header << "namespace heatninja {\n";
+    header << "    constexpr size_t epc_table_regions = " << regions << ";\n";
+    header << "    constexpr float epc_table_house_size_min = " << house_size_min << ", epc_table_house_size_step = " << house_size_step << ";\n";
+    header << "    constexpr size_t epc_table_house_sizes = " << house_sizes << ";\n";
+    header << "    constexpr int epc_table_epc_space_heating_min = " << epc_space_heating_min << ";\n";
+    header << "    constexpr float epc_table_epc_space_heating_step = " << epc_space_heating_step << ";\n";
+    header << "    constexpr size_t epc_table_epc_space_heating_values = " << epc_space_heating_values << ";\n\n";
+    header << "    // epc_thermal_transmittance_steps index + 1 fitted at latitude " << latitude << ", [region][house size][epc space heating]\n";
+    header << "    constexpr std::array<uint8_t, " << table.size() << "> epc_thermal_transmittance_table = { {\n";
+    for (size_t row = 0; row < regions * house_sizes; ++row) {
+        header << "        ";
+        for (size_t e = 0; e < epc_space_heating_values; ++e) {
+            header << table.at(row * epc_space_heating_values + e) << (row + 1 < regions * house_sizes || e + 1 < epc_space_heating_values ? "," : "") << (e + 1 < epc_space_heating_values ? " " : "\n");
+        }
+    }
+    header << "    } };\n";
+    header << "}\n";
+    header.close();
+    std::cout << table.size() << " fitted steps written to " << argv[1] << '\n';
+}
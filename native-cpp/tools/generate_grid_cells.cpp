@@ -0,0 +1,86 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+
+// generates grid_cells.h from the weather assets, run whenever the assets change
+// usage: generate_grid_cells <assets directory> <output header>
+
+struct GridCellAsset {
+    int latitude_step, longitude_step; // half degree steps, lat_50.5_lon_-1.0 is { 101, -2 }
+    float coldest_outside_temperature;
+};
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        std::cout << "usage: generate_grid_cells <assets directory> <output header>\n";
+        return 1;
+    }
+    const std::filesystem::path outside_temps_directory = std::filesystem::path(argv[1]) / "outside_temps";
+
+    std::vector<GridCellAsset> cells;
+    for (const auto& entry : std::filesystem::directory_iterator(outside_temps_directory)) {
+        // lat_<latitude>_lon_<longitude>.csv
+        const std::string stem = entry.path().stem().string();
+        const size_t lon_position = stem.find("_lon_");
+        if (stem.rfind("lat_", 0) != 0 || lon_position == std::string::npos) continue;
+        const float latitude = std::stof(stem.substr(4, lon_position - 4));
+        const float longitude = std::stof(stem.substr(lon_position + 5));
+
+        std::ifstream infile(entry.path());
+        std::string line;
+        float coldest = 0;
+        size_t hours = 0;
+        while (std::getline(infile, line)) {
+            std::stringstream ss(line);
+            std::string token;
+            ss >> token;
+            if (token.empty()) continue;
+            const float value = std::stof(token);
+            if (hours == 0 || value < coldest) {
+                coldest = value;
+            }
+            ++hours;
+        }
+        if (hours != 8760) {
+            std::cerr << entry.path() << " has " << hours << " hours, expected 8760\n";
+            return 1;
+        }
+        cells.push_back({ static_cast<int>(std::lround(latitude * 2)), static_cast<int>(std::lround(longitude * 2)), coldest });
+    }
+
+    std::sort(cells.begin(), cells.end(), [](const GridCellAsset& a, const GridCellAsset& b) {
+        return a.latitude_step != b.latitude_step ? a.latitude_step < b.latitude_step : a.longitude_step < b.longitude_step;
+    });
+
+    std::ofstream header(argv[2]);
+    header << "#pragma once\n";
+    header << "// GENERATED by tools/generate_grid_cells.cpp from the weather assets, do not edit\n";
+    header << "#include <array>\n\n";
+    header << "namespace heatninja {\n";
+    header << "    struct GridCellAsset {\n";
+    header << "        int latitude_step, longitude_step; // half degree steps\n";
+    header << "        float coldest_outside_temperature;\n";
+    header << "    };\n\n";
+    header << "    constexpr std::array<GridCellAsset, " << cells.size() << "> grid_cell_assets = { {\n";
+    for (size_t i = 0; i < cells.size(); ++i) {
+        const GridCellAsset& cell = cells.at(i);
+        // enough digits to give back the same float, with a point or exponent so the f suffix makes a float literal
+        std::stringstream literal;
+        literal << std::setprecision(std::numeric_limits<float>::max_digits10) << cell.coldest_outside_temperature;
+        std::string coldest_outside_temperature = literal.str();
+        if (coldest_outside_temperature.find_first_of(".e") == std::string::npos) coldest_outside_temperature += ".0";
+        header << "        { " << cell.latitude_step << ", " << cell.longitude_step << ", " << coldest_outside_temperature << "f }" << (i + 1 < cells.size() ? ",\n" : "\n");
+    }
+    header << "    } };\n";
+    header << "}\n";
+    header.close();
+    std::cout << cells.size() << " grid cells written to " << argv[2] << '\n';
+}
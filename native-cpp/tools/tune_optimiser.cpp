@@ -0,0 +1,151 @@
+#include "../heatninja.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <map>
+
+// offline tuner of the surface optimiser, sweeps min_step, gradient_factor & target_step over a corpus of households and
+// writes optimiser_parameters.h with the fewest evaluations per surface band & solar option that is no less accurate
+// against brute force than the defaults. runs every household once per candidate, so takes a while
+// usage: tune_optimiser <output header>, from the build directory
+
+struct Household {
+    float thermostat_temperature, latitude, longitude;
+    int num_occupants;
+    float house_size;
+    std::string postcode;
+    int epc_space_heating;
+    float tes_volume_max;
+};
+
+struct BandResult {
+    size_t evaluations = 0;
+    double max_error = 0; // % of the brute force npc
+};
+
+std::vector<float> extractNetPresentCosts(const std::string& json) {
+    // the first 21 "net-present-cost" entries are the heat & solar systems, in order
+    std::vector<float> net_present_costs;
+    const std::string key = "\"net-present-cost\":";
+    size_t position = json.find(key);
+    while (position != std::string::npos && net_present_costs.size() < 21) {
+        net_present_costs.push_back(std::stof(json.substr(position + key.size())));
+        position = json.find(key, position + key.size());
+    }
+    return net_present_costs;
+}
+
+std::vector<float> runHousehold(const Household& household, const heatninja::SimulationOptions& simulation_options) {
+    std::stringstream discarded;
+    std::streambuf* cout_buffer = std::cout.rdbuf(discarded.rdbuf());
+    const std::string json = heatninja::run_simulation(household.thermostat_temperature, household.latitude, household.longitude, household.num_occupants, household.house_size, household.postcode, household.epc_space_heating, household.tes_volume_max, simulation_options);
+    std::cout.rdbuf(cout_buffer);
+    return extractNetPresentCosts(json);
+}
+
+size_t findBand(const std::vector<size_t>& band_maxima, const size_t size) {
+    size_t band = 0;
+    while (size > band_maxima.at(band)) ++band;
+    return band;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::cout << "usage: tune_optimiser <output header>\n";
+        return 1;
+    }
+
+    // spans the surface bands, tes_volume_max sets x_size (tes options) & house_size sets y_size (solar sizes)
+    const std::vector<Household> households = {
+        { 20.0f, 52.3833f, -1.5833f, 2, 60.0f, "CV4 7AL", 3000, 0.5f },
+        { 21.0f, 50.3f, -4.1f, 4, 120.0f, "PL4 8AA", 9000, 1.5f },
+        { 19.0f, 57.1f, -2.1f, 3, 90.0f, "AB10 1AA", 7000, 1.0f },
+        { 20.0f, 51.5f, -0.1f, 1, 45.0f, "SW1A 1AA", 2000, 0.3f },
+        { 20.0f, 54.6f, -5.9f, 5, 200.0f, "BT1 1AA", 15000, 3.0f },
+        { 20.0f, 53.5f, -2.2f, 2, 60.0f, "M1 1AA", 4000, 2.0f },
+        { 21.0f, 51.5f, -2.6f, 4, 160.0f, "BS1 1AA", 12000, 0.6f },
+        { 19.0f, 55.9f, -3.2f, 3, 100.0f, "EH1 1AA", 8000, 1.2f },
+    };
+
+    const std::vector<size_t> x_band_maxima = { 8, 16, static_cast<size_t>(-1) };
+    const std::vector<size_t> y_band_maxima = { 8, 16, static_cast<size_t>(-1) };
+
+    std::vector<heatninja::OptimiserParameters> candidates = { heatninja::default_optimiser_parameters };
+    for (const size_t min_step : { 2, 3, 4 }) {
+        for (const float gradient_factor : { 0.1f, 0.2f, 0.35f }) {
+            for (const int target_step : { 5, 7, 10 }) {
+                if (min_step == heatninja::default_optimiser_parameters.min_step && gradient_factor == heatninja::default_optimiser_parameters.gradient_factor && target_step == heatninja::default_optimiser_parameters.target_step) continue;
+                candidates.push_back({ min_step, gradient_factor, target_step });
+            }
+        }
+    }
+
+    // results[{ solar option, x band, y band }][candidate]
+    std::map<std::array<size_t, 3>, std::vector<BandResult>> results;
+    for (const Household& household : households) {
+        const std::vector<float> reference = runHousehold(household, { false, false, false, 0, true, false });
+        const int tes_range = heatninja::calculate_tes_range(household.tes_volume_max);
+        const int solar_maximum = heatninja::calculate_solar_maximum(household.house_size);
+        for (size_t c = 0; c < candidates.size(); ++c) {
+            heatninja::SimulationOptions simulation_options = { false, false, false, 0, true, true };
+            simulation_options.optimiser_parameters = &candidates.at(c);
+            const std::vector<float> net_present_costs = runHousehold(household, simulation_options);
+            for (size_t i = 0; i < 21; ++i) {
+                const size_t solar_option = i % 7;
+                const size_t x_size = static_cast<size_t>(tes_range);
+                const size_t y_size = static_cast<size_t>(heatninja::calculate_solar_size_range(static_cast<heatninja::SolarOption>(solar_option), solar_maximum));
+                if (x_size <= 3 || y_size <= 3) continue; // brute force, the parameters aren't used
+                std::vector<BandResult>& band_results = results[{ solar_option, findBand(x_band_maxima, x_size), findBand(y_band_maxima, y_size) }];
+                band_results.resize(candidates.size());
+                band_results.at(c).evaluations += heatninja::combination_evaluations.at(i);
+                band_results.at(c).max_error = std::max(band_results.at(c).max_error, 100.0 * std::abs(net_present_costs.at(i) - reference.at(i)) / reference.at(i));
+            }
+        }
+        std::cout << household.postcode << " tuned\n";
+    }
+
+    std::ofstream header(argv[1]);
+    header << "#pragma once\n";
+    header << "// GENERATED by tools/tune_optimiser.cpp, do not edit\n";
+    header << "#include <array>\n";
+    header << "#include <cstddef>\n\n";
+    header << "namespace heatninja {\n";
+    header << "    struct TunedOptimiserParameters {\n";
+    header << "        int solar_option;\n";
+    header << "        size_t x_size_max, y_size_max; // inclusive bounds of the surface size band\n";
+    header << "        size_t min_step;\n";
+    header << "        float gradient_factor;\n";
+    header << "        int target_step;\n";
+    header << "    };\n\n";
+    // every band of every solar option is written, bands the corpus doesn't reach keep the defaults, so lookups find their own band first
+    const size_t bands = 6 * x_band_maxima.size() * y_band_maxima.size();
+    header << "    constexpr std::array<TunedOptimiserParameters, " << bands << "> tuned_optimiser_parameters = { {\n";
+    std::cout << "solar option, x band, y band, min_step, gradient_factor, target_step, evaluations, default evaluations, max npc error %, default max npc error %\n";
+    size_t written = 0;
+    for (size_t solar_option = 1; solar_option < 7; ++solar_option) {
+        for (size_t x_band = 0; x_band < x_band_maxima.size(); ++x_band) {
+            for (size_t y_band = 0; y_band < y_band_maxima.size(); ++y_band) {
+                size_t best = 0;
+                const auto band_results = results.find({ solar_option, x_band, y_band });
+                if (band_results != results.end()) {
+                    // the defaults are always admissible, a candidate must be no less accurate & strictly cheaper to replace them
+                    const std::vector<BandResult>& r = band_results->second;
+                    for (size_t c = 1; c < candidates.size(); ++c) {
+                        if (r.at(c).max_error <= r.at(0).max_error + 1e-6 && r.at(c).evaluations < r.at(best).evaluations) best = c;
+                    }
+                    std::cout << solar_option << ", " << x_band << ", " << y_band << ", " << candidates.at(best).min_step << ", " << candidates.at(best).gradient_factor << ", " << candidates.at(best).target_step << ", " << r.at(best).evaluations << ", " << r.at(0).evaluations << ", " << r.at(best).max_error << ", " << r.at(0).max_error << '\n';
+                }
+                const heatninja::OptimiserParameters& p = candidates.at(best);
+                const size_t x_size_max = x_band_maxima.at(x_band), y_size_max = y_band_maxima.at(y_band);
+                header << "        { " << solar_option << ", " << (x_size_max == static_cast<size_t>(-1) ? "static_cast<size_t>(-1)" : std::to_string(x_size_max)) << ", " << (y_size_max == static_cast<size_t>(-1) ? "static_cast<size_t>(-1)" : std::to_string(y_size_max)) << ", " << p.min_step << ", " << p.gradient_factor << "f, " << p.target_step << " }" << (++written < bands ? ",\n" : "\n");
+            }
+        }
+    }
+    header << "    } };\n";
+    header << "}\n";
+    header.close();
+    std::cout << results.size() << " of " << bands << " bands tuned, written to " << argv[1] << '\n';
+}